@@ -0,0 +1,35 @@
+/**
+ * Compile src/data/registers.ts into the startup register table, the
+ * on-demand field description chunk and the preset catalog chunks
+ * (see src/data/compileRegisters.ts).
+ */
+
+import { build } from 'esbuild'
+import { writeFileSync } from 'node:fs'
+
+const result = await build({
+  stdin: {
+    contents: [
+      `export { CC1101_REGISTERS, PRESETS } from './src/data/registers'`,
+      `export { PRESET_CHUNK_FILES, compilePresetChunks, compileRegisterModules } from './src/data/compileRegisters'`,
+    ].join('\n'),
+    resolveDir: process.cwd(),
+    loader: 'ts',
+  },
+  bundle: true,
+  format: 'esm',
+  write: false,
+})
+const source = Buffer.from(result.outputFiles[0].contents).toString('base64')
+const { CC1101_REGISTERS, PRESETS, PRESET_CHUNK_FILES, compilePresetChunks, compileRegisterModules } =
+  await import(`data:text/javascript;base64,${source}`)
+
+const { table, text } = compileRegisterModules(CC1101_REGISTERS)
+const modules = { 'registerTable.ts': table, 'registerText.ts': text }
+for (const [chunk, chunkSource] of Object.entries(compilePresetChunks(PRESETS, CC1101_REGISTERS))) {
+  modules[PRESET_CHUNK_FILES[chunk]] = chunkSource
+}
+for (const [file, contents] of Object.entries(modules)) {
+  writeFileSync(`src/data/${file}`, contents)
+  console.log(`${file.padEnd(20)} ${(contents.length / 1024).toFixed(1)} KB`)
+}
@@ -0,0 +1,29 @@
+/**
+ * Report the minified size of single-import bundles from the core library.
+ * Run after `npm run build:lib`.
+ */
+
+import { build } from 'esbuild'
+
+const SAMPLES = [
+  'frequencyToRegisters',
+  'generateFlipperSettingUser',
+  'parseFlipperPresetData',
+  'decodeImageBank',
+  'parseFieldConfig',
+]
+
+for (const name of SAMPLES) {
+  const result = await build({
+    stdin: {
+      contents: `export { ${name} } from './dist-lib/lib/index.js'`,
+      resolveDir: process.cwd(),
+    },
+    bundle: true,
+    minify: true,
+    format: 'esm',
+    write: false,
+  })
+  const bytes = result.outputFiles[0].contents.length
+  console.log(`${name.padEnd(28)} ${(bytes / 1024).toFixed(1)} KB`)
+}
@@ -0,0 +1,106 @@
+// Load test for `cc1101 serve`: replays a fixed request mix over keep-alive
+// connections and reports client-observed latency percentiles per endpoint,
+// plus the server's own handling time from Server-Timing. After one warm-up
+// request every response should be a cache hit; exits 1 if cached p99 is
+// over the budget.
+//
+//   node scripts/load-test.mjs [url] [--requests 20000] [--concurrency 8] [--budget-ms 1]
+
+import { Agent, request } from 'node:http';
+import { parseArgs } from 'node:util';
+
+const { values, positionals } = parseArgs({
+  allowPositionals: true,
+  options: {
+    requests: { type: 'string', default: '20000' },
+    concurrency: { type: 'string', default: '8' },
+    'budget-ms': { type: 'string', default: '1' }
+  }
+});
+
+const base = new URL(positionals[0] ?? 'http://127.0.0.1:8787');
+const total = Number(values.requests);
+const concurrency = Number(values.concurrency);
+const budgetMs = Number(values['budget-ms']);
+const agent = new Agent({ keepAlive: true, maxSockets: concurrency });
+
+const PRESET = `Custom_preset_name: GFSK 9.99
+Custom_preset_module: CC1101
+Custom_preset_data: 02 0D 03 07 08 32 0B 06 10 C8 11 93 12 12 13 22 15 15 18 18 19 16 1B 07 1C 00 1D 91 20 FB 21 56 22 10 00 00 C0 00 00 00 00 00 00 00
+`;
+
+const MIX = [
+  { name: 'convert', method: 'POST', path: '/convert?from=flipper&to=c-array', body: PRESET },
+  { name: 'validate', method: 'POST', path: '/validate', body: PRESET },
+  { name: 'explain', method: 'POST', path: '/explain', body: PRESET },
+  { name: 'solve', method: 'GET', path: '/solve?frequency=868.3&modulation=GFSK&dataRate=38.4&bandwidth=100&deviation=20' },
+  { name: 'solve+export', method: 'GET', path: '/solve?frequency=433.92&modulation=ASK/OOK&to=flipper' }
+];
+
+function send(entry) {
+  return new Promise((resolve, reject) => {
+    const started = process.hrtime.bigint();
+    const req = request(new URL(entry.path, base), { method: entry.method, agent }, res => {
+      res.resume();
+      res.on('end', () => resolve({
+        ms: Number(process.hrtime.bigint() - started) / 1e6,
+        app: Number(/dur=([\d.]+)/.exec(res.headers['server-timing'] ?? '')?.[1] ?? 0),
+        status: res.statusCode,
+        hit: res.headers['x-cache'] === 'hit'
+      }));
+    });
+    req.on('error', reject);
+    req.end(entry.body);
+  });
+}
+
+function percentile(sorted, p) {
+  return sorted[Math.min(sorted.length - 1, Math.floor(sorted.length * p))];
+}
+
+// Warm up: populate the cache and the JIT
+for (const entry of MIX) {
+  const { status } = await send(entry);
+  if (status !== 200) throw new Error(`${entry.name}: HTTP ${status}`);
+}
+for (let i = 0; i < 1000; i++) await send(MIX[i % MIX.length]);
+
+const samples = new Map(MIX.map(entry => [entry.name, []]));
+const appTimes = [];
+let misses = 0;
+let next = 0;
+const started = performance.now();
+
+await Promise.all(Array.from({ length: concurrency }, async () => {
+  while (next < total) {
+    const entry = MIX[next++ % MIX.length];
+    const result = await send(entry);
+    if (!result.hit) misses++;
+    samples.get(entry.name).push(result.ms);
+    appTimes.push(result.app);
+  }
+}));
+
+const seconds = (performance.now() - started) / 1000;
+console.log(`${total} requests, ${concurrency} connections, ${Math.round(total / seconds)} req/s, ${misses} cache misses`);
+
+let overBudget = false;
+for (const [name, times] of samples) {
+  times.sort((a, b) => a - b);
+  const p99 = percentile(times, 0.99);
+  if (p99 > budgetMs) overBudget = true;
+  console.log(
+    `${name.padEnd(14)} p50 ${percentile(times, 0.5).toFixed(3)} ms  ` +
+    `p90 ${percentile(times, 0.9).toFixed(3)} ms  p99 ${p99.toFixed(3)} ms  max ${times[times.length - 1].toFixed(3)} ms`
+  );
+}
+
+// In-process handling time from Server-Timing, without HTTP and client overhead
+appTimes.sort((a, b) => a - b);
+console.log(`server         p50 ${percentile(appTimes, 0.5).toFixed(3)} ms  p99 ${percentile(appTimes, 0.99).toFixed(3)} ms`);
+
+agent.destroy();
+if (overBudget) {
+  console.log(`p99 over ${budgetMs} ms budget`);
+  process.exitCode = 1;
+}
@@ -2,13 +2,15 @@
  * CC1101 Register Editor - Main App Component
  */
 
-import { useCallback } from 'react';
+import { useState, useCallback } from 'react';
 import { useRegisters } from './hooks/useRegisters';
 import { useToast } from './hooks/useToast';
 import { Sidebar } from './components/Sidebar';
 import { EditorPanel } from './components/Editor';
 import { ExportPanel } from './components/Export';
 import { Header } from './components/Header';
+import { PatchPanel } from './components/Patch';
+import { AnalyticsPanel } from './components/Analytics';
 import { Toast } from './components/common';
 import { toHex } from './utils/calculations';
 import './styles/index.css';
@@ -26,6 +28,8 @@ function App() {
   } = useRegisters();
 
   const { toast, showToast } = useToast();
+  const [isPatchOpen, setIsPatchOpen] = useState(false);
+  const [isAnalyticsOpen, setIsAnalyticsOpen] = useState(false);
 
   const handleBitToggleWithToast = useCallback((addr: number, bit: number, fieldName: string) => {
     actions.toggleBit(addr, bit);
@@ -47,12 +51,17 @@ function App() {
 
   return (
     <div className="app-container">
-      <Header onReset={handleReset} />
+      <Header
+        onReset={handleReset}
+        onPatch={() => setIsPatchOpen(true)}
+        onAnalytics={() => setIsAnalyticsOpen(true)}
+      />
 
       <main className="main-content">
         <Sidebar
           currentGroup={currentGroup}
           onGroupChange={setCurrentGroup}
+          registers={registers}
           derived={derived}
           actions={actions}
         />
@@ -83,6 +92,20 @@ function App() {
         />
       </main>
 
+      {isPatchOpen && (
+        <PatchPanel
+          registers={registers}
+          paTable={paTable}
+          onApply={handleImport}
+          onClose={() => setIsPatchOpen(false)}
+          showToast={showToast}
+        />
+      )}
+
+      {isAnalyticsOpen && (
+        <AnalyticsPanel onClose={() => setIsAnalyticsOpen(false)} showToast={showToast} />
+      )}
+
       <Toast {...toast} />
     </div>
   );
@@ -0,0 +1,33 @@
+/**
+ * cc1101 Command Line Interface
+ *
+ *   cc1101 convert --from flipper --to c-array < presets.txt
+ *
+ * Commands and options are listed once, in USAGE in main.ts
+ * (`cc1101 --help`).
+ *
+ * Input is read line by line from stdin and output written with
+ * backpressure, so arbitrarily large dumps run in bounded memory.
+ */
+
+import { isMainThread, workerData } from 'node:worker_threads';
+import { COMPARE_WORKER, runCompareWorker } from './compare';
+import { runLintWorker } from './lint';
+import { main } from './main';
+
+if (isMainThread) {
+  // Closing the pipe early (e.g. `| head`) is not an error
+  process.stdout.on('error', (err: NodeJS.ErrnoException) => {
+    if (err.code === 'EPIPE') process.exit(0);
+    throw err;
+  });
+
+  // Pool workers start from this same file, so the bundle stays one module
+  main(process.argv.slice(2), process, { workerEntry: new URL(import.meta.url) }).then(code => {
+    process.exitCode = code;
+  });
+} else if (workerData === COMPARE_WORKER) {
+  runCompareWorker();
+} else {
+  runLintWorker();
+}
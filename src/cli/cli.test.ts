@@ -0,0 +1,164 @@
+// @vitest-environment node
+import { describe, it, expect } from 'vitest';
+import { mkdtempSync, writeFileSync } from 'node:fs';
+import { tmpdir } from 'node:os';
+import { join } from 'node:path';
+import { PassThrough, Readable } from 'node:stream';
+import { PRESETS } from '../data/registers';
+import { generateFlipperSettingUser } from '../utils/export';
+import { createRecordReader, explainRecord, formatRecord } from './records';
+import type { PresetRecord } from './records';
+import { main } from './main';
+
+const fsk = PRESETS['FM 2-FSK (433.92MHz)'];
+const ook = PRESETS['AM 650kHz (433.92MHz)'];
+const SETTING_USER = [
+  'Filetype: Flipper SubGhz Setting File',
+  'Version: 1',
+  '',
+  generateFlipperSettingUser('FSK', fsk.registers, fsk.paTable),
+  '',
+  generateFlipperSettingUser('OOK', ook.registers, ook.paTable),
+  '',
+].join('\n');
+
+function readAll(format: Parameters<typeof createRecordReader>[0], text: string): PresetRecord[] {
+  const records: PresetRecord[] = [];
+  const reader = createRecordReader(format, r => records.push(r));
+  text.split('\n').forEach(reader.line);
+  reader.end();
+  return records;
+}
+
+async function run(args: string[], input: string) {
+  const stdout = new PassThrough();
+  const stderr = new PassThrough();
+  const chunks: string[] = [];
+  stdout.on('data', chunk => chunks.push(String(chunk)));
+  const code = await main(args, { stdin: Readable.from([input]), stdout, stderr });
+  return { code, output: chunks.join('') };
+}
+
+describe('CLI Records', () => {
+  it('reads named presets from setting_user files', () => {
+    const records = readAll('flipper', SETTING_USER);
+
+    expect(records.map(r => r.name)).toEqual(['FSK', 'OOK']);
+    expect(records[0].registers[0x12]).toBe(fsk.registers[0x12]);
+    expect(records[1].paTable).toEqual(ook.paTable);
+  });
+
+  it('keeps reset values for registers Flipper does not list', () => {
+    const [record] = readAll('flipper', SETTING_USER);
+
+    expect(record.registers[0x0D]).toBe(0x10); // FREQ2 reset value
+    expect(Object.keys(record.registers)).toHaveLength(0x2F);
+  });
+
+  it('round-trips raw hex and field config records', () => {
+    const [fskRecord] = readAll('flipper', SETTING_USER);
+
+    const raw = readAll('raw-hex', formatRecord(fskRecord, 'raw-hex'));
+    expect(raw[0].registers).toEqual(fskRecord.registers);
+
+    const config = readAll('field-config', formatRecord(fskRecord, 'field-config'));
+    expect(config[0]).toEqual(fskRecord);
+  });
+
+  it('explains derived parameters', () => {
+    const [record] = readAll('flipper', SETTING_USER);
+
+    expect(explainRecord(record)).toContain('Modulation: 2-FSK');
+  });
+});
+
+describe('CLI Commands', () => {
+  it('converts stdin to stdout', async () => {
+    const { code, output } = await run(['convert', '--from', 'flipper', '--to', 'c-array'], SETTING_USER);
+
+    expect(code).toBe(0);
+    expect(output).toContain('static const uint8_t FSK_registers[]');
+    expect(output).toContain('static const uint8_t OOK_registers[]');
+  });
+
+  it('emits NDJSON from validate and fails on errors', async () => {
+    const bad = generateFlipperSettingUser('Bad', { ...fsk.registers, 0x12: 0x23 }, fsk.paTable);
+    const { code, output } = await run(['validate', '--json'], bad);
+
+    expect(code).toBe(1);
+    expect(JSON.parse(output.trim()).issues[0].code).toBe('mod-format');
+  });
+
+  it('diffs consecutive presets', async () => {
+    const { output } = await run(['diff'], SETTING_USER);
+
+    expect(output).toContain('--- FSK\n+++ OOK');
+    expect(output).toContain('MDMCFG2.MOD_FORMAT: 0 -> 3');
+  });
+
+  it('queries presets by modulation', async () => {
+    const { code, output } = await run(['query', '--modulation', 'ASK/OOK'], SETTING_USER);
+
+    expect(code).toBe(0);
+    expect(output).toMatch(/^OOK\t/);
+    expect(output).not.toContain('FSK');
+  });
+
+  it('queries presets with a compiled predicate', async () => {
+    const { code, output } = await run(['query', '--where', 'MOD_FORMAT != ASK/OOK'], SETTING_USER);
+
+    expect(code).toBe(0);
+    expect(output).toMatch(/^FSK\t/);
+    expect(output).not.toContain('OOK');
+    expect((await run(['query', '--where', 'NOPE > 1'], SETTING_USER)).code).toBe(2);
+  });
+
+  it('groups presets that differ only in don\'t-care bits', async () => {
+    const library = '[A]\nFREQ = 868MHz\n[B]\nFREQ = 868MHz\nIOCFG2 = 0x2E\n[C]\nMDMCFG2.MOD_FORMAT = ASK/OOK\n';
+    const clusters = await run(['dedup', '--from', 'field-config'], library);
+    expect(clusters.code).toBe(0);
+    expect(clusters.output).toMatch(/^[0-9a-f]{16}\tA\tB\n$/);
+
+    expect((await run(['dedup', '--from', 'field-config', '--scope', 'device'], library)).output).toBe('');
+    const kept = await run(['dedup', '--from', 'field-config', '--to', 'json'], library);
+    expect(kept.output.trim().split('\n').map(line => JSON.parse(line).name)).toEqual(['A', 'C']);
+  });
+
+  it('patches a library and reports the changes on stderr', async () => {
+    const fixes = join(mkdtempSync(join(tmpdir(), 'cc1101-patch-')), 'fixes.patch');
+    writeFileSync(fixes, 'when modulation == ASK/OOK\n  FIFOTHR.FIFO_THR = 10\n');
+    const stdout = new PassThrough();
+    const stderr = new PassThrough();
+    const output: string[] = [];
+    const report: string[] = [];
+    stdout.on('data', chunk => output.push(String(chunk)));
+    stderr.on('data', chunk => report.push(String(chunk)));
+    const code = await main(['patch', fixes], { stdin: Readable.from([SETTING_USER]), stdout, stderr });
+
+    expect(code).toBe(0);
+    const records = readAll('flipper', output.join(''));
+    expect(records.map(record => record.name)).toEqual(['FSK', 'OOK']);
+    expect(records[0].registers[0x03]).toBe(fsk.registers[0x03]);
+    expect(records[1].registers[0x03] & 0x0F).toBe(10);
+    expect(report.join('')).toContain('Patched 1 of 2 presets (1 matched)\n\n[OOK]\n  FIFOTHR.FIFO_THR:');
+  });
+
+  it('builds a fleet from a template and a CSV on stdin', async () => {
+    const template = join(mkdtempSync(join(tmpdir(), 'cc1101-fleet-')), 'unit.txt');
+    writeFileSync(template, '[node_{id}]\nFREQ = 868MHz + {offset} kHz\nCHANNR = {channel}\n');
+    const csv = 'id,offset,channel\n1,25,4\n2,-25,300\n3,0,5\n';
+    const { code, output } = await run(['fleet', template, '--to', 'json'], csv);
+
+    expect(code).toBe(1); // Row 2 has channel 300
+    const units = output.trim().split('\n').map(line => JSON.parse(line));
+    expect(units.map(unit => unit.name)).toEqual(['node_1', 'node_3']);
+    expect(units[0].registers.slice(0x0A * 2, 0x0A * 2 + 2)).toBe('04');
+    expect(units[0].registers.slice(0x0D * 2, 0x10 * 2)).toBe('2162B5');
+    expect((await run(['fleet', template], 'serial\n1\n')).code).toBe(1);
+  });
+
+  it('rejects unknown commands and formats', async () => {
+    expect((await run(['frobnicate'], '')).code).toBe(2);
+    expect((await run(['convert', '--to', 'nope'], '')).code).toBe(2);
+  });
+});
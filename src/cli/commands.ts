@@ -0,0 +1,588 @@
+/**
+ * CLI Subcommands
+ */
+
+import { once } from 'node:events';
+import { createReadStream } from 'node:fs';
+import { readFile } from 'node:fs/promises';
+import { createInterface } from 'node:readline';
+import type { Readable, Writable } from 'node:stream';
+import { MODULATION_FORMATS } from '../data/registers';
+import { toHex } from '../utils/calculations';
+import { planImageDiff } from '../utils/diff';
+import { findDuplicateClusters } from '../utils/canonical';
+import type { CanonicalScope } from '../utils/canonical';
+import { columnStoreFromImages } from '../utils/columnStore';
+import { compileFieldPath } from '../utils/fieldConfig';
+import type { FieldConfigBank } from '../utils/fieldConfig';
+import { compileFleetTemplate, createCsvRow, csvField, splitCsvLine } from '../utils/fleet';
+import type { FleetTemplate } from '../utils/fleet';
+import { IMAGE_SIZE, PA_TABLE_SIZE, REGISTER_COUNT, packImage, packPresetMap, unpackImage } from '../utils/image';
+import { CHANGE_IMPACTS } from '../utils/libraryDiff';
+import type { ChangeImpact, PairChange } from '../utils/libraryDiff';
+import { mergeLibraries } from '../utils/merge';
+import type { FieldConflict, MergeSide } from '../utils/merge';
+import { applyPatch, compilePatch, generatePatchReport } from '../utils/patch';
+import type { CompiledPatch } from '../utils/patch';
+import type { CompiledPredicate } from '../utils/predicate';
+import { buildPresetIndex, queryPresetIndex } from '../utils/presetIndex';
+import type { PresetQuery } from '../utils/presetIndex';
+import { validateImage } from '../utils/validate';
+import type { IssueSeverity } from '../utils/validate';
+import { compareLibraryVersions } from './compare';
+import { lintPaths, walkPresetFiles } from './lint';
+import type { LintFileResult } from './lint';
+import { explainRecord, formatRecord, readRecords, writeOut } from './records';
+import type { InputFormat, OutputFormat, PresetRecord } from './records';
+import { createPresetServer } from './server';
+import { createLintCache, watchPresetFiles } from './watch';
+
+export interface CommandIO {
+  stdin: Readable;
+  stdout: Writable;
+  stderr: Writable;
+}
+
+export interface CommandRuntime {
+  workerEntry?: URL;    // Entry module for worker_threads pools
+  signal?: AbortSignal; // Ends watch mode; defaults to Ctrl-C
+}
+
+export interface CommandOptions extends CommandRuntime {
+  from: InputFormat;
+  to: OutputFormat;
+  json: boolean;
+  watch: boolean;
+  files: string[];
+  jobs: number;
+  host: string;
+  port: number;
+  where: PresetQuery;
+  predicate: CompiledPredicate | null; // --where
+  prefer: MergeSide; // merge: side that wins conflicting fields
+  scope: CanonicalScope; // dedup: which don't-care bits to ignore
+  explicitTo: boolean; // --to was given rather than defaulted
+}
+
+/**
+ * Signal that aborts on Ctrl-C, so long-running commands can shut down cleanly
+ */
+function interruptSignal(): AbortSignal {
+  const controller = new AbortController();
+  process.once('SIGINT', () => controller.abort());
+  return controller.signal;
+}
+
+/**
+ * convert: re-emit every record in another format
+ */
+export async function convert(options: CommandOptions, io: CommandIO): Promise<number> {
+  for await (const record of readRecords(io.stdin, options.from)) {
+    await writeOut(io.stdout, formatRecord(record, options.to));
+  }
+  return 0;
+}
+
+/**
+ * explain: derived RF parameters and non-default fields per record
+ */
+export async function explain(options: CommandOptions, io: CommandIO): Promise<number> {
+  for await (const record of readRecords(io.stdin, options.from)) {
+    await writeOut(io.stdout, explainRecord(record));
+  }
+  return 0;
+}
+
+/**
+ * validate: report issues, exit 1 if any record has an error
+ */
+export async function validate(options: CommandOptions, io: CommandIO): Promise<number> {
+  let failed = false;
+
+  for await (const record of readRecords(io.stdin, options.from)) {
+    const issues = validateImage(packImage(record.registers, record.paTable))
+      .filter(issue => issue.severity !== 'info');
+    if (issues.some(issue => issue.severity === 'error')) failed = true;
+
+    if (options.json) {
+      await writeOut(io.stdout, JSON.stringify({ name: record.name, issues }) + '\n');
+    } else if (issues.length === 0) {
+      await writeOut(io.stdout, `${record.name}: ok\n`);
+    } else {
+      const lines = issues.map(issue => `${record.name}: ${issue.severity} ${issue.code}: ${issue.message}\n`);
+      await writeOut(io.stdout, lines.join(''));
+    }
+  }
+
+  return failed ? 1 : 0;
+}
+
+function formatDiff(from: PresetRecord, to: PresetRecord): string {
+  const plan = planImageDiff(packImage(from.registers, from.paTable), packImage(to.registers, to.paTable));
+  let output = `--- ${from.name}\n+++ ${to.name}\n`;
+  for (const change of plan.changes) {
+    const path = change.field ? `${change.register}.${change.field}` : `${change.register} (reserved)`;
+    output += `  ${path}: ${change.from} -> ${change.to}\n`;
+  }
+  if (plan.paTableChanged) output += `  PATABLE changed\n`;
+  output += `  ${plan.spiBytes} SPI bytes in ${plan.transactions} transactions (full rewrite ${plan.fullBytes})\n\n`;
+  return output;
+}
+
+/**
+ * diff: with two files, compare records pairwise; otherwise compare each
+ * stdin record with the one before it
+ */
+export async function diff(options: CommandOptions, io: CommandIO): Promise<number> {
+  if (options.files.length === 2) {
+    const left = readRecords(createReadStream(options.files[0]), options.from);
+    const right = readRecords(createReadStream(options.files[1]), options.from);
+    for (;;) {
+      const [a, b] = await Promise.all([left.next(), right.next()]);
+      if (a.done || b.done) {
+        if (!a.done || !b.done) io.stderr.write('diff: inputs have different record counts\n');
+        return a.done && b.done ? 0 : 1;
+      }
+      await writeOut(io.stdout, formatDiff(a.value, b.value));
+    }
+  }
+
+  let previous: PresetRecord | null = null;
+  for await (const record of readRecords(io.stdin, options.from)) {
+    if (previous) await writeOut(io.stdout, formatDiff(previous, record));
+    previous = record;
+  }
+  return 0;
+}
+
+function formatLintResult(result: LintFileResult): string {
+  if (result.error) return `${result.file}: error ${result.error}\n`;
+  let output = '';
+  for (const preset of result.presets) {
+    for (const issue of preset.issues) {
+      output += `${result.file}: ${preset.name}: ${issue.severity} ${issue.code}: ${issue.message}\n`;
+    }
+  }
+  return output;
+}
+
+function formatLintJson(result: LintFileResult): string {
+  if (result.error) return JSON.stringify({ file: result.file, error: result.error }) + '\n';
+  return result.presets.map(preset => JSON.stringify({ file: result.file, ...preset }) + '\n').join('');
+}
+
+// An unreadable file counts as one error
+function countIssues(result: LintFileResult, severity: IssueSeverity): number {
+  let count = severity === 'error' && result.error ? 1 : 0;
+  for (const preset of result.presets) {
+    for (const issue of preset.issues) {
+      if (issue.severity === severity) count++;
+    }
+  }
+  return count;
+}
+
+/**
+ * lint: validate every preset file under the given paths (default .) on a
+ * worker pool; --json streams one NDJSON line per preset or unreadable file.
+ * --watch then keeps re-linting files as they change.
+ */
+export async function lint(options: CommandOptions, io: CommandIO): Promise<number> {
+  const started = performance.now();
+  const cache = options.watch ? createLintCache() : null;
+  let files = 0;
+  let presets = 0;
+  let errors = 0;
+  let warnings = 0;
+
+  const roots = options.files.length > 0 ? options.files : ['.'];
+  await lintPaths(walkPresetFiles(roots), options, async result => {
+    cache?.add(result);
+    if (result.kind === null && !result.error) return;
+    files++;
+    presets += result.presets.length;
+    errors += countIssues(result, 'error');
+    warnings += countIssues(result, 'warning');
+    await writeOut(io.stdout, options.json ? formatLintJson(result) : formatLintResult(result));
+  });
+
+  const elapsed = Math.round(performance.now() - started);
+  io.stderr.write(`${files} files, ${presets} presets: ${errors} errors, ${warnings} warnings (${elapsed} ms, ${options.jobs} jobs)\n`);
+  if (!cache) return errors > 0 ? 1 : 0;
+
+  // Watch: track errors per file so the exit code reflects the final tree
+  const fileErrors = new Map<string, number>();
+  for (const result of cache.files.values()) fileErrors.set(result.file, countIssues(result, 'error'));
+  io.stderr.write(`Watching ${roots.join(', ')} for changes\n`);
+
+  await watchPresetFiles(roots, cache, async (file, result, ms) => {
+    if (result === null) {
+      fileErrors.delete(file);
+      if (options.json) await writeOut(io.stdout, JSON.stringify({ file, removed: true }) + '\n');
+      else io.stderr.write(`${file}: removed\n`);
+      return;
+    }
+    fileErrors.set(file, countIssues(result, 'error'));
+    if (result.kind === null && !result.error) return;
+    await writeOut(io.stdout, options.json ? formatLintJson(result) : formatLintResult(result));
+    if (!options.json) {
+      io.stderr.write(`${file}: ${result.presets.length} presets, ${countIssues(result, 'error')} errors (${ms.toFixed(1)} ms)\n`);
+    }
+  }, options.signal ?? interruptSignal(), error => {
+    io.stderr.write(`lint --watch: ${error.message}\n`);
+  });
+
+  const { stats } = cache;
+  io.stderr.write(`Re-linted ${stats.files} files (${stats.unchanged} unchanged), validated ${stats.validated} images (${stats.cached} cached)\n`);
+  return [...fileErrors.values()].some(n => n > 0) ? 1 : 0;
+}
+
+/**
+ * serve: run the HTTP preset service until interrupted
+ */
+export async function serve(options: CommandOptions, io: CommandIO): Promise<number> {
+  const server = createPresetServer();
+  server.listen(options.port, options.host);
+  await once(server, 'listening');
+  const address = server.address();
+  const port = typeof address === 'object' && address ? address.port : options.port;
+  io.stderr.write(`Listening on http://${options.host}:${port}\n`);
+
+  const signal = options.signal ?? interruptSignal();
+  if (!signal.aborted) await once(signal, 'abort');
+  server.close();
+  server.closeAllConnections();
+  return 0;
+}
+
+/**
+ * Pack every record of the inputs into one image buffer
+ */
+async function readLibrary(inputs: Readable[], from: InputFormat): Promise<FieldConfigBank> {
+  const records: Array<[string, PresetRecord]> = [];
+  for (const input of inputs) {
+    for await (const record of readRecords(input, from)) records.push([record.name, record]);
+  }
+  return packPresetMap(records);
+}
+
+/**
+ * query: index the presets on stdin (or the given files) and print those
+ * matching --frequency, --modulation, --data-rate, --bandwidth and --where;
+ * with --to, matches are re-emitted in that format
+ */
+export async function query(options: CommandOptions, io: CommandIO): Promise<number> {
+  const inputs = options.files.length > 0 ? options.files.map(file => createReadStream(file)) : [io.stdin];
+  const { names, images } = await readLibrary(inputs, options.from);
+
+  const built = performance.now();
+  const index = buildPresetIndex(images, names);
+  const queried = performance.now();
+  let ids: number[] | Uint32Array = queryPresetIndex(index, options.where);
+  if (options.predicate) {
+    const store = columnStoreFromImages(images, names);
+    ids = options.predicate.select(store, ids.length === names.length ? undefined : Uint32Array.from(ids));
+  }
+  const done = performance.now();
+
+  for (const id of ids) {
+    let line: string;
+    if (options.explicitTo) {
+      const { registers, paTable } = unpackImage(images, id * IMAGE_SIZE);
+      line = formatRecord({ name: names[id], registers, paTable }, options.to);
+    } else if (options.json) {
+      line = JSON.stringify({
+        name: names[id],
+        frequency: index.frequency[id],
+        modulation: index.modulation[id],
+        dataRate: index.dataRate[id],
+        bandwidth: index.bandwidth[id]
+      }) + '\n';
+    } else {
+      const modulation = MODULATION_FORMATS[index.modulation[id]]?.name ?? `reserved (${index.modulation[id]})`;
+      line = `${names[id]}\t${index.frequency[id].toFixed(3)} MHz\t${modulation}\t` +
+        `${index.dataRate[id].toFixed(2)} kBaud\t${index.bandwidth[id]} kHz\n`;
+    }
+    await writeOut(io.stdout, line);
+  }
+
+  io.stderr.write(`${ids.length} of ${names.length} presets (index ${(queried - built).toFixed(1)} ms, ` +
+    `query ${((done - queried) * 1000).toFixed(1)} us)\n`);
+  return 0;
+}
+
+/**
+ * dedup: group the presets on stdin (or the given files) by canonical
+ * fingerprint, ignoring don't-care bits for --scope. Each cluster is printed
+ * as its fingerprint and member names, tab-separated (--json for NDJSON).
+ * With --to, the library is re-emitted with only the first preset of each
+ * cluster and the clusters go to stderr.
+ */
+export async function dedup(options: CommandOptions, io: CommandIO): Promise<number> {
+  const inputs = options.files.length > 0 ? options.files.map(file => createReadStream(file)) : [io.stdin];
+  const { names, images } = await readLibrary(inputs, options.from);
+
+  const started = performance.now();
+  const clusters = findDuplicateClusters(images, options.scope);
+  const elapsed = performance.now() - started;
+
+  const dropped = new Uint8Array(names.length);
+  for (const cluster of clusters) {
+    const members = cluster.members.map(id => names[id]);
+    const line = options.json
+      ? JSON.stringify({ fingerprint: cluster.fingerprint, names: members }) + '\n'
+      : `${cluster.fingerprint}\t${members.join('\t')}\n`;
+    if (options.explicitTo) io.stderr.write(line);
+    else await writeOut(io.stdout, line);
+    for (const id of cluster.members.slice(1)) dropped[id] = 1;
+  }
+
+  if (options.explicitTo) {
+    for (let id = 0; id < names.length; id++) {
+      if (dropped[id]) continue;
+      const { registers, paTable } = unpackImage(images, id * IMAGE_SIZE);
+      await writeOut(io.stdout, formatRecord({ name: names[id], registers, paTable }, options.to));
+    }
+  }
+
+  const duplicates = clusters.reduce((sum, cluster) => sum + cluster.members.length - 1, 0);
+  io.stderr.write(`${names.length} presets, ${clusters.length} clusters, ${duplicates} duplicates ` +
+    `(${options.scope} scope, ${elapsed.toFixed(1)} ms)\n`);
+  return 0;
+}
+
+const IMPACT_HEADINGS: Record<ChangeImpact, string> = {
+  'rf': 'RF parameters changed',
+  'power': 'Output power changed',
+  'fields': 'Other fields changed',
+  'dont-care': "Don't-care bits changed"
+};
+
+const DERIVED_UNITS: Record<string, string> = {
+  frequency: ' MHz',
+  dataRate: ' kBaud',
+  bandwidth: ' kHz',
+  deviation: ' kHz',
+  modulation: ''
+};
+
+function formatDerivedValue(key: string, value: number): string {
+  if (key === 'modulation') return MODULATION_FORMATS[value]?.name ?? `reserved (${value})`;
+  return `${Number(value.toFixed(4))}${DERIVED_UNITS[key]}`;
+}
+
+function formatPairChange(change: PairChange, name: string): string {
+  let output = `  ${name}\n`;
+  for (const { key, from, to } of change.derived) {
+    output += `    ${key}: ${formatDerivedValue(key, from)} -> ${formatDerivedValue(key, to)}\n`;
+  }
+  for (const field of change.changes) {
+    const path = field.field ? `${field.register}.${field.field}` : `${field.register} (reserved)`;
+    const affects = field.affects.length > 0 ? ` [${field.affects.join(', ')}]` : '';
+    output += `    ${path}: ${field.from} -> ${field.to}${affects}\n`;
+  }
+  if (change.paTable.length > 0) output += `    PATABLE[${change.paTable.join(', ')}] changed\n`;
+  return output;
+}
+
+/**
+ * compare: semantic diff of two library versions. Presets are matched by
+ * name, then by canonical fingerprint (renames); changed pairs are grouped
+ * by their strongest impact. --json streams one NDJSON line per entry.
+ */
+export async function compare(options: CommandOptions, io: CommandIO): Promise<number> {
+  if (options.files.length !== 2) {
+    io.stderr.write('compare: expected two library files\n');
+    return 2;
+  }
+  const started = performance.now();
+  const [before, after] = await Promise.all(
+    options.files.map(file => readLibrary([createReadStream(file)], options.from))
+  );
+  const read = performance.now();
+  const { match, changes } = await compareLibraryVersions(before, after, options);
+  const compared = performance.now();
+
+  const renamed: number[] = [];
+  match.renamed.forEach((flag, p) => flag && renamed.push(p));
+  const beforeName = (p: number) => before.names[match.pairs[p * 2]];
+  const afterName = (p: number) => after.names[match.pairs[p * 2 + 1]];
+
+  if (options.json) {
+    const lines: string[] = [];
+    for (const i of match.removed) lines.push(JSON.stringify({ kind: 'removed', name: before.names[i] }));
+    for (const j of match.added) lines.push(JSON.stringify({ kind: 'added', name: after.names[j] }));
+    for (const p of renamed) lines.push(JSON.stringify({ kind: 'renamed', from: beforeName(p), to: afterName(p) }));
+    for (const change of changes) {
+      const { pair, ...rest } = change;
+      lines.push(JSON.stringify({ kind: 'changed', name: afterName(pair), ...rest }));
+    }
+    for (const line of lines) await writeOut(io.stdout, line + '\n');
+  } else {
+    const sections: [string, string[]][] = [
+      ['Removed', match.removed.map(i => `  ${before.names[i]}\n`)],
+      ['Added', match.added.map(j => `  ${after.names[j]}\n`)],
+      ['Renamed', renamed.map(p => `  ${beforeName(p)} -> ${afterName(p)}\n`)],
+      ...CHANGE_IMPACTS.map((impact): [string, string[]] => [
+        IMPACT_HEADINGS[impact],
+        changes.filter(change => change.impact === impact).map(change => formatPairChange(change, afterName(change.pair)))
+      ])
+    ];
+    for (const [heading, entries] of sections) {
+      if (entries.length === 0) continue;
+      await writeOut(io.stdout, `${heading} (${entries.length})\n`);
+      for (const entry of entries) await writeOut(io.stdout, entry);
+      await writeOut(io.stdout, '\n');
+    }
+  }
+
+  const unchanged = match.renamed.length - changes.length;
+  io.stderr.write(`${before.names.length} -> ${after.names.length} presets: ${match.removed.length} removed, ` +
+    `${match.added.length} added, ${renamed.length} renamed, ${changes.length} changed, ${unchanged} unchanged ` +
+    `(read ${Math.round(read - started)} ms, compare ${Math.round(compared - read)} ms, ${options.jobs} jobs)\n`);
+  return 0;
+}
+
+function formatConflictValue(conflict: FieldConflict, value: number): string {
+  return compileFieldPath(conflict.path)?.format(value) ?? `0x${toHex(value)}`;
+}
+
+/**
+ * merge: three-way merge of base, ours and theirs at field granularity.
+ * The merged library goes to stdout in the input format (or --to);
+ * conflicts are listed on stderr and resolved to --prefer. Exits 1 when
+ * there were conflicts.
+ */
+export async function merge(options: CommandOptions, io: CommandIO): Promise<number> {
+  if (options.files.length !== 3) {
+    io.stderr.write('merge: expected base, ours and theirs library files\n');
+    return 2;
+  }
+  const [base, ours, theirs] = await Promise.all(
+    options.files.map(file => readLibrary([createReadStream(file)], options.from))
+  );
+  const started = performance.now();
+  const result = mergeLibraries(base, ours, theirs, { prefer: options.prefer });
+  const elapsed = performance.now() - started;
+
+  const to = options.explicitTo ? options.to : options.from;
+  for (let i = 0; i < result.names.length; i++) {
+    const { registers, paTable } = unpackImage(result.images, i * IMAGE_SIZE);
+    await writeOut(io.stdout, formatRecord({ name: result.names[i], registers, paTable }, to));
+  }
+
+  for (const conflict of result.conflicts) {
+    if (conflict.kind === 'delete-modify') {
+      io.stderr.write(`${conflict.name}: deleted by ${conflict.deletedBy}, modified by the other side; kept\n`);
+      continue;
+    }
+    for (const field of conflict.fields) {
+      io.stderr.write(`${conflict.name}: ${conflict.kind === 'add-add' ? 'added on both sides, ' : ''}${field.path}: ` +
+        `base ${formatConflictValue(field, field.base)}, ours ${formatConflictValue(field, field.ours)}, ` +
+        `theirs ${formatConflictValue(field, field.theirs)}\n`);
+    }
+  }
+  io.stderr.write(`${result.names.length} presets, ${result.merged} merged from both sides, ` +
+    `${result.conflicts.length} with conflicts (${elapsed.toFixed(1)} ms)\n`);
+  return result.conflicts.length > 0 ? 1 : 0;
+}
+
+/**
+ * patch: apply a patch file (see utils/patch.ts) to the presets on stdin or
+ * in the given library files. The patched library goes to stdout in the
+ * input format (or --to); the change report goes to stderr.
+ */
+export async function patch(options: CommandOptions, io: CommandIO): Promise<number> {
+  if (options.files.length < 1) {
+    io.stderr.write('patch: expected a patch file and optional library files\n');
+    return 2;
+  }
+  const [patchFile, ...libraries] = options.files;
+  let compiled: CompiledPatch;
+  try {
+    compiled = compilePatch(await readFile(patchFile, 'utf8'));
+  } catch (err) {
+    throw new Error(`${patchFile}: ${(err as Error).message}`);
+  }
+  const inputs = libraries.length > 0 ? libraries.map(file => createReadStream(file)) : [io.stdin];
+  const { names, images } = await readLibrary(inputs, options.from);
+
+  const { report } = applyPatch(compiled, images, names, { inPlace: true });
+
+  const to = options.explicitTo ? options.to : options.from;
+  for (let i = 0; i < names.length; i++) {
+    const { registers, paTable } = unpackImage(images, i * IMAGE_SIZE);
+    await writeOut(io.stdout, formatRecord({ name: names[i], registers, paTable }, to));
+  }
+  io.stderr.write(generatePatchReport(report));
+  return 0;
+}
+
+// Output is handed to writeOut in batches of about this many characters
+const FLEET_BATCH = 64 * 1024;
+
+/**
+ * fleet: build one preset per CSV row from a template (see utils/fleet.ts)
+ * and emit them in --to. The CSV comes from the second file or stdin; its
+ * first line names the columns. Rows share one image, register record and
+ * PA table, so the per-row cost is the bound writes plus formatting. Bad
+ * rows are reported on stderr and skipped, and the exit code is 1.
+ */
+export async function fleet(options: CommandOptions, io: CommandIO): Promise<number> {
+  if (options.files.length < 1 || options.files.length > 2) {
+    io.stderr.write('fleet: expected a template file and an optional CSV file\n');
+    return 2;
+  }
+  const text = await readFile(options.files[0], 'utf8');
+  const input = options.files.length === 2 ? createReadStream(options.files[1]) : io.stdin;
+
+  const started = performance.now();
+  const row = createCsvRow();
+  const image = new Uint8Array(IMAGE_SIZE);
+  const record: PresetRecord = { name: '', registers: {}, paTable: new Array<number>(PA_TABLE_SIZE).fill(0) };
+  let template: FleetTemplate | null = null;
+  let lineNumber = 0;
+  let units = 0;
+  let rejected = 0;
+  let batch = '';
+
+  for await (const line of createInterface({ input, crlfDelay: Infinity })) {
+    lineNumber++;
+    if (line.trim().length === 0) continue;
+    splitCsvLine(line, row);
+    if (!template) {
+      const header = Array.from({ length: row.count }, (_, i) => csvField(row, i));
+      try {
+        template = compileFleetTemplate(text, header);
+      } catch (err) {
+        throw new Error(`${options.files[0]}: ${(err as Error).message}`);
+      }
+      continue;
+    }
+
+    try {
+      record.name = template.write(row, image);
+    } catch (err) {
+      io.stderr.write(`CSV line ${lineNumber}: ${(err as Error).message}\n`);
+      rejected++;
+      continue;
+    }
+    for (let addr = 0; addr < REGISTER_COUNT; addr++) record.registers[addr] = image[addr];
+    for (let i = 0; i < PA_TABLE_SIZE; i++) record.paTable[i] = image[REGISTER_COUNT + i];
+    batch += formatRecord(record, options.to);
+    units++;
+    if (batch.length >= FLEET_BATCH) {
+      await writeOut(io.stdout, batch);
+      batch = '';
+    }
+  }
+  if (batch.length > 0) await writeOut(io.stdout, batch);
+
+  if (!template) {
+    io.stderr.write('fleet: the CSV has no header line\n');
+    return 2;
+  }
+  io.stderr.write(`${units} units${rejected > 0 ? `, ${rejected} rows rejected` : ''} ` +
+    `(${Math.round(performance.now() - started)} ms)\n`);
+  return rejected > 0 ? 1 : 0;
+}
@@ -0,0 +1,84 @@
+// @vitest-environment node
+import { describe, it, expect } from 'vitest';
+import { mkdtempSync, writeFileSync } from 'node:fs';
+import { tmpdir } from 'node:os';
+import { join } from 'node:path';
+import { PassThrough, Readable } from 'node:stream';
+import { PRESETS } from '../data/registers';
+import { generateFlipperSettingUserBatch } from '../utils/export';
+import { main } from './main';
+
+function settingUser(entries: [string, string, Record<number, number>?][]): string {
+  return generateFlipperSettingUserBatch(entries.map(([name, preset, edits]) => ({
+    name,
+    registers: { ...PRESETS[preset].registers, ...edits },
+    paTable: PRESETS[preset].paTable
+  })));
+}
+
+async function run(args: string[]) {
+  const stdout = new PassThrough();
+  const stderr = new PassThrough();
+  const chunks: string[] = [];
+  stdout.on('data', chunk => chunks.push(String(chunk)));
+  const code = await main(args, { stdin: Readable.from([]), stdout, stderr });
+  return { code, output: chunks.join('') };
+}
+
+describe('Library Compare and Merge CLI', () => {
+  it('reports added, removed, renamed and changed presets grouped by impact', async () => {
+    const root = mkdtempSync(join(tmpdir(), 'cc1101-compare-'));
+    const before = join(root, 'before.txt');
+    const after = join(root, 'after.txt');
+    writeFileSync(before, settingUser([
+      ['FSK', 'FM 2-FSK (433.92MHz)'],
+      ['OOK', 'AM 650kHz (433.92MHz)'],
+      ['Chat', 'SubGHz Chat (433.92MHz)']
+    ]));
+    writeFileSync(after, settingUser([
+      ['FSK', 'FM 2-FSK (433.92MHz)', { 0x12: PRESETS['GFSK 9.99kbps (433.92MHz)'].registers[0x12] }],
+      ['OOK 650', 'AM 650kHz (433.92MHz)'],
+      ['Walkie', 'Walkie Talkie (433.92MHz)']
+    ]));
+
+    const text = await run(['compare', '-j', '1', before, after]);
+    expect(text.code).toBe(0);
+    expect(text.output).toContain('Removed (1)\n  Chat\n');
+    expect(text.output).toContain('Added (1)\n  Walkie\n');
+    expect(text.output).toContain('Renamed (1)\n  OOK -> OOK 650\n');
+    expect(text.output).toMatch(/RF parameters changed \(1\)\n  FSK\n    modulation: 2-FSK -> GFSK\n/);
+
+    const json = await run(['compare', '--json', before, after]);
+    const lines = json.output.trim().split('\n').map(line => JSON.parse(line));
+    expect(lines.map(l => l.kind)).toEqual(['removed', 'added', 'renamed', 'changed']);
+    expect(lines[3].impact).toBe('rf');
+
+    expect((await run(['compare', before])).code).toBe(2);
+  });
+
+  it('merges three library versions and reports conflicting fields', async () => {
+    const root = mkdtempSync(join(tmpdir(), 'cc1101-merge-'));
+    const files = ['base', 'ours', 'theirs'].map(name => join(root, `${name}.txt`));
+    writeFileSync(files[0], settingUser([['FSK', 'FM 2-FSK (433.92MHz)'], ['OOK', 'AM 650kHz (433.92MHz)']]));
+    writeFileSync(files[1], settingUser([
+      ['FSK', 'FM 2-FSK (433.92MHz)', { 0x06: 0x20 }],
+      ['OOK', 'AM 650kHz (433.92MHz)', { 0x06: 0x10 }]
+    ]));
+    writeFileSync(files[2], settingUser([
+      ['FSK', 'FM 2-FSK (433.92MHz)', { 0x15: 0x47 }],
+      ['OOK', 'AM 650kHz (433.92MHz)', { 0x06: 0x30 }]
+    ]));
+
+    const stdout = new PassThrough();
+    const stderr = new PassThrough();
+    const out: string[] = [];
+    const err: string[] = [];
+    stdout.on('data', chunk => out.push(String(chunk)));
+    stderr.on('data', chunk => err.push(String(chunk)));
+    const code = await main(['merge', ...files], { stdin: Readable.from([]), stdout, stderr });
+
+    expect(code).toBe(1);
+    expect(out.join('')).toMatch(/Custom_preset_name: FSK\nCustom_preset_module: CC1101\nCustom_preset_data: .*06 20 .*15 47/);
+    expect(err.join('')).toContain('OOK: PKTLEN.PACKET_LENGTH: base 0x00, ours 0x10, theirs 0x30\n');
+  });
+});
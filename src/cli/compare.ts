@@ -0,0 +1,90 @@
+/**
+ * Parallel Library Comparison
+ *
+ * Matching is one hash pass on the main thread; the field-level comparison
+ * of matched pairs is split into contiguous shards whose interleaved images
+ * are transferred to a worker_threads pool, so no preset data is copied
+ * between threads more than once.
+ */
+
+import { once } from 'node:events';
+import { Worker, parentPort } from 'node:worker_threads';
+import { comparePairImages, matchLibraries, packPairImages } from '../utils/libraryDiff';
+import type { LibraryComparison, PairChange } from '../utils/libraryDiff';
+import type { FieldConfigBank } from '../utils/fieldConfig';
+
+export interface ComparePoolOptions {
+  jobs: number;
+  workerEntry?: URL; // Module that calls runCompareWorker() off the main thread
+}
+
+interface CompareShard {
+  images: Uint8Array;
+  firstPair: number;
+}
+
+// Below this many pairs per job, starting workers costs more than it saves
+const MIN_SHARD_PAIRS = 2048;
+// Shards per job, so a worker that finishes early picks up more
+const SHARDS_PER_JOB = 4;
+
+/** workerData marking a comparison worker; other workers run the linter */
+export const COMPARE_WORKER = 'compare';
+
+/**
+ * Worker side of the pool: compare each shard it is sent
+ */
+export function runCompareWorker(): void {
+  parentPort!.on('message', (shard: CompareShard) => {
+    parentPort!.postMessage(comparePairImages(shard.images, shard.firstPair));
+  });
+}
+
+function request(worker: Worker, shard: CompareShard): Promise<PairChange[]> {
+  const reply = once(worker, 'message') as Promise<[PairChange[]]>;
+  worker.postMessage(shard, [shard.images.buffer]);
+  return reply.then(([results]) => results);
+}
+
+/**
+ * Match two libraries and compare every matched pair, on `jobs` workers
+ * when the libraries are large enough to be worth it
+ */
+export async function compareLibraryVersions(
+  before: FieldConfigBank,
+  after: FieldConfigBank,
+  options: ComparePoolOptions
+): Promise<LibraryComparison> {
+  const match = matchLibraries(before, after);
+  const count = match.renamed.length;
+  const jobs = Math.min(options.jobs, Math.floor(count / MIN_SHARD_PAIRS));
+  if (jobs <= 1 || !options.workerEntry) {
+    return { match, changes: comparePairImages(packPairImages(before.images, after.images, match)) };
+  }
+
+  const shardSize = Math.ceil(count / (jobs * SHARDS_PER_JOB));
+  let nextPair = 0;
+  const results: PairChange[][] = [];
+  const workers = Array.from(
+    { length: jobs },
+    () => new Worker(options.workerEntry!, { workerData: COMPARE_WORKER })
+  );
+
+  // Shards are packed as they are handed out, so only one per worker is
+  // ever waiting in memory
+  const drive = async (worker: Worker) => {
+    while (nextPair < count) {
+      const start = nextPair;
+      nextPair = Math.min(count, start + shardSize);
+      const images = packPairImages(before.images, after.images, match, start, nextPair);
+      results[start / shardSize] = await request(worker, { images, firstPair: start });
+    }
+  };
+
+  try {
+    await Promise.all(workers.map(drive));
+  } finally {
+    await Promise.all(workers.map(worker => worker.terminate()));
+  }
+  return { match, changes: results.flat() };
+}
@@ -0,0 +1,72 @@
+// @vitest-environment node
+import { describe, it, expect } from 'vitest';
+import { mkdirSync, mkdtempSync, writeFileSync } from 'node:fs';
+import { tmpdir } from 'node:os';
+import { join } from 'node:path';
+import { PassThrough, Readable } from 'node:stream';
+import { PRESETS } from '../data/registers';
+import { generateCArray, generateFlipperSettingUser } from '../utils/export';
+import { isLintCandidate, lintText } from './lint';
+import { main } from './main';
+
+const fsk = PRESETS['FM 2-FSK (433.92MHz)'];
+const SUB_FILE = [
+  'Filetype: Flipper SubGhz RAW File',
+  'Version: 1',
+  'Frequency: 433920000',
+  'Preset: FuriHalSubGhzPreset2FSKDev238Async',
+  'Protocol: RAW',
+  'RAW_Data: 500 -500 500 -500',
+].join('\n');
+
+describe('Preset Linter', () => {
+  it('validates every preset in a setting_user file', () => {
+    const text = [
+      generateFlipperSettingUser('ok', fsk.registers, fsk.paTable),
+      generateFlipperSettingUser('bad', { ...fsk.registers, 0x12: 0x23 }, fsk.paTable.slice(0, 4)),
+    ].join('\n\n');
+    const result = lintText('setting_user', text);
+    expect(result.kind).toBe('setting_user');
+    expect(result.presets.map(p => p.name)).toEqual(['ok', 'bad']);
+    expect(result.presets[0].issues.filter(i => i.severity === 'error')).toEqual([]);
+    const codes = result.presets[1].issues.map(i => i.code);
+    expect(codes).toContain('mod-format');
+    expect(codes).toContain('pa-table-length');
+  });
+
+  it('detects .sub and C array files and skips other text', () => {
+    expect(lintText('cap.sub', SUB_FILE).presets).toHaveLength(1);
+    const header = lintText('p.h', generateCArray('p', fsk.registers, fsk.paTable));
+    expect(header.kind).toBe('c-array');
+    expect(header.presets[0].name).toBe('p');
+    expect(lintText('notes.txt', 'nothing to see').kind).toBeNull();
+    expect(lintText('cap.sub', 'Filetype: Flipper SubGhz RAW File\nProtocol: RAW').error).toBe('No Preset line');
+  });
+
+  it('only opens preset file extensions', () => {
+    expect(isLintCandidate('a/setting_user')).toBe(true);
+    expect(isLintCandidate('a/setting_user.bak')).toBe(true);
+    expect(isLintCandidate('a/cap.sub')).toBe(true);
+    expect(isLintCandidate('a/image.png')).toBe(false);
+  });
+
+  it('walks a tree, streams NDJSON and exits 1 on errors', async () => {
+    const root = mkdtempSync(join(tmpdir(), 'cc1101-lint-'));
+    mkdirSync(join(root, 'sub'));
+    writeFileSync(join(root, 'setting_user'), generateFlipperSettingUser('ok', fsk.registers, fsk.paTable));
+    writeFileSync(join(root, 'sub', 'cap.sub'), SUB_FILE);
+    writeFileSync(join(root, 'sub', 'logo.png'), 'binary');
+
+    const stdout = new PassThrough();
+    const chunks: string[] = [];
+    stdout.on('data', chunk => chunks.push(String(chunk)));
+    const io = { stdin: Readable.from([]), stdout, stderr: new PassThrough() };
+
+    expect(await main(['lint', '--json', '-j', '1', root], io)).toBe(0);
+    const lines = chunks.join('').trim().split('\n').map(line => JSON.parse(line));
+    expect(lines.map(l => l.file).sort()).toEqual([join(root, 'setting_user'), join(root, 'sub', 'cap.sub')]);
+
+    writeFileSync(join(root, 'broken.sub'), 'Filetype: Flipper SubGhz RAW File\nPreset: Unknown\nProtocol: RAW');
+    expect(await main(['lint', '-j', '1', root], io)).toBe(1);
+  });
+});
@@ -0,0 +1,267 @@
+/**
+ * Preset Tree Linter
+ *
+ * Walks directories for setting_user, .sub, C array, SmartRF and field
+ * config files and validates every preset they hold. Files are sharded in
+ * batches across a worker_threads pool; each worker reads and checks its
+ * batch and posts the results back, so throughput scales with cores.
+ */
+
+import { once } from 'node:events';
+import { readFileSync } from 'node:fs';
+import { opendir, readFile } from 'node:fs/promises';
+import { basename, extname, join } from 'node:path';
+import { Worker, parentPort } from 'node:worker_threads';
+import { parseCArrayPresets } from '../utils/cArray';
+import { parseFlipperPresetPairs } from '../utils/export';
+import { parseFieldConfig, isFieldConfig } from '../utils/fieldConfig';
+import { IMAGE_SIZE, PA_TABLE_SIZE, packImage } from '../utils/image';
+import { forEachLine } from '../utils/lines';
+import { parseSmartRfListing, isSmartRfListing } from '../utils/smartrf';
+import { fingerprint64 } from '../utils/hash';
+import { parseSubFile } from '../utils/subFile';
+import { validateImage } from '../utils/validate';
+import type { ImageIssue } from '../utils/validate';
+
+export type LintKind = 'setting_user' | 'sub' | 'c-array' | 'smartrf' | 'field-config';
+
+export interface LintedPreset {
+  name: string;
+  issues: ImageIssue[];
+}
+
+export interface LintFileResult {
+  file: string;
+  kind: LintKind | null; // null: not a preset file, skipped
+  presets: LintedPreset[];
+  error?: string;        // The file could not be read or parsed
+  hash?: string;         // fingerprint64 of the file contents
+}
+
+export type ImageValidator = (image: Uint8Array, offset?: number) => ImageIssue[];
+
+export interface LintPoolOptions {
+  jobs: number;
+  workerEntry?: URL; // Module that calls runLintWorker() off the main thread
+}
+
+// Paths per worker message; amortizes postMessage over small files
+const BATCH_SIZE = 32;
+
+const SOURCE_EXTENSIONS = new Set(['.sub', '.h', '.c', '.txt', '.cfg', '']);
+const SKIPPED_DIRECTORIES = new Set(['.git', 'node_modules']);
+
+/**
+ * Whether a path is worth opening
+ */
+export function isLintCandidate(path: string): boolean {
+  return SOURCE_EXTENSIONS.has(extname(path).toLowerCase()) || basename(path).startsWith('setting_user');
+}
+
+function detectKind(file: string, text: string): LintKind | null {
+  const ext = extname(file).toLowerCase();
+  if (text.includes('Custom_preset_name:') || text.includes('Setting File')) return 'setting_user';
+  if (ext === '.sub' || text.startsWith('Filetype: Flipper SubGhz')) return 'sub';
+  if ((ext === '.h' || ext === '.c') && text.includes('uint8_t')) return 'c-array';
+  if (isSmartRfListing(text)) return 'smartrf';
+  if (isFieldConfig(text)) return 'field-config';
+  return null;
+}
+
+function reportable(issues: ImageIssue[]): ImageIssue[] {
+  return issues.filter(issue => issue.severity !== 'info');
+}
+
+function check(
+  validate: ImageValidator,
+  name: string,
+  registers: Record<number, number>,
+  paTable: number[]
+): LintedPreset {
+  const issues = reportable(validate(packImage(registers, paTable)));
+  if (paTable.length !== PA_TABLE_SIZE) {
+    issues.push({
+      severity: 'error',
+      code: 'pa-table-length',
+      message: `PA table has ${paTable.length} bytes, expected ${PA_TABLE_SIZE}`
+    });
+  }
+  return { name, issues };
+}
+
+/**
+ * Validate every preset in one file's contents. `validate` lets callers put
+ * a cache in front of validateImage.
+ */
+export function lintText(file: string, text: string, validate: ImageValidator = validateImage): LintFileResult {
+  const kind = detectKind(file, text);
+  const result: LintFileResult = { file, kind, presets: [] };
+
+  try {
+    switch (kind) {
+      case 'setting_user': {
+        let name: string | null = null;
+        forEachLine(text, line => {
+          const trimmed = line.trim();
+          if (trimmed.startsWith('Custom_preset_name:')) {
+            name = trimmed.slice('Custom_preset_name:'.length).trim();
+          } else if (trimmed.startsWith('Custom_preset_data:')) {
+            const { registers, paTable } = parseFlipperPresetPairs(trimmed);
+            result.presets.push(check(validate, name ?? `preset_${result.presets.length + 1}`, registers, paTable));
+            name = null;
+          }
+        });
+        break;
+      }
+      case 'sub': {
+        const sub = parseSubFile(text);
+        if (sub.preset) {
+          result.presets.push(check(validate, sub.preset.name, sub.preset.registers, sub.preset.paTable));
+        } else {
+          result.error = sub.presetError ?? 'No preset';
+        }
+        break;
+      }
+      case 'c-array':
+        for (const preset of parseCArrayPresets(text)) {
+          result.presets.push(check(validate, preset.name, preset.registers, preset.paTable));
+        }
+        break;
+      case 'smartrf': {
+        const listing = parseSmartRfListing(text);
+        const linted = check(validate, basename(file, extname(file)), listing.registers, listing.paTable);
+        if (listing.paTable.length === 0) {
+          // Listings often leave PATABLE out; the chip keeps its reset table
+          linted.issues = linted.issues.filter(issue => issue.code !== 'pa-table-length');
+        }
+        result.presets.push(linted);
+        break;
+      }
+      case 'field-config': {
+        const { names, images } = parseFieldConfig(text);
+        names.forEach((name, i) => {
+          result.presets.push({ name, issues: reportable(validate(images, i * IMAGE_SIZE)) });
+        });
+        break;
+      }
+    }
+  } catch (err) {
+    result.error = (err as Error).message;
+  }
+
+  return result;
+}
+
+const decoder = new TextDecoder();
+
+/**
+ * lintText over raw file bytes, recording their content hash
+ */
+export function lintBytes(file: string, bytes: Uint8Array, validate?: ImageValidator): LintFileResult {
+  const result = lintText(file, decoder.decode(bytes), validate);
+  result.hash = fingerprint64(bytes);
+  return result;
+}
+
+function readFailed(file: string, err: unknown): LintFileResult {
+  return { file, kind: null, presets: [], error: (err as Error).message };
+}
+
+/**
+ * Recursively list candidate files under each root, depth first
+ */
+export async function* walkPresetFiles(roots: string[]): AsyncGenerator<string> {
+  for (const root of roots) {
+    let dir;
+    try {
+      dir = await opendir(root);
+    } catch (err) {
+      if ((err as NodeJS.ErrnoException).code === 'ENOTDIR') {
+        yield root;
+        continue;
+      }
+      throw err;
+    }
+    for await (const entry of dir) {
+      const path = join(root, entry.name);
+      if (entry.isDirectory()) {
+        if (!SKIPPED_DIRECTORIES.has(entry.name)) yield* walkPresetFiles([path]);
+      } else if (entry.isFile() && isLintCandidate(path)) {
+        yield path;
+      }
+    }
+  }
+}
+
+/**
+ * Worker side of the pool: lint each batch of paths it is sent
+ */
+export function runLintWorker(): void {
+  parentPort!.on('message', (paths: string[]) => {
+    parentPort!.postMessage(paths.map(path => {
+      try {
+        return lintBytes(path, readFileSync(path));
+      } catch (err) {
+        return readFailed(path, err);
+      }
+    }));
+  });
+}
+
+async function nextBatch(paths: AsyncIterator<string>): Promise<string[]> {
+  const batch: string[] = [];
+  while (batch.length < BATCH_SIZE) {
+    const next = await paths.next();
+    if (next.done) break;
+    batch.push(next.value);
+  }
+  return batch;
+}
+
+function request(worker: Worker, batch: string[]): Promise<LintFileResult[]> {
+  const reply = once(worker, 'message') as Promise<[LintFileResult[]]>;
+  worker.postMessage(batch);
+  return reply.then(([results]) => results);
+}
+
+/**
+ * Lint every path, calling onResult as each file completes. Results arrive
+ * in completion order. With one job, or no worker entry, runs in-process.
+ */
+export async function lintPaths(
+  paths: AsyncIterable<string>,
+  options: LintPoolOptions,
+  onResult: (result: LintFileResult) => Promise<void> | void
+): Promise<void> {
+  if (options.jobs <= 1 || !options.workerEntry) {
+    for await (const path of paths) {
+      let result: LintFileResult;
+      try {
+        result = lintBytes(path, await readFile(path));
+      } catch (err) {
+        result = readFailed(path, err);
+      }
+      await onResult(result);
+    }
+    return;
+  }
+
+  const iterator = paths[Symbol.asyncIterator]();
+  const workers = Array.from({ length: options.jobs }, () => new Worker(options.workerEntry!));
+
+  // Each worker pulls the next batch when it finishes one, so slow files
+  // do not stall a statically assigned shard
+  const drive = async (worker: Worker) => {
+    for (;;) {
+      const batch = await nextBatch(iterator);
+      if (batch.length === 0) return;
+      for (const result of await request(worker, batch)) await onResult(result);
+    }
+  };
+
+  try {
+    await Promise.all(workers.map(drive));
+  } finally {
+    await Promise.all(workers.map(worker => worker.terminate()));
+  }
+}
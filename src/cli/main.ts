@@ -0,0 +1,208 @@
+/**
+ * CLI Argument Parsing and Dispatch
+ */
+
+import { availableParallelism } from 'node:os';
+import { parseArgs } from 'node:util';
+import { parseModulation } from '../utils/derive';
+import { compilePredicate } from '../utils/predicate';
+import type { CompiledPredicate } from '../utils/predicate';
+import { parseRange } from '../utils/presetIndex';
+import type { PresetQuery } from '../utils/presetIndex';
+import { compare, convert, dedup, diff, explain, fleet, lint, merge, patch, query, serve, validate } from './commands';
+import type { CommandIO, CommandOptions, CommandRuntime } from './commands';
+import { INPUT_FORMATS, OUTPUT_FORMATS } from './records';
+import type { InputFormat, OutputFormat } from './records';
+
+const COMMANDS = new Map([
+  ['convert', convert],
+  ['explain', explain],
+  ['validate', validate],
+  ['diff', diff],
+  ['lint', lint],
+  ['serve', serve],
+  ['query', query],
+  ['dedup', dedup],
+  ['compare', compare],
+  ['merge', merge],
+  ['patch', patch],
+  ['fleet', fleet]
+]);
+
+const USAGE = `Usage: cc1101 <command> [options]
+
+Commands:
+  convert   Convert every preset on stdin (--from, --to)
+  explain   Print derived RF parameters and non-default fields
+  validate  Check presets, exit 1 on errors (--json for NDJSON)
+  diff      Field diff of two files pairwise, or consecutive stdin presets
+  lint      Validate every preset file under the given paths (default .)
+  serve     HTTP service for convert, validate, explain, solve and export
+  query     Index presets on stdin and print those matching the filters
+  dedup     Group presets that differ only in don't-care bits
+  compare   Added, removed, renamed and changed presets between two library files
+  merge     Three-way merge of base, ours and theirs library files by field
+  patch     Apply a patch file's field rules: patch fixes.patch [library files]
+  fleet     One preset per CSV row from a template: fleet template.txt [units.csv]
+
+Options:
+  --from <format>  ${INPUT_FORMATS.join(', ')} (default flipper)
+  --to <format>    ${OUTPUT_FORMATS.join(', ')} (default c-array)
+  --json           Machine-readable output
+  -j, --jobs <n>   Lint and compare worker threads (default: one per core)
+  -w, --watch      Keep linting files as they change
+  --frequency <r>  query: occupied band overlaps r MHz, e.g. 433.8-434.1
+  --modulation <m> query: 2-FSK, GFSK, ASK/OOK, 4-FSK or MSK
+  --data-rate <r>  query: data rate range in kBaud
+  --bandwidth <r>  query: RX filter bandwidth range in kHz
+  --where <expr>   query: predicate, e.g. "CHANBW < 100 kHz and at 868 MHz"
+  --prefer <side>  merge: ours or theirs wins conflicting fields (default ours)
+  --scope <scope>  dedup: flipper ignores registers Flipper does not export,
+                   device only reserved bits (default flipper)
+  --host <host>    serve address (default 127.0.0.1)
+  --port <port>    serve port (default 8787, 0 for any free port)
+  -h, --help       Show this help
+`;
+
+function parse(argv: string[]) {
+  return parseArgs({
+    args: argv,
+    allowPositionals: true,
+    options: {
+      from: { type: 'string', default: 'flipper' },
+      to: { type: 'string' },
+      json: { type: 'boolean', default: false },
+      jobs: { type: 'string', short: 'j' },
+      watch: { type: 'boolean', short: 'w', default: false },
+      host: { type: 'string', default: '127.0.0.1' },
+      port: { type: 'string', default: '8787' },
+      frequency: { type: 'string' },
+      modulation: { type: 'string' },
+      'data-rate': { type: 'string' },
+      bandwidth: { type: 'string' },
+      where: { type: 'string' },
+      prefer: { type: 'string', default: 'ours' },
+      scope: { type: 'string', default: 'flipper' },
+      help: { type: 'boolean', short: 'h', default: false }
+    }
+  });
+}
+
+/**
+ * Run one CLI invocation; resolves to the process exit code.
+ * `runtime.workerEntry` is the module worker threads start from; without it
+ * lint runs in-process.
+ */
+export async function main(argv: string[], io: CommandIO, runtime: CommandRuntime = {}): Promise<number> {
+  let parsed: ReturnType<typeof parse>;
+  try {
+    parsed = parse(argv);
+  } catch (err) {
+    io.stderr.write(`${(err as Error).message}\n\n${USAGE}`);
+    return 2;
+  }
+
+  const [command, ...files] = parsed.positionals;
+  if (parsed.values.help || !command) {
+    (parsed.values.help ? io.stdout : io.stderr).write(USAGE);
+    return parsed.values.help ? 0 : 2;
+  }
+
+  const run = COMMANDS.get(command);
+  if (!run) {
+    io.stderr.write(`Unknown command: ${command}\n\n${USAGE}`);
+    return 2;
+  }
+
+  const from = parsed.values.from as InputFormat;
+  const to = (parsed.values.to ?? 'c-array') as OutputFormat;
+  if (!INPUT_FORMATS.includes(from)) {
+    io.stderr.write(`Unknown input format: ${from}\n`);
+    return 2;
+  }
+  if (!OUTPUT_FORMATS.includes(to)) {
+    io.stderr.write(`Unknown output format: ${to}\n`);
+    return 2;
+  }
+
+  const jobs = parsed.values.jobs === undefined ? availableParallelism() : Number(parsed.values.jobs);
+  if (!Number.isInteger(jobs) || jobs < 1) {
+    io.stderr.write(`Invalid job count: ${parsed.values.jobs}\n`);
+    return 2;
+  }
+
+  const port = Number(parsed.values.port);
+  if (!Number.isInteger(port) || port < 0 || port > 65535) {
+    io.stderr.write(`Invalid port: ${parsed.values.port}\n`);
+    return 2;
+  }
+
+  const where: PresetQuery = {};
+  const ranges: ['frequency' | 'dataRate' | 'bandwidth', string | undefined][] = [
+    ['frequency', parsed.values.frequency],
+    ['dataRate', parsed.values['data-rate']],
+    ['bandwidth', parsed.values.bandwidth]
+  ];
+  for (const [key, text] of ranges) {
+    if (text === undefined) continue;
+    const range = parseRange(text);
+    if (!range) {
+      io.stderr.write(`Invalid range: ${text}\n`);
+      return 2;
+    }
+    where[key] = range;
+  }
+  if (parsed.values.modulation !== undefined) {
+    const modulation = parseModulation(parsed.values.modulation);
+    if (modulation === null) {
+      io.stderr.write(`Unknown modulation: ${parsed.values.modulation}\n`);
+      return 2;
+    }
+    where.modulation = modulation;
+  }
+
+  let predicate: CompiledPredicate | null = null;
+  if (parsed.values.where !== undefined) {
+    try {
+      predicate = compilePredicate(parsed.values.where);
+    } catch (err) {
+      io.stderr.write(`Invalid predicate: ${(err as Error).message}\n`);
+      return 2;
+    }
+  }
+
+  const prefer = parsed.values.prefer ?? 'ours';
+  if (prefer !== 'ours' && prefer !== 'theirs') {
+    io.stderr.write(`Invalid merge side: ${prefer}\n`);
+    return 2;
+  }
+
+  const scope = parsed.values.scope ?? 'flipper';
+  if (scope !== 'flipper' && scope !== 'device') {
+    io.stderr.write(`Invalid dedup scope: ${scope}\n`);
+    return 2;
+  }
+
+  const options: CommandOptions = {
+    ...runtime,
+    from,
+    to,
+    json: parsed.values.json ?? false,
+    watch: parsed.values.watch ?? false,
+    files,
+    jobs,
+    host: parsed.values.host ?? '127.0.0.1',
+    port,
+    where,
+    predicate,
+    prefer,
+    scope,
+    explicitTo: parsed.values.to !== undefined
+  };
+  try {
+    return await run(options, io);
+  } catch (err) {
+    io.stderr.write(`cc1101 ${command}: ${(err as Error).message}\n`);
+    return 1;
+  }
+}
@@ -0,0 +1,173 @@
+/**
+ * Line-Delimited Preset Records for the CLI
+ * Readers keep at most one record (one field config section) in memory.
+ */
+
+import { once } from 'node:events';
+import { createInterface } from 'node:readline';
+import type { Readable, Writable } from 'node:stream';
+import type { ExportFormat } from '../types/cc1101';
+import { MODULATION_FORMATS } from '../data/registers';
+import { deriveImage } from '../utils/derive';
+import { generateExport, parseFlipperPresetPairs, parseRawHex } from '../utils/export';
+import { formatFieldConfigImage, parseFieldConfig } from '../utils/fieldConfig';
+import { DEFAULT_PA_TABLE, IMAGE_SIZE, REGISTER_COUNT, packImage, unpackImage } from '../utils/image';
+import { toHex } from '../utils/calculations';
+
+export const INPUT_FORMATS = ['flipper', 'raw-hex', 'field-config'] as const;
+export type InputFormat = typeof INPUT_FORMATS[number];
+
+export const OUTPUT_FORMATS = [
+  'flipper', 'c-array', 'raw-hex', 'field-config', 'smartrf', 'smartrf-header', 'wake-restore', 'json'
+] as const;
+export type OutputFormat = typeof OUTPUT_FORMATS[number];
+
+const EXPORT_FORMATS: Partial<Record<OutputFormat, ExportFormat>> = {
+  'flipper': 'flipper_setting',
+  'c-array': 'c_array',
+  'field-config': 'field_config',
+  'smartrf': 'smartrf_listing',
+  'smartrf-header': 'smartrf_header',
+  'wake-restore': 'wake_restore'
+};
+
+export interface PresetRecord {
+  name: string;
+  registers: Record<number, number>;
+  paTable: number[];
+}
+
+export interface RecordReader {
+  line: (text: string) => void;
+  end: () => void;
+}
+
+/**
+ * Line-at-a-time record parser.
+ *   flipper:      setting_user files or bare Custom_preset_data lines; unlisted
+ *                 registers keep their reset values
+ *   raw-hex:      one line of register values per preset
+ *   field-config: [name] sections
+ */
+export function createRecordReader(format: InputFormat, onRecord: (record: PresetRecord) => void): RecordReader {
+  let count = 0;
+  // Complete every record to all 47 registers and 8 PA bytes
+  const emit = (record: PresetRecord) => {
+    onRecord({ name: record.name, ...unpackImage(packImage(record.registers, record.paTable)) });
+  };
+  const nextName = () => `preset_${++count}`;
+
+  if (format === 'raw-hex') {
+    return {
+      line(text) {
+        if (text.trim().length === 0) return;
+        emit({ name: nextName(), registers: parseRawHex(text), paTable: DEFAULT_PA_TABLE });
+      },
+      end() {}
+    };
+  }
+
+  if (format === 'field-config') {
+    let section: string[] = [];
+    const flush = () => {
+      if (section.length === 0) return;
+      const { names, images } = parseFieldConfig(section.join('\n'));
+      section = [];
+      names.forEach((name, i) => {
+        count++;
+        onRecord({ name, ...unpackImage(images, i * IMAGE_SIZE) });
+      });
+    };
+    return {
+      line(text) {
+        if (text.trimStart().startsWith('[')) flush();
+        section.push(text);
+      },
+      end: flush
+    };
+  }
+
+  let pendingName: string | null = null;
+  return {
+    line(text) {
+      const trimmed = text.trim();
+      if (trimmed.startsWith('Custom_preset_name:')) {
+        pendingName = trimmed.slice('Custom_preset_name:'.length).trim();
+        return;
+      }
+      if (trimmed.startsWith('Custom_preset_data:') || /^[0-9a-f]{2}( [0-9a-f]{2})+$/i.test(trimmed)) {
+        const { registers, paTable } = parseFlipperPresetPairs(trimmed);
+        emit({ name: pendingName ?? nextName(), registers, paTable });
+        pendingName = null;
+      }
+    },
+    end() {}
+  };
+}
+
+/**
+ * Stream records from a readable
+ */
+export async function* readRecords(input: Readable, format: InputFormat): AsyncGenerator<PresetRecord> {
+  const pending: PresetRecord[] = [];
+  const reader = createRecordReader(format, record => pending.push(record));
+  const lines = createInterface({ input, crlfDelay: Infinity });
+
+  for await (const line of lines) {
+    reader.line(line);
+    while (pending.length > 0) yield pending.shift()!;
+  }
+  reader.end();
+  yield* pending;
+}
+
+/**
+ * Render one record; every format ends with a newline
+ */
+export function formatRecord(record: PresetRecord, format: OutputFormat): string {
+  if (format === 'raw-hex') {
+    return generateExport('raw_hex', record.name, record.registers, record.paTable) + '\n';
+  }
+  if (format === 'json') {
+    const image = packImage(record.registers, record.paTable);
+    return JSON.stringify({
+      name: record.name,
+      registers: Array.from(image.subarray(0, REGISTER_COUNT), b => toHex(b)).join(''),
+      paTable: Array.from(image.subarray(REGISTER_COUNT), b => toHex(b)).join('')
+    }) + '\n';
+  }
+
+  const text = generateExport(EXPORT_FORMATS[format]!, record.name, record.registers, record.paTable);
+  return text.endsWith('\n') ? `${text}\n` : `${text}\n\n`;
+}
+
+/**
+ * Human-readable summary of one record
+ */
+export function explainRecord(record: PresetRecord): string {
+  const image = packImage(record.registers, record.paTable);
+  const derived = deriveImage(image);
+  const modulation = MODULATION_FORMATS[derived.modulation]?.name ?? `reserved (${derived.modulation})`;
+
+  let output = `[${record.name}]\n`;
+  output += `  Frequency:  ${derived.frequency.toFixed(3)} MHz\n`;
+  output += `  Modulation: ${modulation}\n`;
+  output += `  Data rate:  ${derived.dataRate.toFixed(2)} kBaud\n`;
+  output += `  Bandwidth:  ${derived.bandwidth} kHz\n`;
+  if (derived.modulation !== 3) {
+    output += `  Deviation:  ${derived.deviation.toFixed(2)} kHz\n`;
+  }
+  const fields = formatFieldConfigImage(image);
+  if (fields.length > 0) {
+    output += `  Non-default settings:\n`;
+    output += fields.map(line => `    ${line}\n`).join('');
+  }
+  return output + '\n';
+}
+
+/**
+ * Write with backpressure so output memory stays bounded
+ */
+export async function writeOut(output: Writable, text: string): Promise<void> {
+  if (!output.write(text)) await once(output, 'drain');
+}
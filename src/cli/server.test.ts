@@ -0,0 +1,73 @@
+// @vitest-environment node
+import { describe, it, expect } from 'vitest';
+import { once } from 'node:events';
+import type { AddressInfo } from 'node:net';
+import { PRESETS } from '../data/registers';
+import { encodeImageBank } from '../utils/binary';
+import { generateFlipperSettingUser } from '../utils/export';
+import { createPresetServer, handleServiceRequest } from './server';
+
+const gfsk = PRESETS['GFSK 9.99kbps (433.92MHz)'];
+const SETTING_USER = new TextEncoder().encode(generateFlipperSettingUser('GFSK', gfsk.registers, gfsk.paTable));
+const decoder = new TextDecoder();
+
+function call(route: string, query = '', body = new Uint8Array()) {
+  const response = handleServiceRequest(route, new URLSearchParams(query), body);
+  return { ...response, text: decoder.decode(response.body) };
+}
+
+describe('Preset Service', () => {
+  it('converts, validates and explains request bodies', () => {
+    expect(call('/convert', 'to=raw-hex', SETTING_USER).text.split(' ')).toHaveLength(47);
+    expect(JSON.parse(call('/validate', '', SETTING_USER).text)).toEqual({ ok: true, presets: [{ name: 'GFSK', issues: [] }] });
+    expect(call('/explain', '', SETTING_USER).text).toContain('Modulation: GFSK');
+  });
+
+  it('solves targets from the query, optionally straight to an export format', () => {
+    const solved = JSON.parse(call('/solve', 'frequency=868.3&modulation=GFSK&dataRate=38.4').text);
+    expect(solved.derived.frequency).toBeCloseTo(868.3, 2);
+    expect(solved.derived.modulation).toBe(1);
+    expect(solved.registers).toHaveLength(47 * 2);
+
+    expect(call('/solve', 'frequency=433.92&to=flipper&name=x').text).toContain('Custom_preset_name: x');
+  });
+
+  it('exports every image in a binary bank', () => {
+    const bank = new Uint8Array(encodeImageBank([
+      { name: 'one', registers: gfsk.registers, paTable: gfsk.paTable },
+      { name: 'two', registers: gfsk.registers, paTable: gfsk.paTable },
+    ]));
+    const output = call('/export', 'to=flipper', bank).text;
+    expect(output).toContain('Custom_preset_name: one');
+    expect(output).toContain('Custom_preset_name: two');
+  });
+
+  it('reports bad input as 400 and unknown routes as 404', () => {
+    expect(call('/convert', 'to=nope', SETTING_USER).status).toBe(400);
+    expect(call('/solve', 'modulation=FM').status).toBe(400);
+    expect(call('/export', '', SETTING_USER).status).toBe(400);
+    expect(call('/missing').status).toBe(404);
+  });
+
+  it('serves repeated requests from the cache with ETags', async () => {
+    const server = createPresetServer();
+    server.listen(0, '127.0.0.1');
+    await once(server, 'listening');
+    const url = `http://127.0.0.1:${(server.address() as AddressInfo).port}/solve?modulation=GFSK&frequency=433.92`;
+
+    try {
+      const first = await fetch(url);
+      const second = await fetch(url.replace('modulation=GFSK&frequency=433.92', 'frequency=433.92&modulation=GFSK'));
+      expect(first.headers.get('x-cache')).toBe('miss');
+      expect(second.headers.get('x-cache')).toBe('hit');
+      expect(await second.text()).toBe(await first.text());
+
+      const etag = first.headers.get('etag')!;
+      const revalidated = await fetch(url, { headers: { 'If-None-Match': etag } });
+      expect(revalidated.status).toBe(304);
+    } finally {
+      server.close();
+      server.closeAllConnections();
+    }
+  });
+});
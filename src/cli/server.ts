@@ -0,0 +1,241 @@
+/**
+ * Local HTTP Preset Service
+ *
+ *   POST /convert?from=flipper&to=c-array   preset text -> export text
+ *   POST /validate?from=flipper             preset text -> JSON issues
+ *   POST /explain?from=flipper              preset text -> summary text
+ *   GET  /solve?frequency=433.92&modulation=GFSK&dataRate=9.99[&to=flipper]
+ *   POST /export?to=c-array                 binary image bank -> export text
+ *   GET  /health
+ *
+ * Every response is a pure function of route, sorted query and body, so
+ * responses are cached in an LRU keyed by their content hash and served
+ * with an ETag; a matching If-None-Match gets 304 without a body.
+ * Server-Timing reports the time spent past reading the body.
+ */
+
+import { createServer } from 'node:http';
+import type { IncomingMessage, Server, ServerResponse } from 'node:http';
+import { PRESETS } from '../data/registers';
+import { toHex } from '../utils/calculations';
+import { decodeImageBank } from '../utils/binary';
+import { deriveImage, parseModulation } from '../utils/derive';
+import { fingerprint64 } from '../utils/hash';
+import { IMAGE_SIZE, REGISTER_COUNT, packImage, unpackImage } from '../utils/image';
+import { forEachLine } from '../utils/lines';
+import { createLruCache } from '../utils/lru';
+import { SOLVE_KEYS, solveImage } from '../utils/solve';
+import type { SolveTargets } from '../utils/solve';
+import { validateImage } from '../utils/validate';
+import { INPUT_FORMATS, OUTPUT_FORMATS, createRecordReader, explainRecord, formatRecord } from './records';
+import type { InputFormat, OutputFormat, PresetRecord } from './records';
+
+export interface ServiceResponse {
+  status: number;
+  type: string;
+  body: Uint8Array;
+}
+
+export interface ServerOptions {
+  cacheBytes?: number;   // LRU budget for cached response bodies
+  maxBodyBytes?: number; // Larger requests get 413
+}
+
+interface CachedResponse extends ServiceResponse {
+  etag: string;
+}
+
+type Route = (query: URLSearchParams, body: Uint8Array) => ServiceResponse;
+
+const DEFAULT_CACHE_BYTES = 64 * 1024 * 1024;
+const DEFAULT_MAX_BODY_BYTES = 16 * 1024 * 1024;
+const ENTRY_OVERHEAD = 256;
+
+const encoder = new TextEncoder();
+const decoder = new TextDecoder();
+
+function text(body: string, type = 'text/plain; charset=utf-8'): ServiceResponse {
+  return { status: 200, type, body: encoder.encode(body) };
+}
+
+function json(value: unknown, status = 200): ServiceResponse {
+  return { status, type: 'application/json', body: encoder.encode(JSON.stringify(value)) };
+}
+
+function inputFormat(query: URLSearchParams): InputFormat {
+  const from = (query.get('from') ?? 'flipper') as InputFormat;
+  if (!INPUT_FORMATS.includes(from)) throw new Error(`Unknown input format: ${from}`);
+  return from;
+}
+
+function outputFormat(query: URLSearchParams, fallback: OutputFormat): OutputFormat {
+  const to = (query.get('to') ?? fallback) as OutputFormat;
+  if (!OUTPUT_FORMATS.includes(to)) throw new Error(`Unknown output format: ${to}`);
+  return to;
+}
+
+function readBodyRecords(query: URLSearchParams, body: Uint8Array): PresetRecord[] {
+  const records: PresetRecord[] = [];
+  const reader = createRecordReader(inputFormat(query), record => records.push(record));
+  forEachLine(decoder.decode(body), reader.line);
+  reader.end();
+  if (records.length === 0) throw new Error('No presets in request body');
+  return records;
+}
+
+function hex(bytes: Uint8Array): string {
+  return Array.from(bytes, b => toHex(b)).join('');
+}
+
+function solveTargets(query: URLSearchParams, body: Uint8Array): SolveTargets {
+  const params: Record<string, unknown> = Object.fromEntries(query);
+  if (body.length > 0) Object.assign(params, JSON.parse(decoder.decode(body)));
+
+  const targets: SolveTargets = {};
+  for (const key of SOLVE_KEYS) {
+    const raw = params[key];
+    if (raw === undefined) continue;
+    const value = key === 'modulation' ? parseModulation(String(raw)) : Number(raw);
+    if (value === null || !Number.isFinite(value)) throw new Error(`Invalid ${key}: ${raw}`);
+    targets[key] = value;
+  }
+  return targets;
+}
+
+const ROUTES = new Map<string, Route>([
+  ['/convert', (query, body) => {
+    const to = outputFormat(query, 'c-array');
+    const output = readBodyRecords(query, body).map(record => formatRecord(record, to)).join('');
+    return text(output, to === 'json' ? 'application/x-ndjson' : undefined);
+  }],
+  ['/validate', (query, body) => {
+    const presets = readBodyRecords(query, body).map(record => ({
+      name: record.name,
+      issues: validateImage(packImage(record.registers, record.paTable)).filter(issue => issue.severity !== 'info')
+    }));
+    const ok = presets.every(p => p.issues.every(issue => issue.severity !== 'error'));
+    return json({ ok, presets });
+  }],
+  ['/explain', (query, body) => text(readBodyRecords(query, body).map(explainRecord).join(''))],
+  ['/solve', (query, body) => {
+    const baseName = query.get('base');
+    const base = baseName === null ? undefined : PRESETS[baseName];
+    if (baseName !== null && !base) throw new Error(`Unknown preset: ${baseName}`);
+
+    const image = solveImage(solveTargets(query, body), base && packImage(base.registers, base.paTable));
+    if (query.has('to')) {
+      const record = { name: query.get('name') ?? 'solved', ...unpackImage(image) };
+      return text(formatRecord(record, outputFormat(query, 'flipper')));
+    }
+    return json({
+      registers: hex(image.subarray(0, REGISTER_COUNT)),
+      paTable: hex(image.subarray(REGISTER_COUNT)),
+      derived: deriveImage(image),
+      issues: validateImage(image).filter(issue => issue.severity !== 'info')
+    });
+  }],
+  ['/export', (query, body) => {
+    const to = outputFormat(query, 'c-array');
+    const bank = decodeImageBank(body);
+    let output = '';
+    for (let i = 0; i < bank.count; i++) {
+      const name = bank.name(i) || `preset_${i + 1}`;
+      output += formatRecord({ name, ...unpackImage(bank.images, i * IMAGE_SIZE) }, to);
+    }
+    return text(output);
+  }]
+]);
+
+/**
+ * Answer one request without caching. Handlers are pure functions of their
+ * input, so anything they throw is reported as a bad request.
+ */
+export function handleServiceRequest(route: string, query: URLSearchParams, body: Uint8Array): ServiceResponse {
+  if (route === '/health') return text('ok\n');
+  const handler = ROUTES.get(route);
+  if (!handler) return json({ error: `Unknown route ${route}` }, 404);
+  try {
+    return handler(query, body);
+  } catch (err) {
+    return json({ error: (err as Error).message }, 400);
+  }
+}
+
+// Resolves to null when the body is over `limit`; the rest is drained unread
+function readBody(req: IncomingMessage, limit: number): Promise<Uint8Array | null> {
+  return new Promise((resolve, reject) => {
+    const chunks: Buffer[] = [];
+    let length = 0;
+    req.on('data', (chunk: Buffer) => {
+      length += chunk.length;
+      if (length <= limit) chunks.push(chunk);
+    });
+    req.on('end', () => {
+      if (length > limit) resolve(null);
+      else resolve(chunks.length === 1 ? chunks[0] : Buffer.concat(chunks, length));
+    });
+    req.on('error', reject);
+  });
+}
+
+function send(res: ServerResponse, response: ServiceResponse, headers: Record<string, string> = {}): void {
+  res.writeHead(response.status, {
+    'Content-Type': response.type,
+    'Content-Length': response.body.length,
+    ...headers
+  });
+  res.end(response.body);
+}
+
+/**
+ * HTTP server for the preset service; call listen() on the result
+ */
+export function createPresetServer(options: ServerOptions = {}): Server {
+  const maxBodyBytes = options.maxBodyBytes ?? DEFAULT_MAX_BODY_BYTES;
+  const cache = createLruCache<CachedResponse>(
+    options.cacheBytes ?? DEFAULT_CACHE_BYTES,
+    response => response.body.length + ENTRY_OVERHEAD
+  );
+
+  return createServer(async (req, res) => {
+    try {
+      const body = await readBody(req, maxBodyBytes);
+      if (body === null) {
+        send(res, json({ error: `Request body over ${maxBodyBytes} bytes` }, 413));
+        return;
+      }
+
+      const started = performance.now();
+      const url = new URL(req.url ?? '/', 'http://localhost');
+      url.searchParams.sort();
+      const key = `${url.pathname}?${url.searchParams}#${fingerprint64(body)}`;
+
+      let cached = cache.get(key);
+      const hit = cached !== undefined;
+      if (!cached) {
+        const response = handleServiceRequest(url.pathname, url.searchParams, body);
+        if (response.status !== 200 || url.pathname === '/health') {
+          send(res, response);
+          return;
+        }
+        cached = { ...response, etag: `"${fingerprint64(encoder.encode(key))}"` };
+        cache.set(key, cached);
+      }
+
+      const headers = {
+        'ETag': cached.etag,
+        'Cache-Control': 'no-cache',
+        'X-Cache': hit ? 'hit' : 'miss',
+        'Server-Timing': `app;dur=${(performance.now() - started).toFixed(3)}`
+      };
+      if (req.headers['if-none-match'] === cached.etag) {
+        res.writeHead(304, headers);
+        res.end();
+        return;
+      }
+      send(res, cached, headers);
+    } catch (err) {
+      send(res, json({ error: (err as Error).message }, 500));
+    }
+  });
+}
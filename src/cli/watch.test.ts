@@ -0,0 +1,83 @@
+// @vitest-environment node
+import { describe, it, expect } from 'vitest';
+import { mkdtempSync, writeFileSync } from 'node:fs';
+import { tmpdir } from 'node:os';
+import { join } from 'node:path';
+import { PRESETS } from '../data/registers';
+import { generateFlipperSettingUser } from '../utils/export';
+import { createLintCache, watchPresetFiles } from './watch';
+
+const encoder = new TextEncoder();
+const fsk = PRESETS['FM 2-FSK (433.92MHz)'];
+const ook = PRESETS['AM 650kHz (433.92MHz)'];
+
+function settingUser(deviation: number): Uint8Array {
+  return encoder.encode([
+    generateFlipperSettingUser('FSK', { ...fsk.registers, 0x15: deviation }, fsk.paTable),
+    generateFlipperSettingUser('OOK', ook.registers, ook.paTable),
+  ].join('\n\n'));
+}
+
+describe('Lint Cache', () => {
+  it('skips files whose contents did not change', () => {
+    const cache = createLintCache();
+    expect(cache.update('setting_user', settingUser(0x47))?.presets).toHaveLength(2);
+    expect(cache.update('setting_user', settingUser(0x47))).toBeNull();
+    expect(cache.stats).toEqual({ files: 1, unchanged: 1, validated: 2, cached: 0 });
+  });
+
+  it('re-validates only the images an edit touched', () => {
+    const cache = createLintCache();
+    cache.update('setting_user', settingUser(0x47));
+    const result = cache.update('setting_user', settingUser(0x15));
+    expect(result?.presets.map(p => p.name)).toEqual(['FSK', 'OOK']);
+    expect(cache.stats.validated).toBe(3);
+    expect(cache.stats.cached).toBe(1);
+
+    // Identical presets in another file come from the image cache
+    cache.update('copy/setting_user', settingUser(0x15));
+    expect(cache.stats.validated).toBe(3);
+  });
+
+  it('forgets removed files', () => {
+    const cache = createLintCache();
+    cache.update('a.sub', settingUser(0x47));
+    expect(cache.remove('a.sub')).toBe(true);
+    expect(cache.remove('a.sub')).toBe(false);
+    expect(cache.files.size).toBe(0);
+  });
+
+  it('watches a file root and keeps going after a failed flush', async () => {
+    const file = join(mkdtempSync(join(tmpdir(), 'cc1101-watch-')), 'setting_user');
+    writeFileSync(file, settingUser(0x47));
+    const cache = createLintCache();
+    cache.update(file, settingUser(0x47));
+
+    const controller = new AbortController();
+    const errors: string[] = [];
+    const seen: number[] = [];
+    let next: () => void = () => {};
+    const edited = () => new Promise<void>(resolve => { next = resolve; });
+
+    const watching = watchPresetFiles([file], cache, (path, result) => {
+      expect(path).toBe(file);
+      seen.push(result!.presets.length);
+      next();
+      if (seen.length === 1) throw new Error('stdout closed');
+    }, controller.signal, error => errors.push(error.message));
+    await new Promise(resolve => setTimeout(resolve, 50)); // Let the watcher start
+
+    let wait = edited();
+    writeFileSync(file, settingUser(0x15));
+    await wait;
+    await new Promise(resolve => setTimeout(resolve, 20));
+    wait = edited();
+    writeFileSync(file, settingUser(0x20));
+    await wait;
+
+    controller.abort();
+    await watching;
+    expect(seen).toEqual([2, 2]);
+    expect(errors).toEqual(['stdout closed']);
+  });
+});
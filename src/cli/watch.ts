@@ -0,0 +1,145 @@
+/**
+ * Incremental Lint for Watch Mode
+ *
+ * Two content-addressed caches keep re-validation proportional to the edit:
+ *   - per file: the fingerprint64 of its bytes and its last result, so a
+ *     save that leaves the contents unchanged costs one read and one hash
+ *   - per image: validateImage results keyed by the fingerprint of the
+ *     55-byte image, so editing one preset in a 500-preset setting_user
+ *     re-validates one image
+ */
+
+import { watch } from 'node:fs';
+import { readFile, stat } from 'node:fs/promises';
+import { join } from 'node:path';
+import { fingerprint64 } from '../utils/hash';
+import { IMAGE_SIZE } from '../utils/image';
+import { validateImage } from '../utils/validate';
+import type { ImageIssue } from '../utils/validate';
+import { isLintCandidate, lintBytes } from './lint';
+import type { ImageValidator, LintFileResult } from './lint';
+
+// Image results kept before the cache is dropped and rebuilt
+const MAX_CACHED_IMAGES = 200_000;
+
+// Editors write a file in several steps; wait this long for them to settle
+const SETTLE_MS = 10;
+
+export interface LintCacheStats {
+  files: number;     // Files parsed
+  unchanged: number; // Reads skipped because the hash matched
+  validated: number; // Images run through validateImage
+  cached: number;    // Images answered from the cache
+}
+
+export interface LintCache {
+  files: Map<string, LintFileResult>;
+  stats: LintCacheStats;
+  // Seed from a result computed elsewhere (e.g. the worker pool)
+  add: (result: LintFileResult) => void;
+  // Re-lint if the contents changed; null when they did not
+  update: (file: string, bytes: Uint8Array) => LintFileResult | null;
+  remove: (file: string) => boolean;
+}
+
+export function createLintCache(): LintCache {
+  const files = new Map<string, LintFileResult>();
+  const images = new Map<string, ImageIssue[]>();
+  const stats: LintCacheStats = { files: 0, unchanged: 0, validated: 0, cached: 0 };
+
+  const validate: ImageValidator = (image, offset = 0) => {
+    const key = fingerprint64(image, offset, offset + IMAGE_SIZE);
+    const hit = images.get(key);
+    if (hit) {
+      stats.cached++;
+      return hit;
+    }
+    stats.validated++;
+    if (images.size >= MAX_CACHED_IMAGES) images.clear();
+    const issues = validateImage(image, offset);
+    images.set(key, issues);
+    return issues;
+  };
+
+  return {
+    files,
+    stats,
+    add(result) {
+      files.set(result.file, result);
+    },
+    update(file, bytes) {
+      const previous = files.get(file);
+      if (previous?.hash !== undefined && previous.hash === fingerprint64(bytes)) {
+        stats.unchanged++;
+        return null;
+      }
+      stats.files++;
+      const result = lintBytes(file, bytes, validate);
+      files.set(file, result);
+      return result;
+    },
+    remove(file) {
+      return files.delete(file);
+    }
+  };
+}
+
+/**
+ * Watch each root (a directory, recursively, or a single file) and re-lint
+ * changed candidate files. `onResult` gets the new result, or null when a
+ * file was removed. A failed flush goes to `onError` and watching goes on.
+ * Resolves once `signal` aborts.
+ */
+export async function watchPresetFiles(
+  roots: string[],
+  cache: LintCache,
+  onResult: (file: string, result: LintFileResult | null, ms: number) => Promise<void> | void,
+  signal: AbortSignal,
+  onError: (error: Error) => void
+): Promise<void> {
+  const directories = await Promise.all(roots.map(async root => (await stat(root)).isDirectory()));
+  const pending = new Set<string>();
+  let timer: ReturnType<typeof setTimeout> | null = null;
+  let flushing: Promise<void> = Promise.resolve();
+
+  const flush = async () => {
+    const paths = [...pending];
+    pending.clear();
+    for (const path of paths) {
+      const started = performance.now();
+      let bytes: Uint8Array;
+      try {
+        bytes = await readFile(path);
+      } catch {
+        // Deleted or renamed away
+        if (cache.remove(path)) await onResult(path, null, performance.now() - started);
+        continue;
+      }
+      const result = cache.update(path, bytes);
+      if (result) await onResult(path, result, performance.now() - started);
+    }
+  };
+
+  const watchers = roots.map((root, i) => watch(root, { recursive: directories[i], signal }, (_event, name) => {
+    if (name === null) return;
+    // A file root reports its own base name; its path is the root itself
+    const path = directories[i] ? join(root, name.toString()) : root;
+    if (directories[i] && !isLintCandidate(path)) return; // File roots are linted as given
+    pending.add(path);
+    if (timer !== null) clearTimeout(timer);
+    timer = setTimeout(() => {
+      timer = null;
+      flushing = flushing.then(flush).catch(error => onError(error as Error));
+    }, SETTLE_MS);
+  }));
+
+  return new Promise(resolve => {
+    const stop = () => {
+      if (timer !== null) clearTimeout(timer);
+      watchers.forEach(watcher => watcher.close());
+      flushing.then(() => resolve());
+    };
+    if (signal.aborted) stop();
+    else signal.addEventListener('abort', stop, { once: true });
+  });
+}
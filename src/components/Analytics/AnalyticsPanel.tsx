@@ -0,0 +1,154 @@
+/**
+ * AnalyticsPanel Component - Distributions, validation failures and duplicates across a preset library
+ */
+
+import { useCallback } from 'react';
+import { useLibraryStats } from '../../hooks/useLibraryStats';
+import type { Histogram } from '../../utils/analytics';
+import './AnalyticsPanel.css';
+
+interface AnalyticsPanelProps {
+  onClose: () => void;
+  showToast: (message: string, type?: 'success' | 'error') => void;
+}
+
+interface HistogramChartProps {
+  title: string;
+  unit?: string;
+  histogram: Histogram;
+}
+
+function HistogramChart({ title, unit, histogram }: HistogramChartProps) {
+  const max = Math.max(1, ...histogram.counts);
+  const bins = histogram.labels
+    .map((label, i) => ({ label, count: histogram.counts[i] }))
+    .filter(bin => bin.count > 0);
+
+  return (
+    <div className="analytics-chart">
+      <h3>{title}{unit && <span className="analytics-unit"> ({unit})</span>}</h3>
+      {bins.length === 0 ? (
+        <div className="analytics-empty">No presets</div>
+      ) : (
+        bins.map(bin => (
+          <div key={bin.label} className="analytics-bar-row">
+            <span className="analytics-bar-label">{bin.label}</span>
+            <span className="analytics-bar-track">
+              <span className="analytics-bar" style={{ width: `${(bin.count / max) * 100}%` }} />
+            </span>
+            <span className="analytics-bar-count">{bin.count}</span>
+          </div>
+        ))
+      )}
+    </div>
+  );
+}
+
+export function AnalyticsPanel({ onClose, showToast }: AnalyticsPanelProps) {
+  const library = useLibraryStats(message => showToast(message, 'error'));
+  const { stats, analyze } = library;
+
+  const handleFiles = useCallback((e: React.ChangeEvent<HTMLInputElement>) => {
+    const files = Array.from(e.target.files ?? []);
+    e.target.value = '';
+    analyze(files);
+  }, [analyze]);
+
+  return (
+    <>
+      <div className="patch-overlay" onClick={onClose} />
+      <div className="patch-panel analytics-panel" role="dialog" aria-label="Library Analytics">
+        <div className="panel-header">
+          <h2>Library Analytics</h2>
+          <button className="close-button" onClick={onClose} aria-label="Close">×</button>
+        </div>
+
+        <div className="patch-actions">
+          <label className="btn btn-primary">
+            Load Library Files
+            {/* No accept filter: setting_user has no extension; the reader detects formats by content */}
+            <input type="file" multiple onChange={handleFiles} hidden />
+          </label>
+          {library.loading && (
+            <button className="btn btn-secondary" onClick={library.cancel}>
+              Stop
+            </button>
+          )}
+        </div>
+
+        {stats && (
+          <div className="analytics-summary">
+            <span>{stats.presets} presets</span>
+            <span>{library.files} files</span>
+            <span>{stats.presetsWithErrors} with errors</span>
+            <span>{stats.presetsWithWarnings} with warnings</span>
+            <span>{stats.duplicatePresets} duplicates</span>
+            {library.loading ? (
+              <span>Parsing… {Math.round(library.progress * 100)}%</span>
+            ) : library.elapsedMs !== null && (
+              <span>{Math.round(library.elapsedMs)} ms</span>
+            )}
+          </div>
+        )}
+
+        {library.fileErrors.length > 0 && (
+          <ul className="analytics-file-errors">
+            {library.fileErrors.map(error => <li key={error}>{error}</li>)}
+          </ul>
+        )}
+
+        {stats && (
+          <>
+            <div className="analytics-grid">
+              <HistogramChart title="Frequency" unit="MHz" histogram={stats.frequency} />
+              <HistogramChart title="Modulation" histogram={stats.modulation} />
+              <HistogramChart title="Bandwidth" unit="kHz" histogram={stats.bandwidth} />
+              <HistogramChart title="Data Rate" unit="kBaud" histogram={stats.dataRate} />
+              <HistogramChart title="PA Power" histogram={stats.paPower} />
+            </div>
+
+            <div className="analytics-chart">
+              <h3>Validation Failures</h3>
+              {stats.failures.length === 0 ? (
+                <div className="analytics-empty">None</div>
+              ) : (
+                <table className="analytics-table">
+                  <tbody>
+                    {stats.failures.map(failure => (
+                      <tr key={failure.code}>
+                        <td className={`analytics-severity ${failure.severity}`}>{failure.severity}</td>
+                        <td>{failure.code}</td>
+                        <td className="analytics-bar-count">{failure.count}</td>
+                      </tr>
+                    ))}
+                  </tbody>
+                </table>
+              )}
+            </div>
+
+            <div className="analytics-chart">
+              <h3>Duplicate Clusters</h3>
+              {stats.duplicates.length === 0 ? (
+                <div className="analytics-empty">None</div>
+              ) : (
+                <table className="analytics-table">
+                  <tbody>
+                    {stats.duplicates.map(cluster => (
+                      <tr key={cluster.fingerprint}>
+                        <td className="analytics-bar-count">{cluster.count}×</td>
+                        <td>
+                          {cluster.names.join(', ')}
+                          {cluster.count > cluster.names.length && ', …'}
+                        </td>
+                      </tr>
+                    ))}
+                  </tbody>
+                </table>
+              )}
+            </div>
+          </>
+        )}
+      </div>
+    </>
+  );
+}
@@ -0,0 +1 @@
+export { AnalyticsPanel } from './AnalyticsPanel';
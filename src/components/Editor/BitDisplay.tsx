@@ -2,13 +2,13 @@
  * BitDisplay Component - Interactive bit visualization
  */
 
-import type { Register } from '../../types/cc1101';
+import type { RegisterLayout } from '../../types/cc1101';
 import { getValidBits, getFieldNameForBit } from '../../utils/calculations';
 import './BitDisplay.css';
 
 interface BitDisplayProps {
   value: number;
-  register: Register;
+  register: RegisterLayout;
   onToggleBit: (bit: number) => void;
 }
 
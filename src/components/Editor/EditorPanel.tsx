@@ -2,7 +2,8 @@
  * EditorPanel Component - Main register editing area
  */
 
-import { CC1101_REGISTERS, REGISTER_GROUPS } from '../../data/registers';
+import { REGISTER_GROUPS } from '../../data/registers';
+import { REGISTER_LAYOUT } from '../../data/registerLayout';
 import { RegisterCard } from './RegisterCard';
 import { SpectrumVisualizer } from './SpectrumVisualizer';
 import { PATableEditor } from './PATableEditor';
@@ -75,7 +76,7 @@ export function EditorPanel({
       ) : (
         <div className="register-list">
           {addresses.map(addr => {
-            const reg = CC1101_REGISTERS[addr];
+            const reg = REGISTER_LAYOUT[addr];
             if (!reg) return null;
 
             return (
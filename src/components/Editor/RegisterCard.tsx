@@ -3,14 +3,15 @@
  */
 
 import { useState, useCallback } from 'react';
-import type { Register } from '../../types/cc1101';
+import type { RegisterLayout } from '../../types/cc1101';
 import { BitDisplay } from './BitDisplay';
 import { extractFieldValue, toHex } from '../../utils/calculations';
+import { useFieldDescriptions } from '../../hooks/useFieldDescriptions';
 import './RegisterCard.css';
 
 interface RegisterCardProps {
   address: number;
-  register: Register;
+  register: RegisterLayout;
   value: number;
   onValueChange: (value: number) => void;
   onBitToggle: (bit: number) => void;
@@ -25,6 +26,8 @@ export function RegisterCard({
 }: RegisterCardProps) {
   const [expanded, setExpanded] = useState(false);
   const [inputValue, setInputValue] = useState(`0x${toHex(value)}`);
+  // Only shown expanded, so collapsed cards never load the descriptions
+  const fieldDescriptions = useFieldDescriptions(expanded ? address : null);
 
   const handleInputChange = useCallback((e: React.ChangeEvent<HTMLInputElement>) => {
     setInputValue(e.target.value);
@@ -96,7 +99,7 @@ export function RegisterCard({
               return (
                 <div key={idx} className="field-item">
                   <span className="field-name">{field.name}</span>
-                  <span className="field-desc">{field.description}</span>
+                  <span className="field-desc">{fieldDescriptions?.[idx]}</span>
                   <span className="field-bits">
                     [{field.bits.join(':')}] = {fieldValue}
                     {field.options && field.options[fieldValue] && (
@@ -2,9 +2,21 @@
  * ExportPanel Component - Export and import functionality
  */
 
-import { useState, useCallback, useEffect } from 'react';
+import { useState, useCallback, useEffect, useMemo } from 'react';
 import type { ExportFormat } from '../../types/cc1101';
-import { generateExport, parseFlipperPresetData, parseRawHex } from '../../utils/export';
+import {
+  generateExport,
+  generateFlipperSettingUserBatch,
+  formatFlipperSettingUser,
+  joinFlipperTokens,
+  parseFlipperPresetData,
+  parseRawHex
+} from '../../utils/export';
+import { downloadFile } from '../../utils/download';
+import { isFieldConfig, parseFieldConfigPreset } from '../../utils/fieldConfig';
+import { isSmartRfListing, parseSmartRfListing, readSmartRfFiles } from '../../utils/smartrf';
+import { useFlipperTokens } from '../../hooks/useFlipperTokens';
+import { useSubFileImport } from '../../hooks/useSubFileImport';
 import { HighlightedFlipperPreview } from './HighlightedFlipperPreview';
 import { CopyIcon, ImportIcon, ExportIcon } from './icons';
 import './ExportPanel.css';
@@ -33,7 +45,13 @@ export function ExportPanel({ registers, paTable, onImport, showToast }: ExportP
   }, []);
 
 
-  const exportContent = generateExport(format, presetName, registers, paTable);
+  const flipperTokens = useFlipperTokens(registers, paTable);
+
+  const exportContent = useMemo(() => (
+    format === 'flipper_setting'
+      ? formatFlipperSettingUser(presetName, joinFlipperTokens(flipperTokens))
+      : generateExport(format, presetName, registers, paTable)
+  ), [format, presetName, registers, paTable, flipperTokens]);
 
   const handleCopy = useCallback(async () => {
     try {
@@ -58,7 +76,13 @@ export function ExportPanel({ registers, paTable, onImport, showToast }: ExportP
     }
 
     try {
-      if (importData.includes('00 00') || importData.includes('Custom_preset_data')) {
+      if (isSmartRfListing(importData)) {
+        const { registers: newRegs, paTable: newPa } = parseSmartRfListing(importData);
+        onImport(newRegs, newPa.length > 0 ? newPa : undefined);
+      } else if (isFieldConfig(importData)) {
+        const { registers: newRegs, paTable: newPa } = parseFieldConfigPreset(importData);
+        onImport(newRegs, newPa);
+      } else if (importData.includes('00 00') || importData.includes('Custom_preset_data')) {
         const { registers: newRegs, paTable: newPa } = parseFlipperPresetData(importData);
         onImport(newRegs, newPa.length > 0 ? newPa : undefined);
       } else {
@@ -72,6 +96,39 @@ export function ExportPanel({ registers, paTable, onImport, showToast }: ExportP
     }
   }, [importData, onImport, showToast]);
 
+  const subImport = useSubFileImport({
+    onPreset: (preset) => {
+      onImport(preset.registers, preset.paTable.length > 0 ? preset.paTable : undefined);
+      showToast(`Loaded ${preset.name}`);
+    },
+    onError: (message) => showToast(message, 'error')
+  });
+
+  const handleSubFile = useCallback((e: React.ChangeEvent<HTMLInputElement>) => {
+    const file = e.target.files?.[0];
+    if (file) subImport.importFile(file);
+    e.target.value = '';
+  }, [subImport.importFile]);
+
+  const handleSmartRfBatch = useCallback(async (e: React.ChangeEvent<HTMLInputElement>) => {
+    const files = Array.from(e.target.files ?? []);
+    e.target.value = '';
+    if (files.length === 0) return;
+
+    try {
+      const listings = await readSmartRfFiles(files);
+      const presets = listings.map(l => ({
+        name: l.name,
+        registers: l.registers,
+        paTable: l.paTable.length > 0 ? l.paTable : paTable
+      }));
+      downloadFile(generateFlipperSettingUserBatch(presets), 'setting_user');
+      showToast(`Converted ${listings.length} listings`);
+    } catch {
+      showToast('Batch conversion failed', 'error');
+    }
+  }, [paTable, showToast]);
+
   const panelContent = (
     <>
       <div className="panel-header">
@@ -98,6 +155,10 @@ export function ExportPanel({ registers, paTable, onImport, showToast }: ExportP
           <option value="flipper_setting">Flipper setting_user</option>
           <option value="c_array">C Array</option>
           <option value="raw_hex">Raw Hex</option>
+          <option value="wake_restore">C Wakeup Restore</option>
+          <option value="smartrf_listing">SmartRF Listing</option>
+          <option value="smartrf_header">SmartRF Header</option>
+          <option value="field_config">Field Config</option>
         </select>
       </div>
 
@@ -123,8 +184,7 @@ export function ExportPanel({ registers, paTable, onImport, showToast }: ExportP
         </div>
         {format === 'flipper_setting' ? (
           <HighlightedFlipperPreview
-            registers={registers}
-            paTable={paTable}
+            tokens={flipperTokens}
             presetName={presetName}
           />
         ) : (
@@ -143,7 +203,7 @@ export function ExportPanel({ registers, paTable, onImport, showToast }: ExportP
           <textarea
             id="importData"
             className="textarea-input"
-            placeholder="Paste Custom_preset_data or raw hex values..."
+            placeholder="Paste Custom_preset_data, a field config, a SmartRF listing or raw hex values..."
             value={importData}
             onChange={(e) => setImportData(e.target.value)}
           />
@@ -152,6 +212,35 @@ export function ExportPanel({ registers, paTable, onImport, showToast }: ExportP
           <ImportIcon />
           Import
         </button>
+        <div className="control-group sub-import">
+          <label htmlFor="subFile">Import .sub Capture</label>
+          <input
+            type="file"
+            id="subFile"
+            className="file-input"
+            accept=".sub"
+            onChange={handleSubFile}
+          />
+          {subImport.fileName && (
+            <div className="sub-import-status">
+              {subImport.loading
+                ? `Reading ${subImport.fileName}... ${Math.round(subImport.progress * 100)}%`
+                : `${subImport.fileName}: ${subImport.pulses?.length.toLocaleString() ?? 0} RAW pulses`}
+              {subImport.protocol && ` (${subImport.protocol})`}
+            </div>
+          )}
+        </div>
+        <div className="control-group sub-import">
+          <label htmlFor="smartRfBatch">Batch Convert SmartRF Listings</label>
+          <input
+            type="file"
+            id="smartRfBatch"
+            className="file-input"
+            accept=".txt,.h"
+            multiple
+            onChange={handleSmartRfBatch}
+          />
+        </div>
       </div>
     </>
   );
@@ -3,38 +3,30 @@
  * Displays Flipper preset data with syntax highlighting
  */
 
-import { CC1101_REGISTERS } from '../../data/registers';
-import { toHex } from '../../utils/calculations';
+import { memo } from 'react';
+import type { FlipperToken } from '../../utils/export';
 
 interface HighlightedFlipperPreviewProps {
-  registers: Record<number, number>;
-  paTable: number[];
+  tokens: FlipperToken[];
   presetName: string;
 }
 
-export function HighlightedFlipperPreview({ registers, paTable, presetName }: HighlightedFlipperPreviewProps) {
-  // Check sync mode from MDMCFG2 to determine if SYNC words should be included
-  const mdmcfg2 = registers[0x12] ?? 0x13; // Default value
-  const syncMode = mdmcfg2 & 0x03; // Bits 1:0
-  const isSyncEnabled = syncMode !== 0;
+const TOKEN_CLASSES: Record<FlipperToken['kind'], string> = {
+  register: 'hex-register',
+  terminator: 'hex-terminator',
+  pa: 'hex-pa-table'
+};
 
-  // Build register pairs (only those meant for Flipper export)
-  const registerPairs: Array<{ addr: number; value: number }> = [];
-  for (let addr = 0; addr <= 0x2E; addr++) {
-    const value = registers[addr];
-    const regDef = CC1101_REGISTERS[addr];
-    
-    // Skip SYNC1/SYNC0 if sync mode is disabled
-    if ((addr === 0x04 || addr === 0x05) && !isSyncEnabled) {
-      continue;
-    }
-    
-    // Only include if explicitly marked for Flipper export
-    if (value !== undefined && regDef?.flipperExport === true) {
-      registerPairs.push({ addr, value });
-    }
-  }
+// Tokens keep their identity across renders unless their byte changed
+const TokenSpan = memo(function TokenSpan({ token, separator }: { token: FlipperToken; separator: string }) {
+  return (
+    <span className={TOKEN_CLASSES[token.kind]}>
+      {token.text}{separator}
+    </span>
+  );
+});
 
+export function HighlightedFlipperPreview({ tokens, presetName }: HighlightedFlipperPreviewProps) {
   return (
     <div className="highlighted-preview">
       <div className="preview-legend">
@@ -58,16 +50,8 @@ export function HighlightedFlipperPreview({ registers, paTable, presetName }: Hi
           <span className="preset-header">Custom_preset_module: CC1101</span>
           {'\n'}
           <span className="preset-header">Custom_preset_data: </span>
-          {registerPairs.map((pair, i) => (
-            <span key={`reg-${pair.addr}`} className="hex-register">
-              {toHex(pair.addr)} {toHex(pair.value)}{i < registerPairs.length - 1 ? ' ' : ''}
-            </span>
-          ))}
-          <span className="hex-terminator"> 00 00 </span>
-          {paTable.map((byte, i) => (
-            <span key={`pa-${i}`} className="hex-pa-table">
-              {toHex(byte)}{i < paTable.length - 1 ? ' ' : ''}
-            </span>
+          {tokens.map((token, i) => (
+            <TokenSpan key={token.key} token={token} separator={i < tokens.length - 1 ? ' ' : ''} />
           ))}
         </code>
       </pre>
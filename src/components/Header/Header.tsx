@@ -6,9 +6,11 @@ import './Header.css';
 
 interface HeaderProps {
   onReset: () => void;
+  onPatch: () => void;
+  onAnalytics: () => void;
 }
 
-export function Header({ onReset }: HeaderProps) {
+export function Header({ onReset, onPatch, onAnalytics }: HeaderProps) {
   return (
     <header className="header">
       <div className="header-left">
@@ -20,6 +22,12 @@ export function Header({ onReset }: HeaderProps) {
         </div>
       </div>
       <div className="header-right">
+        <button className="btn btn-secondary" onClick={onPatch}>
+          Patch
+        </button>
+        <button className="btn btn-secondary" onClick={onAnalytics}>
+          Analytics
+        </button>
         <button className="btn btn-secondary" onClick={onReset}>
           <svg width="16" height="16" viewBox="0 0 16 16" fill="currentColor">
             <path d="M8 3a5 5 0 1 0 4.546 2.914.5.5 0 0 1 .908-.417A6 6 0 1 1 8 2v1z"/>
@@ -0,0 +1,106 @@
+/**
+ * PatchPanel Component - Apply bulk field patches to the current preset or a library file
+ */
+
+import { useState, useCallback } from 'react';
+import { applyPatch, compilePatch, generatePatchReport } from '../../utils/patch';
+import { generateFieldConfigFile, parseFieldConfig } from '../../utils/fieldConfig';
+import { decodeImageBank, encodePackedBank } from '../../utils/binary';
+import { packImage, unpackImage } from '../../utils/image';
+import { downloadFile } from '../../utils/download';
+import './PatchPanel.css';
+
+interface PatchPanelProps {
+  registers: Record<number, number>;
+  paTable: number[];
+  onApply: (registers: Record<number, number>, paTable: number[]) => void;
+  onClose: () => void;
+  showToast: (message: string, type?: 'success' | 'error') => void;
+}
+
+const PLACEHOLDER = `when frequency >= 433 and frequency <= 435
+  FIFOTHR.FIFO_THR = 10`;
+
+export function PatchPanel({ registers, paTable, onApply, onClose, showToast }: PatchPanelProps) {
+  const [patchText, setPatchText] = useState('');
+  const [report, setReport] = useState('');
+
+  const handleApplyCurrent = useCallback(() => {
+    try {
+      const patch = compilePatch(patchText);
+      const result = applyPatch(patch, packImage(registers, paTable), ['Current']);
+      const patched = unpackImage(result.images);
+      onApply(patched.registers, patched.paTable);
+      setReport(generatePatchReport(result.report));
+    } catch (err) {
+      showToast((err as Error).message, 'error');
+    }
+  }, [patchText, registers, paTable, onApply, showToast]);
+
+  const handleLibraryFile = useCallback(async (e: React.ChangeEvent<HTMLInputElement>) => {
+    const file = e.target.files?.[0];
+    e.target.value = '';
+    if (!file) return;
+
+    try {
+      const patch = compilePatch(patchText);
+      if (file.name.endsWith('.bin')) {
+        const bank = decodeImageBank(await file.arrayBuffer());
+        const names = Array.from({ length: bank.count }, (_, i) => bank.name(i));
+        const result = applyPatch(patch, bank.images, names);
+        downloadFile(
+          encodePackedBank(result.images, names, { compress: bank.compressed, columnar: bank.columnar, xoscFreq: bank.xoscFreq }),
+          file.name,
+          'application/octet-stream'
+        );
+        setReport(generatePatchReport(result.report));
+      } else {
+        const library = parseFieldConfig(await file.text());
+        const result = applyPatch(patch, library.images, library.names, { inPlace: true });
+        downloadFile(generateFieldConfigFile(library), file.name);
+        setReport(generatePatchReport(result.report));
+      }
+    } catch (err) {
+      showToast((err as Error).message, 'error');
+    }
+  }, [patchText, showToast]);
+
+  return (
+    <>
+      <div className="patch-overlay" onClick={onClose} />
+      <div className="patch-panel" role="dialog" aria-label="Bulk Patch">
+        <div className="panel-header">
+          <h2>Bulk Patch</h2>
+          <button className="close-button" onClick={onClose} aria-label="Close">×</button>
+        </div>
+
+        <div className="control-group">
+          <label htmlFor="patchText">Patch</label>
+          <textarea
+            id="patchText"
+            className="textarea-input patch-input"
+            placeholder={PLACEHOLDER}
+            value={patchText}
+            onChange={(e) => setPatchText(e.target.value)}
+          />
+        </div>
+
+        <div className="patch-actions">
+          <button className="btn btn-primary" onClick={handleApplyCurrent}>
+            Apply to Current
+          </button>
+          <label className="btn btn-secondary">
+            Apply to Library File
+            <input type="file" accept=".txt,.cfg,.bin" onChange={handleLibraryFile} hidden />
+          </label>
+        </div>
+
+        {report && (
+          <pre className="code-preview patch-report">
+            <code>{report}</code>
+          </pre>
+        )}
+      </div>
+    </>
+  );
+}
@@ -0,0 +1 @@
+export { PatchPanel } from './PatchPanel';
@@ -2,19 +2,29 @@
  * Sidebar Component - Quick config and register navigation
  */
 
-import { useMemo } from 'react';
-import { REGISTER_GROUPS, PRESETS } from '../../data/registers';
+import { useEffect, useMemo, useState } from 'react';
+import { REGISTER_GROUPS } from '../../data/registers';
+import { loadPresetCatalog } from '../../data/presetCatalog';
+import type { PresetMap } from '../../types/cc1101';
 import type { DerivedValues, RegisterActions } from '../../hooks/useRegisters';
 import { frequencyToRegisters, toHex } from '../../utils/calculations';
+import { packImage, packPresetMap } from '../../utils/image';
+import { buildNearestPresetIndex, nearestPresets } from '../../utils/nearestPreset';
+import { buildPresetIndex, parseRange, queryPresetIndex } from '../../utils/presetIndex';
+import type { PresetQuery } from '../../utils/presetIndex';
 import './Sidebar.css';
 
 interface SidebarProps {
   currentGroup: string;
   onGroupChange: (group: string) => void;
+  registers: Record<number, number>;
   derived: DerivedValues;
   actions: RegisterActions;
 }
 
+const SUGGESTED_PRESETS = 3;
+const LISTED_CHANGES = 3;
+
 const BANDWIDTH_OPTIONS = [58, 68, 81, 102, 116, 135, 162, 203, 232, 270, 325, 406, 464, 541, 650, 812];
 
 // Check if keyfob presets should be shown
@@ -24,20 +34,48 @@ function areKeyFobsUnlocked(): boolean {
   return params.get('keyfobs') === 'unlocked';
 }
 
-export function Sidebar({ currentGroup, onGroupChange, derived, actions }: SidebarProps) {
+export function Sidebar({ currentGroup, onGroupChange, registers, derived, actions }: SidebarProps) {
   const freqRegs = frequencyToRegisters(derived.frequency);
   const freqHint = `FREQ: 0x${toHex(freqRegs.FREQ2)}${toHex(freqRegs.FREQ1)}${toHex(freqRegs.FREQ0)}`;
 
-  // Filter presets - hide keyfob presets unless query string unlocks them
-  const visiblePresets = useMemo(() => {
-    const keyfobsUnlocked = areKeyFobsUnlocked();
-    return Object.keys(PRESETS).filter(name => {
-      if (name.toLowerCase().startsWith('keyfob')) {
-        return keyfobsUnlocked;
-      }
-      return true;
-    });
+  const [frequencyFilter, setFrequencyFilter] = useState('');
+  const [modulationFilter, setModulationFilter] = useState('');
+
+  // Keyfob presets are a separate chunk, only fetched when the query string unlocks them
+  const [visiblePresetMap, setVisiblePresetMap] = useState<PresetMap>({});
+  const [catalogLoading, setCatalogLoading] = useState(true);
+  const [catalogFailed, setCatalogFailed] = useState(false);
+  useEffect(() => {
+    let active = true;
+    loadPresetCatalog(areKeyFobsUnlocked() ? ['standard', 'keyfob'] : ['standard'])
+      .then(
+        presets => { if (active) setVisiblePresetMap(presets); },
+        () => { if (active) setCatalogFailed(true); }
+      )
+      .finally(() => { if (active) setCatalogLoading(false); });
+    return () => { active = false; };
   }, []);
+  const packedPresets = useMemo(() => packPresetMap(visiblePresetMap), [visiblePresetMap]);
+  const presetIndex = useMemo(() => buildPresetIndex(packedPresets.images, packedPresets.names), [packedPresets]);
+  const nearestIndex = useMemo(
+    () => buildNearestPresetIndex(packedPresets.images, packedPresets.names),
+    [packedPresets]
+  );
+
+  // Closest known presets to the current registers, recomputed on every edit
+  const suggestions = useMemo(
+    () => nearestPresets(nearestIndex, packImage(registers, []), SUGGESTED_PRESETS),
+    [nearestIndex, registers]
+  );
+
+  // Band overlap (MHz, single value or range) and modulation filters
+  const visiblePresets = useMemo(() => {
+    const query: PresetQuery = {};
+    const range = parseRange(frequencyFilter);
+    if (range) query.frequency = range;
+    if (modulationFilter !== '') query.modulation = parseInt(modulationFilter);
+    return queryPresetIndex(presetIndex, query).map(id => presetIndex.names[id]);
+  }, [presetIndex, frequencyFilter, modulationFilter]);
 
   const handlePresetChange = (e: React.ChangeEvent<HTMLSelectElement>) => {
     const preset = e.target.value;
@@ -54,14 +92,73 @@ export function Sidebar({ currentGroup, onGroupChange, derived, actions }: Sideb
         {/* Preset Selector */}
         <div className="control-group">
           <label htmlFor="presetSelect">Load Preset</label>
+          <div className="preset-filters">
+            <input
+              type="text"
+              id="presetFrequencyFilter"
+              className="text-input"
+              placeholder="MHz, e.g. 433.8-434.1"
+              aria-label="Filter presets by frequency"
+              value={frequencyFilter}
+              onChange={(e) => setFrequencyFilter(e.target.value)}
+            />
+            <select
+              id="presetModulationFilter"
+              className="select-input"
+              aria-label="Filter presets by modulation"
+              value={modulationFilter}
+              onChange={(e) => setModulationFilter(e.target.value)}
+            >
+              <option value="">Any</option>
+              <option value="0">2-FSK</option>
+              <option value="1">GFSK</option>
+              <option value="3">ASK/OOK</option>
+              <option value="4">4-FSK</option>
+              <option value="7">MSK</option>
+            </select>
+          </div>
           <select id="presetSelect" className="select-input" onChange={handlePresetChange} defaultValue="">
-            <option value="">-- Select Preset --</option>
+            <option value="">
+              {visiblePresets.length > 0
+                ? '-- Select Preset --'
+                : catalogLoading
+                  ? '-- Loading presets --'
+                  : catalogFailed ? '-- Presets failed to load --' : '-- No matching presets --'}
+            </option>
             {visiblePresets.map(name => (
               <option key={name} value={name}>{name}</option>
             ))}
           </select>
         </div>
 
+        {/* Closest known presets */}
+        {suggestions.length > 0 && (
+          <div className="control-group preset-suggestion">
+            <label>Closest Preset</label>
+            {suggestions.map((match, i) => (
+              <button
+                key={match.name}
+                className={`preset-suggestion-item ${i === 0 ? 'best' : ''}`}
+                title={match.changes.map(c => `${c.register}.${c.field ?? 'reserved'}: ${c.from} -> ${c.to}`).join('\n')}
+                onClick={() => actions.loadPreset(match.name)}
+              >
+                <span className="preset-suggestion-name">{match.name}</span>
+                <span className="input-hint">
+                  {match.changes.length === 0
+                    ? 'exact match'
+                    : `${match.changes.length} field${match.changes.length === 1 ? '' : 's'} differ`}
+                </span>
+              </button>
+            ))}
+            {suggestions[0].changes.length > 0 && (
+              <span className="preset-suggestion-changes">
+                {suggestions[0].changes.slice(0, LISTED_CHANGES).map(c => `${c.register}.${c.field ?? 'reserved'}`).join(', ')}
+                {suggestions[0].changes.length > LISTED_CHANGES && ` +${suggestions[0].changes.length - LISTED_CHANGES} more`}
+              </span>
+            )}
+          </div>
+        )}
+
         {/* Frequency */}
         <div className="control-group">
           <label htmlFor="frequencyInput">Frequency (MHz)</label>
@@ -0,0 +1,116 @@
+/**
+ * Register Table Compiler
+ *
+ * Turns the register definitions and presets into generated modules:
+ *
+ *   registerTable.ts  names, defaults, flags, field bits and option labels,
+ *                     as one JSON string; read at startup
+ *   registerText.ts   field descriptions, only shown in expanded register
+ *                     cards and loaded on demand
+ *   presets*.ts       one preset catalog chunk per PresetChunkName, each
+ *                     preset stored as its differences from the chip reset
+ *                     values and default PA table; loaded by presetCatalog.ts
+ *
+ * The register table is a JSON string: V8 parses it several times faster
+ * than the equivalent object literal, and JSON.parse builds the objects
+ * without running any decoding script, which measured faster than unpacking
+ * hex-encoded masks.
+ *
+ * Run by `npm run compile:registers`; the registerLayout and presetCatalog
+ * tests fail when the checked-in modules are stale.
+ */
+
+import type { PresetChunkName, PresetDelta, PresetMap, RegisterLayoutMap, RegisterMap } from '../types/cc1101';
+import { toHex } from '../utils/calculations';
+import { DEFAULT_PA_TABLE } from '../utils/image';
+
+export interface CompiledRegisterModules {
+  table: string; // Source of registerTable.ts
+  text: string;  // Source of registerText.ts
+}
+
+/** Generated module of each preset chunk, relative to src/data */
+export const PRESET_CHUNK_FILES: Record<PresetChunkName, string> = {
+  standard: 'presetsStandard.ts',
+  keyfob: 'presetsKeyfob.ts'
+};
+
+/**
+ * Chunk a preset is compiled into
+ */
+export function presetChunkOf(name: string): PresetChunkName {
+  return name.toLowerCase().startsWith('keyfob') ? 'keyfob' : 'standard';
+}
+
+function quote(text: string): string {
+  return `'${text.replace(/\\/g, '\\\\').replace(/'/g, "\\'")}'`;
+}
+
+function header(title: string, note: string): string {
+  return `/**\n * ${title}\n * Generated from registers.ts by \`npm run compile:registers\`; do not edit.\n * ${note}\n */\n`;
+}
+
+/**
+ * Compile register definitions, which must cover addresses 0..n-1
+ */
+export function compileRegisterModules(registers: RegisterMap): CompiledRegisterModules {
+  const layout: RegisterLayoutMap = {};
+  const fieldText: string[] = [];
+  const count = Object.keys(registers).length;
+
+  for (let addr = 0; addr < count; addr++) {
+    const reg = registers[addr];
+    if (!reg) throw new Error(`Register addresses must be contiguous: 0x${addr.toString(16)} is missing`);
+    layout[addr] = { ...reg, fields: reg.fields.map(({ description: _, ...field }) => field) };
+    fieldText.push(`  [${reg.fields.map(field => quote(field.description)).join(', ')}]`);
+  }
+
+  const table =
+    header('Compiled CC1101 Register Table', 'Re-exported by registerLayout.ts.') +
+    `\nimport type { RegisterLayoutMap } from '../types/cc1101';\n` +
+    '\n/** Register layout by address, without field descriptions */\n' +
+    `export const REGISTER_LAYOUT: RegisterLayoutMap = JSON.parse(${quote(JSON.stringify(layout))});\n`;
+
+  const text =
+    header('Compiled CC1101 Field Descriptions', 'Loaded on demand by registerLayout.ts.') +
+    '\n/** Field descriptions, by address then declaration order */\n' +
+    `export const FIELD_DESCRIPTIONS: string[][] = [\n${fieldText.join(',\n')}\n];\n`;
+
+  return { table, text };
+}
+
+/**
+ * Encode a preset against the reset values in `registers`
+ */
+export function encodePresetDelta(name: string, preset: PresetMap[string], registers: RegisterMap): PresetDelta {
+  const count = Object.keys(registers).length;
+  const partial = Object.keys(preset.registers).length < count;
+  let deltas = '';
+  for (const [addr, value] of Object.entries(preset.registers).sort(([a], [b]) => Number(a) - Number(b))) {
+    if (partial || registers[Number(addr)]?.default !== value) deltas += toHex(Number(addr)) + toHex(value);
+  }
+  const paTable = preset.paTable.join() === DEFAULT_PA_TABLE.join() ? '' : preset.paTable.map(value => toHex(value)).join('');
+  const { frequency, modulation, dataRate, bandwidth, deviation, preamble, syncMode } = preset;
+  const values = [frequency, modulation, dataRate, bandwidth, deviation, preamble, syncMode] as const;
+  return partial ? [name, ...values, deltas, paTable, true] : [name, ...values, deltas, paTable];
+}
+
+/**
+ * Compile presets into one module source per chunk, in preset order
+ */
+export function compilePresetChunks(presets: PresetMap, registers: RegisterMap): Record<PresetChunkName, string> {
+  const rows: Record<PresetChunkName, string[]> = { standard: [], keyfob: [] };
+  for (const [name, preset] of Object.entries(presets)) {
+    const delta = encodePresetDelta(name, preset, registers);
+    rows[presetChunkOf(name)].push(`  [${delta.map(value => typeof value === 'string' ? quote(value) : String(value)).join(', ')}]`);
+  }
+
+  const chunks = {} as Record<PresetChunkName, string>;
+  for (const chunk of Object.keys(rows) as PresetChunkName[]) {
+    chunks[chunk] =
+      header(`Compiled ${chunk} Presets`, 'Loaded on demand by presetCatalog.ts; see PresetDelta for the row layout.') +
+      `\nimport type { PresetDelta } from '../types/cc1101';\n` +
+      `\nexport const PRESET_CHUNK: PresetDelta[] = [\n${rows[chunk].join(',\n')}\n];\n`;
+  }
+  return chunks;
+}
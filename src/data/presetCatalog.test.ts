@@ -0,0 +1,37 @@
+// @vitest-environment node
+import { describe, it, expect } from 'vitest';
+import { readFileSync } from 'node:fs';
+import { CC1101_REGISTERS, PRESETS } from './registers';
+import { PRESET_CHUNK_FILES, compilePresetChunks, presetChunkOf } from './compileRegisters';
+import { getLoadedPreset, loadPresetCatalog, loadPresetChunk } from './presetCatalog';
+import type { PresetChunkName } from '../types/cc1101';
+
+describe('Preset Catalog', () => {
+  it('decodes every chunk back to PRESETS, keyfobs in their own chunk', async () => {
+    expect(getLoadedPreset('FM 2-FSK (433.92MHz)')).toBeUndefined();
+    const standard = await loadPresetChunk('standard');
+    expect(Object.keys(standard).some(name => name.startsWith('Keyfob'))).toBe(false);
+    expect(getLoadedPreset('FM 2-FSK (433.92MHz)')).toBe(standard['FM 2-FSK (433.92MHz)']);
+    expect(getLoadedPreset('Keyfob Toyota 312MHz')).toBeUndefined();
+
+    const catalog = await loadPresetCatalog(['standard', 'keyfob']);
+    expect(await loadPresetChunk('standard')).toBe(standard);
+    expect(Object.keys(catalog)).toEqual(Object.keys(PRESETS));
+    expect(catalog).toEqual(PRESETS);
+    // Partial presets keep only the registers they set
+    expect(Object.keys(catalog['Walkie Talkie (433.92MHz)'].registers)).toEqual(
+      Object.keys(PRESETS['Walkie Talkie (433.92MHz)'].registers)
+    );
+  });
+
+  it('is up to date with registers.ts', () => {
+    const chunks = compilePresetChunks(PRESETS, CC1101_REGISTERS);
+    for (const chunk of Object.keys(PRESET_CHUNK_FILES) as PresetChunkName[]) {
+      // Run `npm run compile:registers` after editing registers.ts
+      expect(readFileSync(new URL(`./${PRESET_CHUNK_FILES[chunk]}`, import.meta.url), 'utf8')).toBe(chunks[chunk]);
+    }
+    expect(presetChunkOf('Keyfob Ford 315MHz FSK')).toBe('keyfob');
+    // Unchanged registers are left out
+    expect(chunks.standard).toContain(`['FM 2-FSK (433.92MHz)', 433.92, 0, 4.8, 58, 4.76, 4, 3, '000608050F7A10F812031515', '']`);
+  });
+});
@@ -0,0 +1,76 @@
+/**
+ * Preset Catalog
+ *
+ * The built-in presets, compiled into chunks of register deltas that are
+ * fetched on demand. The keyfob chunk is only requested when keyfobs are
+ * unlocked, so other visitors never download it.
+ */
+
+import type { PresetChunkName, PresetConfig, PresetDelta, PresetMap } from '../types/cc1101';
+import { DEFAULT_PA_TABLE, DEFAULT_REGISTERS } from '../utils/image';
+
+const CHUNK_LOADERS: Record<PresetChunkName, () => Promise<{ PRESET_CHUNK: PresetDelta[] }>> = {
+  standard: () => import('./presetsStandard'),
+  keyfob: () => import('./presetsKeyfob')
+};
+
+const loaded = new Map<string, PresetConfig>();
+const loading = new Map<PresetChunkName, Promise<PresetMap>>();
+
+function hexBytes(text: string): number[] {
+  const bytes: number[] = [];
+  for (let i = 0; i < text.length; i += 2) bytes.push(parseInt(text.slice(i, i + 2), 16));
+  return bytes;
+}
+
+/**
+ * Expand a compiled preset back to its full configuration
+ */
+export function decodePresetDelta(delta: PresetDelta): PresetConfig {
+  const [, frequency, modulation, dataRate, bandwidth, deviation, preamble, syncMode, deltas, paTable, partial] = delta;
+  const registers: Record<number, number> = {};
+  if (!partial) DEFAULT_REGISTERS.forEach((value, addr) => { registers[addr] = value; });
+  const pairs = hexBytes(deltas);
+  for (let i = 0; i < pairs.length; i += 2) registers[pairs[i]] = pairs[i + 1];
+  return {
+    frequency, modulation, dataRate, bandwidth, deviation, preamble, syncMode,
+    registers,
+    paTable: paTable ? hexBytes(paTable) : [...DEFAULT_PA_TABLE]
+  };
+}
+
+/**
+ * Fetch and decode one chunk; later calls share the first request
+ */
+export function loadPresetChunk(chunk: PresetChunkName): Promise<PresetMap> {
+  let request = loading.get(chunk);
+  if (!request) {
+    request = CHUNK_LOADERS[chunk]().then(module => {
+      const presets: PresetMap = {};
+      for (const delta of module.PRESET_CHUNK) {
+        presets[delta[0]] = decodePresetDelta(delta);
+        loaded.set(delta[0], presets[delta[0]]);
+      }
+      return presets;
+    }, error => {
+      loading.delete(chunk); // Retry on the next call
+      throw error;
+    });
+    loading.set(chunk, request);
+  }
+  return request;
+}
+
+/**
+ * Load several chunks in parallel, merged in the order given
+ */
+export async function loadPresetCatalog(chunks: PresetChunkName[]): Promise<PresetMap> {
+  return Object.assign({}, ...await Promise.all(chunks.map(loadPresetChunk)));
+}
+
+/**
+ * A preset from an already loaded chunk
+ */
+export function getLoadedPreset(name: string): PresetConfig | undefined {
+  return loaded.get(name);
+}
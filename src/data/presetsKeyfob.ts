@@ -0,0 +1,18 @@
+/**
+ * Compiled keyfob Presets
+ * Generated from registers.ts by `npm run compile:registers`; do not edit.
+ * Loaded on demand by presetCatalog.ts; see PresetDelta for the row layout.
+ */
+
+import type { PresetDelta } from '../types/cc1101';
+
+export const PRESET_CHUNK: PresetDelta[] = [
+  ['Keyfob US 315MHz OOK', 315, 3, 2.5, 270, 0, 4, 0, '000003070600070008320D0C0E1D0F89106711431230151519141B071C00221723E9242A2500261F2C812D352E09', '00C0000000000000'],
+  ['Keyfob Ford 315MHz FSK', 315, 0, 10, 102, 19.04, 4, 2, '000608050D0C0E1D0F8910C711931202153423E9242A2500261F2C812D352E09', ''],
+  ['Keyfob GM/Honda 315MHz', 315, 3, 3.79, 325, 0, 4, 0, '000003070600070008320D0C0E1D0F8910571238151519141B071C00221723E9242A2500261F2C812D352E09', '00C0000000000000'],
+  ['Keyfob EU 433.92MHz OOK', 433.92, 3, 3.79, 270, 0, 4, 0, '000003070600070008320F7A10671230151519141B071C00221723E9242A2500261F', '00C0000000000000'],
+  ['Keyfob VW/Audi 434.42MHz FSK', 434.42, 0, 9.99, 102, 19.04, 4, 2, '000608050EB50F5E10C71202153423E9242A2500261F', ''],
+  ['Keyfob BMW/Mercedes 868MHz', 868.35, 0, 9.99, 102, 19.04, 4, 2, '000608050D210E650F6A10C71202153423E9242A2500261F2C812D352E09', ''],
+  ['Keyfob Kia/Hyundai 433MHz', 433.92, 0, 4.8, 102, 9.52, 4, 2, '000608050F7A10C71202152423E9242A2500261F', ''],
+  ['Keyfob Toyota 312MHz', 312, 3, 3.79, 270, 0, 4, 0, '000003070600070008320D0C0E000F0010671230151519141B071C00221723E9242A2500261F2C812D352E09', '00C0000000000000']
+];
@@ -0,0 +1,17 @@
+/**
+ * Compiled standard Presets
+ * Generated from registers.ts by `npm run compile:registers`; do not edit.
+ * Loaded on demand by presetCatalog.ts; see PresetDelta for the row layout.
+ */
+
+import type { PresetDelta } from '../types/cc1101';
+
+export const PRESET_CHUNK: PresetDelta[] = [
+  ['AM 270kHz (315MHz)', 315, 3, 3.79, 270, 0, 4, 0, '000003070600070008320D0C0E1D0F8910671230151519141B071C00221723E9242A2500261F2C812D352E09', '00C0000000000000'],
+  ['AM 650kHz (433.92MHz)', 433.92, 3, 3.79, 650, 0, 4, 0, '000003070600070008320F7A10171230151519141B031C00221723E9242A2500261F', '00C0000000000000'],
+  ['FM 2-FSK (433.92MHz)', 433.92, 0, 4.8, 58, 4.76, 4, 3, '000608050F7A10F812031515', ''],
+  ['GFSK 9.99kbps (433.92MHz)', 433.92, 1, 9.99, 135, 19.04, 4, 2, '0006060008050F7A10C811931212153423E9242A2500261F', ''],
+  ['SubGHz Chat (433.92MHz)', 433.92, 1, 9.99, 135, 19.04, 4, 2, '00060446054C060008050F7A10C811931212153423E9242A2500261F', ''],
+  ['Walkie Talkie (433.92MHz)', 433.92, 0, 4.82, 135, 2.78, 2, 0, '020D070408320B0610A7118312041302140015061818191F1B071C001D0021562210', '', true],
+  ['4-FSK 9.6kbps (433.92MHz)', 433.92, 4, 9.6, 270, 25.39, 4, 2, '000608050F7A106812421545221323E9242A2500261F', '004080C000000000']
+];
@@ -0,0 +1,39 @@
+// @vitest-environment node
+import { describe, it, expect } from 'vitest';
+import { readFileSync } from 'node:fs';
+import { CC1101_REGISTERS } from './registers';
+import { compileRegisterModules } from './compileRegisters';
+import { REGISTER_LAYOUT, getFieldDescriptions, loadFieldDescriptions } from './registerLayout';
+
+describe('Compiled Register Layout', () => {
+  it('decodes to the register definitions without field descriptions', async () => {
+    const layout = Object.fromEntries(Object.entries(CC1101_REGISTERS).map(([addr, reg]) => [
+      addr,
+      { ...reg, fields: reg.fields.map(({ description: _, ...field }) => field) }
+    ]));
+    expect(REGISTER_LAYOUT).toEqual(layout);
+
+    const descriptions = await loadFieldDescriptions();
+    expect(getFieldDescriptions()).toBe(descriptions);
+    expect(await loadFieldDescriptions()).toBe(descriptions);
+    expect(descriptions).toEqual(Object.values(CC1101_REGISTERS).map(reg => reg.fields.map(field => field.description)));
+  });
+
+  it('is up to date with registers.ts', () => {
+    const { table, text } = compileRegisterModules(CC1101_REGISTERS);
+    const read = (name: string) => readFileSync(new URL(name, import.meta.url), 'utf8');
+    // Run `npm run compile:registers` after editing registers.ts
+    expect(read('./registerTable.ts')).toBe(table);
+    expect(read('./registerText.ts')).toBe(text);
+  });
+
+  it('quotes text and rejects gaps in the address space', () => {
+    const reg = { name: "R'\\", description: '', default: 0, fields: [{ name: 'F', bits: [0], description: "it's" }] };
+    const { table, text } = compileRegisterModules({ 0: reg });
+    const evaluate = (source: string, from: string) =>
+      new Function(`return ${source.slice(source.indexOf(from), source.lastIndexOf(';'))}`)();
+    expect(evaluate(table, 'JSON.parse(')[0].name).toBe("R'\\");
+    expect(evaluate(text, '[\n')).toEqual([["it's"]]);
+    expect(() => compileRegisterModules({ 1: reg })).toThrow('0x0 is missing');
+  });
+});
@@ -0,0 +1,34 @@
+/**
+ * CC1101 Register Layout
+ *
+ * Register metadata needed at startup (names, defaults, flags, field bits
+ * and option labels) comes from the compiled table. Field descriptions are
+ * only shown in an expanded register card, so they live in a separate chunk
+ * that is loaded on first use.
+ */
+
+export { REGISTER_LAYOUT } from './registerTable';
+
+let fieldDescriptions: string[][] | null = null;
+let loading: Promise<string[][]> | null = null;
+
+/**
+ * Field descriptions by address, or null until loadFieldDescriptions resolves
+ */
+export function getFieldDescriptions(): string[][] | null {
+  return fieldDescriptions;
+}
+
+/**
+ * Load the field description chunk; later calls share the first request
+ */
+export function loadFieldDescriptions(): Promise<string[][]> {
+  loading ??= import('./registerText').then(module => {
+    fieldDescriptions = module.FIELD_DESCRIPTIONS;
+    return fieldDescriptions;
+  }, error => {
+    loading = null; // Retry on the next call
+    throw error;
+  });
+  return loading;
+}
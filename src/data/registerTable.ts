@@ -0,0 +1,10 @@
+/**
+ * Compiled CC1101 Register Table
+ * Generated from registers.ts by `npm run compile:registers`; do not edit.
+ * Re-exported by registerLayout.ts.
+ */
+
+import type { RegisterLayoutMap } from '../types/cc1101';
+
+/** Register layout by address, without field descriptions */
+export const REGISTER_LAYOUT: RegisterLayoutMap = JSON.parse('{"0":{"name":"IOCFG2","description":"GDO2 Output Pin Configuration","default":41,"flipperExport":false,"fields":[{"name":"GDO2_INV","bits":[6]},{"name":"GDO2_CFG","bits":[5,4,3,2,1,0],"options":{"0":"RX FIFO threshold","1":"RX FIFO threshold or end of packet","2":"TX FIFO threshold","6":"Sync word sent/received","7":"Packet received with CRC OK","9":"Clear channel assessment","14":"Carrier sense","41":"CHIP_RDYn","47":"High impedance"}}]},"1":{"name":"IOCFG1","description":"GDO1 Output Pin Configuration","default":46,"flipperExport":false,"fields":[{"name":"GDO1_INV","bits":[6]},{"name":"GDO1_CFG","bits":[5,4,3,2,1,0]}]},"2":{"name":"IOCFG0","description":"GDO0 Output Pin Configuration","default":6,"flipperExport":true,"fields":[{"name":"TEMP_SENSOR_ENABLE","bits":[7]},{"name":"GDO0_INV","bits":[6]},{"name":"GDO0_CFG","bits":[5,4,3,2,1,0]}]},"3":{"name":"FIFOTHR","description":"RX FIFO and TX FIFO Thresholds","default":71,"flipperExport":true,"fields":[{"name":"ADC_RETENTION","bits":[6]},{"name":"CLOSE_IN_RX","bits":[5,4]},{"name":"FIFO_THR","bits":[3,2,1,0],"options":{"0":"TX: 61, RX: 4","1":"TX: 57, RX: 8","2":"TX: 53, RX: 12","3":"TX: 49, RX: 16","4":"TX: 45, RX: 20","5":"TX: 41, RX: 24","6":"TX: 37, RX: 28","7":"TX: 33, RX: 32","8":"TX: 29, RX: 36","9":"TX: 25, RX: 40","10":"TX: 21, RX: 44","11":"TX: 17, RX: 48","12":"TX: 13, RX: 52","13":"TX: 9, RX: 56","14":"TX: 5, RX: 60","15":"TX: 1, RX: 64"}}]},"4":{"name":"SYNC1","description":"Sync Word, High Byte","default":211,"flipperExport":true,"fields":[{"name":"SYNC[15:8]","bits":[7,6,5,4,3,2,1,0]}]},"5":{"name":"SYNC0","description":"Sync Word, Low Byte","default":145,"flipperExport":true,"fields":[{"name":"SYNC[7:0]","bits":[7,6,5,4,3,2,1,0]}]},"6":{"name":"PKTLEN","description":"Packet Length","default":255,"flipperExport":true,"fields":[{"name":"PACKET_LENGTH","bits":[7,6,5,4,3,2,1,0]}]},"7":{"name":"PKTCTRL1","description":"Packet Automation Control","default":4,"flipperExport":true,"fields":[{"name":"PQT","bits":[7,6,5]},{"name":"CRC_AUTOFLUSH","bits":[3]},{"name":"APPEND_STATUS","bits":[2]},{"name":"ADR_CHK","bits":[1,0],"options":{"0":"No check","1":"Check, no broadcast","2":"Check + 0x00 broadcast","3":"Check + 0x00 and 0xFF broadcast"}}]},"8":{"name":"PKTCTRL0","description":"Packet Automation Control","default":69,"flipperExport":true,"fields":[{"name":"WHITE_DATA","bits":[6]},{"name":"PKT_FORMAT","bits":[5,4],"options":{"0":"Normal (FIFO)","1":"Synchronous serial","2":"Random TX","3":"Async serial"}},{"name":"CRC_EN","bits":[2]},{"name":"LENGTH_CONFIG","bits":[1,0],"options":{"0":"Fixed","1":"Variable","2":"Infinite","3":"Reserved"}}]},"9":{"name":"ADDR","description":"Device Address","default":0,"flipperExport":true,"fields":[{"name":"DEVICE_ADDR","bits":[7,6,5,4,3,2,1,0]}]},"10":{"name":"CHANNR","description":"Channel Number","default":0,"flipperExport":true,"fields":[{"name":"CHAN","bits":[7,6,5,4,3,2,1,0],"recalibrate":true}]},"11":{"name":"FSCTRL1","description":"Frequency Synthesizer Control","default":6,"flipperExport":true,"fields":[{"name":"FREQ_IF","bits":[4,3,2,1,0]}]},"12":{"name":"FSCTRL0","description":"Frequency Synthesizer Control","default":0,"flipperExport":true,"fields":[{"name":"FREQOFF","bits":[7,6,5,4,3,2,1,0]}]},"13":{"name":"FREQ2","description":"Frequency Control Word, High Byte","default":16,"flipperExport":false,"fields":[{"name":"FREQ[23:22]","bits":[7,6]},{"name":"FREQ[21:16]","bits":[5,4,3,2,1,0],"recalibrate":true}]},"14":{"name":"FREQ1","description":"Frequency Control Word, Middle Byte","default":176,"flipperExport":false,"fields":[{"name":"FREQ[15:8]","bits":[7,6,5,4,3,2,1,0],"recalibrate":true}]},"15":{"name":"FREQ0","description":"Frequency Control Word, Low Byte","default":113,"flipperExport":false,"fields":[{"name":"FREQ[7:0]","bits":[7,6,5,4,3,2,1,0],"recalibrate":true}]},"16":{"name":"MDMCFG4","description":"Modem Configuration","default":202,"flipperExport":true,"fields":[{"name":"CHANBW_E","bits":[7,6]},{"name":"CHANBW_M","bits":[5,4]},{"name":"DRATE_E","bits":[3,2,1,0]}]},"17":{"name":"MDMCFG3","description":"Modem Configuration","default":131,"flipperExport":true,"fields":[{"name":"DRATE_M","bits":[7,6,5,4,3,2,1,0]}]},"18":{"name":"MDMCFG2","description":"Modem Configuration","default":19,"flipperExport":true,"fields":[{"name":"DEM_DCFILT_OFF","bits":[7]},{"name":"MOD_FORMAT","bits":[6,5,4],"options":{"0":"2-FSK","1":"GFSK","3":"ASK/OOK","4":"4-FSK","7":"MSK"}},{"name":"MANCHESTER_EN","bits":[3]},{"name":"SYNC_MODE","bits":[2,1,0],"options":{"0":"No preamble/sync","1":"15/16 sync","2":"16/16 sync","3":"30/32 sync","4":"No preamble/sync, carrier sense","5":"15/16 + carrier sense","6":"16/16 + carrier sense","7":"30/32 + carrier sense"}}]},"19":{"name":"MDMCFG1","description":"Modem Configuration","default":34,"flipperExport":true,"fields":[{"name":"FEC_EN","bits":[7]},{"name":"NUM_PREAMBLE","bits":[6,5,4],"options":{"0":"2","1":"3","2":"4","3":"6","4":"8","5":"12","6":"16","7":"24"}},{"name":"CHANSPC_E","bits":[1,0],"recalibrate":true}]},"20":{"name":"MDMCFG0","description":"Modem Configuration","default":248,"flipperExport":true,"fields":[{"name":"CHANSPC_M","bits":[7,6,5,4,3,2,1,0],"recalibrate":true}]},"21":{"name":"DEVIATN","description":"Modem Deviation Setting","default":53,"flipperExport":true,"fields":[{"name":"DEVIATION_E","bits":[6,5,4]},{"name":"DEVIATION_M","bits":[2,1,0]}]},"22":{"name":"MCSM2","description":"Main Radio Control State Machine Configuration","default":7,"flipperExport":true,"fields":[{"name":"RX_TIME_RSSI","bits":[4]},{"name":"RX_TIME_QUAL","bits":[3]},{"name":"RX_TIME","bits":[2,1,0]}]},"23":{"name":"MCSM1","description":"Main Radio Control State Machine Configuration","default":48,"flipperExport":true,"fields":[{"name":"CCA_MODE","bits":[5,4],"options":{"0":"Always","1":"If RSSI below threshold","2":"Unless receiving packet","3":"If RSSI below threshold unless receiving"}},{"name":"RXOFF_MODE","bits":[3,2],"options":{"0":"IDLE","1":"FSTXON","2":"TX","3":"Stay in RX"}},{"name":"TXOFF_MODE","bits":[1,0],"options":{"0":"IDLE","1":"FSTXON","2":"Stay in TX","3":"RX"}}]},"24":{"name":"MCSM0","description":"Main Radio Control State Machine Configuration","default":24,"flipperExport":true,"fields":[{"name":"FS_AUTOCAL","bits":[5,4],"options":{"0":"Never","1":"IDLE -> RX/TX","2":"RX/TX -> IDLE","3":"Every 4th RX/TX -> IDLE"}},{"name":"PO_TIMEOUT","bits":[3,2]},{"name":"PIN_CTRL_EN","bits":[1]},{"name":"XOSC_FORCE_ON","bits":[0]}]},"25":{"name":"FOCCFG","description":"Frequency Offset Compensation Configuration","default":22,"flipperExport":true,"fields":[{"name":"FOC_BS_CS_GATE","bits":[5]},{"name":"FOC_PRE_K","bits":[4,3]},{"name":"FOC_POST_K","bits":[2]},{"name":"FOC_LIMIT","bits":[1,0]}]},"26":{"name":"BSCFG","description":"Bit Synchronization Configuration","default":108,"flipperExport":true,"fields":[{"name":"BS_PRE_KI","bits":[7,6]},{"name":"BS_PRE_KP","bits":[5,4]},{"name":"BS_POST_KI","bits":[3]},{"name":"BS_POST_KP","bits":[2]},{"name":"BS_LIMIT","bits":[1,0]}]},"27":{"name":"AGCCTRL2","description":"AGC Control","default":67,"flipperExport":true,"fields":[{"name":"MAX_DVGA_GAIN","bits":[7,6]},{"name":"MAX_LNA_GAIN","bits":[5,4,3]},{"name":"MAGN_TARGET","bits":[2,1,0]}]},"28":{"name":"AGCCTRL1","description":"AGC Control","default":64,"flipperExport":true,"fields":[{"name":"AGC_LNA_PRIORITY","bits":[6]},{"name":"CARRIER_SENSE_REL_THR","bits":[5,4]},{"name":"CARRIER_SENSE_ABS_THR","bits":[3,2,1,0]}]},"29":{"name":"AGCCTRL0","description":"AGC Control","default":145,"flipperExport":true,"fields":[{"name":"HYST_LEVEL","bits":[7,6]},{"name":"WAIT_TIME","bits":[5,4]},{"name":"AGC_FREEZE","bits":[3,2]},{"name":"FILTER_LENGTH","bits":[1,0]}]},"30":{"name":"WOREVT1","description":"High Byte Event0 Timeout","default":135,"flipperExport":false,"fields":[{"name":"EVENT0[15:8]","bits":[7,6,5,4,3,2,1,0]}]},"31":{"name":"WOREVT0","description":"Low Byte Event0 Timeout","default":107,"flipperExport":false,"fields":[{"name":"EVENT0[7:0]","bits":[7,6,5,4,3,2,1,0]}]},"32":{"name":"WORCTRL","description":"Wake On Radio Control","default":251,"flipperExport":false,"fields":[{"name":"RC_PD","bits":[7]},{"name":"EVENT1","bits":[6,5,4]},{"name":"RC_CAL","bits":[3]},{"name":"WOR_RES","bits":[1,0]}]},"33":{"name":"FREND1","description":"Front End RX Configuration","default":86,"flipperExport":true,"fields":[{"name":"LNA_CURRENT","bits":[7,6]},{"name":"LNA2MIX_CURRENT","bits":[5,4]},{"name":"LODIV_BUF_CURRENT_RX","bits":[3,2]},{"name":"MIX_CURRENT","bits":[1,0]}]},"34":{"name":"FREND0","description":"Front End TX Configuration","default":16,"flipperExport":true,"fields":[{"name":"LODIV_BUF_CURRENT_TX","bits":[5,4]},{"name":"PA_POWER","bits":[2,1,0]}]},"35":{"name":"FSCAL3","description":"Frequency Synthesizer Calibration","default":169,"flipperExport":true,"fields":[{"name":"FSCAL3[7:6]","bits":[7,6]},{"name":"CHP_CURR_CAL_EN","bits":[5,4],"recalibrate":true},{"name":"FSCAL3[3:0]","bits":[3,2,1,0]}]},"36":{"name":"FSCAL2","description":"Frequency Synthesizer Calibration","default":10,"flipperExport":true,"fields":[{"name":"VCO_CORE_H_EN","bits":[5],"recalibrate":true},{"name":"FSCAL2","bits":[4,3,2,1,0]}]},"37":{"name":"FSCAL1","description":"Frequency Synthesizer Calibration","default":32,"flipperExport":true,"fields":[{"name":"FSCAL1","bits":[5,4,3,2,1,0]}]},"38":{"name":"FSCAL0","description":"Frequency Synthesizer Calibration","default":13,"flipperExport":true,"fields":[{"name":"FSCAL0","bits":[6,5,4,3,2,1,0]}]},"39":{"name":"RCCTRL1","description":"RC Oscillator Configuration","default":65,"flipperExport":false,"fields":[{"name":"RCCTRL1","bits":[6,5,4,3,2,1,0]}]},"40":{"name":"RCCTRL0","description":"RC Oscillator Configuration","default":0,"flipperExport":false,"fields":[{"name":"RCCTRL0","bits":[6,5,4,3,2,1,0]}]},"41":{"name":"FSTEST","description":"Frequency Synthesizer Calibration Control","default":89,"flipperExport":false,"sleepRetained":false,"fields":[{"name":"FSTEST","bits":[7,6,5,4,3,2,1,0]}]},"42":{"name":"PTEST","description":"Production Test","default":127,"flipperExport":false,"sleepRetained":false,"fields":[{"name":"PTEST","bits":[7,6,5,4,3,2,1,0]}]},"43":{"name":"AGCTEST","description":"AGC Test","default":63,"flipperExport":false,"sleepRetained":false,"fields":[{"name":"AGCTEST","bits":[7,6,5,4,3,2,1,0]}]},"44":{"name":"TEST2","description":"Various Test Settings","default":136,"flipperExport":false,"sleepRetained":false,"fields":[{"name":"TEST2","bits":[7,6,5,4,3,2,1,0]}]},"45":{"name":"TEST1","description":"Various Test Settings","default":49,"flipperExport":false,"sleepRetained":false,"fields":[{"name":"TEST1","bits":[7,6,5,4,3,2,1,0]}]},"46":{"name":"TEST0","description":"Various Test Settings","default":11,"flipperExport":false,"sleepRetained":false,"fields":[{"name":"TEST0[7:2]","bits":[7,6,5,4,3,2]},{"name":"VCO_SEL_CAL_EN","bits":[1],"recalibrate":true},{"name":"TEST0[0]","bits":[0]}]}}');
@@ -0,0 +1,56 @@
+/**
+ * Compiled CC1101 Field Descriptions
+ * Generated from registers.ts by `npm run compile:registers`; do not edit.
+ * Loaded on demand by registerLayout.ts.
+ */
+
+/** Field descriptions, by address then declaration order */
+export const FIELD_DESCRIPTIONS: string[][] = [
+  ['Invert output', 'GDO2 signal selection'],
+  ['Invert output', 'GDO1 signal selection'],
+  ['Enable analog temp sensor', 'Invert output', 'GDO0 signal selection'],
+  ['Retention mode', 'RX attenuation', 'FIFO threshold'],
+  ['High byte of sync word'],
+  ['Low byte of sync word'],
+  ['Packet length in fixed mode, max length in variable mode'],
+  ['Preamble quality estimator threshold', 'Auto flush RX FIFO on CRC error', 'Append RSSI/LQI/CRC to payload', 'Address check config'],
+  ['Data whitening enable', 'Packet format', 'CRC enable', 'Packet length config'],
+  ['Device address for packet filtering'],
+  ['Channel number'],
+  ['IF frequency (f_IF = f_XOSC / 2^10 × FREQ_IF)'],
+  ['Frequency offset (signed)'],
+  ['Always write 00', 'Frequency word high bits'],
+  ['Frequency word middle bits'],
+  ['Frequency word low bits'],
+  ['Channel bandwidth exponent', 'Channel bandwidth mantissa', 'Data rate exponent'],
+  ['Data rate mantissa'],
+  ['Disable DC blocking filter', 'Modulation format', 'Manchester encoding enable', 'Sync word qualifier mode'],
+  ['Forward Error Correction enable', 'Minimum preamble bytes', 'Channel spacing exponent'],
+  ['Channel spacing mantissa'],
+  ['Deviation exponent', 'Deviation mantissa'],
+  ['Direct RX terminate based on RSSI', 'Check sync word qualifier for RX timeout', 'RX timeout'],
+  ['Clear channel assessment mode', 'State after RX', 'State after TX'],
+  ['Auto calibration', 'Power on timeout', 'Pin radio control enable', 'Force XOSC on in SLEEP'],
+  ['Freeze FOC/BS until carrier sense', 'Freq compensation loop gain before sync', 'Freq compensation loop gain after sync', 'Freq compensation saturation point'],
+  ['Bit sync I gain before sync', 'Bit sync P gain before sync', 'Bit sync I gain after sync', 'Bit sync P gain after sync', 'Bit sync data rate compensation limit'],
+  ['Maximum DVGA gain', 'Maximum LNA + LNA2 gain', 'Target amplitude from channel filter'],
+  ['LNA gain priority', 'Carrier sense relative threshold', 'Carrier sense absolute threshold'],
+  ['AGC hysteresis level', 'AGC wait time', 'AGC freeze', 'Channel filter samples'],
+  ['Event0 timeout high byte'],
+  ['Event0 timeout low byte'],
+  ['Power down RC oscillator', 'Event1 timeout', 'RC oscillator calibration', 'WOR timer resolution'],
+  ['LNA current', 'LNA2 current', 'LO divider buffer current', 'Mixer current'],
+  ['LO divider buffer current TX', 'PA power setting index'],
+  ['Calibration result', 'Charge pump calibration', 'Calibration control'],
+  ['VCO core high', 'VCO calibration result'],
+  ['VCO capacitor array setting'],
+  ['VCO frequency offset'],
+  ['RC oscillator control'],
+  ['RC oscillator control'],
+  ['Test register'],
+  ['Production test'],
+  ['AGC test'],
+  ['Test settings'],
+  ['Test settings'],
+  ['Test settings', 'VCO calibration enable', 'Test settings']
+];
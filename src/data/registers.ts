@@ -139,7 +139,7 @@ export const CC1101_REGISTERS: RegisterMap = {
     default: 0x00,
     flipperExport: true,
     fields: [
-      { name: 'CHAN', bits: [7, 6, 5, 4, 3, 2, 1, 0], description: 'Channel number' }
+      { name: 'CHAN', bits: [7, 6, 5, 4, 3, 2, 1, 0], description: 'Channel number', recalibrate: true }
     ]
   },
   0x0B: {
@@ -167,7 +167,7 @@ export const CC1101_REGISTERS: RegisterMap = {
     flipperExport: false,
     fields: [
       { name: 'FREQ[23:22]', bits: [7, 6], description: 'Always write 00' },
-      { name: 'FREQ[21:16]', bits: [5, 4, 3, 2, 1, 0], description: 'Frequency word high bits' }
+      { name: 'FREQ[21:16]', bits: [5, 4, 3, 2, 1, 0], description: 'Frequency word high bits', recalibrate: true }
     ]
   },
   0x0E: {
@@ -176,7 +176,7 @@ export const CC1101_REGISTERS: RegisterMap = {
     default: 0xB0,
     flipperExport: false,
     fields: [
-      { name: 'FREQ[15:8]', bits: [7, 6, 5, 4, 3, 2, 1, 0], description: 'Frequency word middle bits' }
+      { name: 'FREQ[15:8]', bits: [7, 6, 5, 4, 3, 2, 1, 0], description: 'Frequency word middle bits', recalibrate: true }
     ]
   },
   0x0F: {
@@ -185,7 +185,7 @@ export const CC1101_REGISTERS: RegisterMap = {
     default: 0x71,
     flipperExport: false,
     fields: [
-      { name: 'FREQ[7:0]', bits: [7, 6, 5, 4, 3, 2, 1, 0], description: 'Frequency word low bits' }
+      { name: 'FREQ[7:0]', bits: [7, 6, 5, 4, 3, 2, 1, 0], description: 'Frequency word low bits', recalibrate: true }
     ]
   },
   0x10: {
@@ -234,7 +234,7 @@ export const CC1101_REGISTERS: RegisterMap = {
       { name: 'NUM_PREAMBLE', bits: [6, 5, 4], description: 'Minimum preamble bytes',
         options: { 0: '2', 1: '3', 2: '4', 3: '6', 4: '8', 5: '12', 6: '16', 7: '24' }
       },
-      { name: 'CHANSPC_E', bits: [1, 0], description: 'Channel spacing exponent' }
+      { name: 'CHANSPC_E', bits: [1, 0], description: 'Channel spacing exponent', recalibrate: true }
     ]
   },
   0x14: {
@@ -243,7 +243,7 @@ export const CC1101_REGISTERS: RegisterMap = {
     default: 0xF8,
     flipperExport: true,
     fields: [
-      { name: 'CHANSPC_M', bits: [7, 6, 5, 4, 3, 2, 1, 0], description: 'Channel spacing mantissa' }
+      { name: 'CHANSPC_M', bits: [7, 6, 5, 4, 3, 2, 1, 0], description: 'Channel spacing mantissa', recalibrate: true }
     ]
   },
   0x15: {
@@ -416,7 +416,7 @@ export const CC1101_REGISTERS: RegisterMap = {
     flipperExport: true,
     fields: [
       { name: 'FSCAL3[7:6]', bits: [7, 6], description: 'Calibration result' },
-      { name: 'CHP_CURR_CAL_EN', bits: [5, 4], description: 'Charge pump calibration' },
+      { name: 'CHP_CURR_CAL_EN', bits: [5, 4], description: 'Charge pump calibration', recalibrate: true },
       { name: 'FSCAL3[3:0]', bits: [3, 2, 1, 0], description: 'Calibration control' }
     ]
   },
@@ -426,7 +426,7 @@ export const CC1101_REGISTERS: RegisterMap = {
     default: 0x0A,
     flipperExport: true,
     fields: [
-      { name: 'VCO_CORE_H_EN', bits: [5], description: 'VCO core high' },
+      { name: 'VCO_CORE_H_EN', bits: [5], description: 'VCO core high', recalibrate: true },
       { name: 'FSCAL2', bits: [4, 3, 2, 1, 0], description: 'VCO calibration result' }
     ]
   },
@@ -471,6 +471,7 @@ export const CC1101_REGISTERS: RegisterMap = {
     description: 'Frequency Synthesizer Calibration Control',
     default: 0x59,
     flipperExport: false,
+    sleepRetained: false,
     fields: [
       { name: 'FSTEST', bits: [7, 6, 5, 4, 3, 2, 1, 0], description: 'Test register' }
     ]
@@ -480,6 +481,7 @@ export const CC1101_REGISTERS: RegisterMap = {
     description: 'Production Test',
     default: 0x7F,
     flipperExport: false,
+    sleepRetained: false,
     fields: [
       { name: 'PTEST', bits: [7, 6, 5, 4, 3, 2, 1, 0], description: 'Production test' }
     ]
@@ -489,6 +491,7 @@ export const CC1101_REGISTERS: RegisterMap = {
     description: 'AGC Test',
     default: 0x3F,
     flipperExport: false,
+    sleepRetained: false,
     fields: [
       { name: 'AGCTEST', bits: [7, 6, 5, 4, 3, 2, 1, 0], description: 'AGC test' }
     ]
@@ -498,6 +501,7 @@ export const CC1101_REGISTERS: RegisterMap = {
     description: 'Various Test Settings',
     default: 0x88,
     flipperExport: false,
+    sleepRetained: false,
     fields: [
       { name: 'TEST2', bits: [7, 6, 5, 4, 3, 2, 1, 0], description: 'Test settings' }
     ]
@@ -507,6 +511,7 @@ export const CC1101_REGISTERS: RegisterMap = {
     description: 'Various Test Settings',
     default: 0x31,
     flipperExport: false,
+    sleepRetained: false,
     fields: [
       { name: 'TEST1', bits: [7, 6, 5, 4, 3, 2, 1, 0], description: 'Test settings' }
     ]
@@ -516,9 +521,10 @@ export const CC1101_REGISTERS: RegisterMap = {
     description: 'Various Test Settings',
     default: 0x0B,
     flipperExport: false,
+    sleepRetained: false,
     fields: [
       { name: 'TEST0[7:2]', bits: [7, 6, 5, 4, 3, 2], description: 'Test settings' },
-      { name: 'VCO_SEL_CAL_EN', bits: [1], description: 'VCO calibration enable' },
+      { name: 'VCO_SEL_CAL_EN', bits: [1], description: 'VCO calibration enable', recalibrate: true },
       { name: 'TEST0[0]', bits: [0], description: 'Test settings' }
     ]
   }
@@ -0,0 +1,26 @@
+/**
+ * Field Descriptions Hook
+ */
+
+import { useEffect, useState } from 'react';
+import { getFieldDescriptions, loadFieldDescriptions } from '../data/registerLayout';
+
+/**
+ * Descriptions of one register's fields, loading the description chunk the
+ * first time any are asked for. Null while loading or when `address` is null.
+ */
+export function useFieldDescriptions(address: number | null): string[] | null {
+  const [descriptions, setDescriptions] = useState(getFieldDescriptions);
+
+  useEffect(() => {
+    if (address === null || descriptions) return;
+    let active = true;
+    loadFieldDescriptions().then(
+      loaded => { if (active) setDescriptions(loaded); },
+      () => { /* Cards show no field descriptions until a later load succeeds */ }
+    );
+    return () => { active = false; };
+  }, [address, descriptions]);
+
+  return address === null ? null : descriptions?.[address] ?? null;
+}
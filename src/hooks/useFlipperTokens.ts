@@ -0,0 +1,25 @@
+/**
+ * Flipper Token Stream Hook
+ */
+
+import { useEffect, useMemo, useRef } from 'react';
+import { tokenizeFlipperPresetData } from '../utils/export';
+import type { FlipperToken } from '../utils/export';
+
+/**
+ * Tokenize once per image change, reusing unchanged tokens from the last committed render
+ */
+export function useFlipperTokens(registers: Record<number, number>, paTable: number[]): FlipperToken[] {
+  const committed = useRef<FlipperToken[]>([]);
+  const tokens = useMemo(
+    () => tokenizeFlipperPresetData(registers, paTable, committed.current),
+    [registers, paTable]
+  );
+
+  // Updated after commit, so tokens from a discarded render are never reused
+  useEffect(() => {
+    committed.current = tokens;
+  }, [tokens]);
+
+  return tokens;
+}
@@ -0,0 +1,92 @@
+/**
+ * Library Statistics Hook
+ */
+
+import { useState, useCallback, useEffect, useRef } from 'react';
+import type { LibraryStats, LibraryStatsMessage } from '../utils/analytics';
+
+export interface LibraryStatsState {
+  stats: LibraryStats | null;
+  loading: boolean;
+  progress: number; // 0..1
+  files: number;    // Files finished
+  fileErrors: string[];
+  elapsedMs: number | null;
+}
+
+const IDLE_STATE: LibraryStatsState = {
+  stats: null,
+  loading: false,
+  progress: 0,
+  files: 0,
+  fileErrors: [],
+  elapsedMs: null
+};
+
+/**
+ * Analyze library files on a worker; statistics update while the files are parsed
+ */
+export function useLibraryStats(onError: (message: string) => void) {
+  const [state, setState] = useState<LibraryStatsState>(IDLE_STATE);
+  const workerRef = useRef<Worker | null>(null);
+  const onErrorRef = useRef(onError);
+  onErrorRef.current = onError;
+
+  const cancel = useCallback(() => {
+    workerRef.current?.terminate();
+    workerRef.current = null;
+    setState(prev => (prev.loading ? { ...prev, loading: false } : prev));
+  }, []);
+
+  useEffect(() => cancel, [cancel]);
+
+  const analyze = useCallback((files: File[]) => {
+    cancel();
+    if (files.length === 0) return;
+    setState({ ...IDLE_STATE, loading: true });
+
+    const worker = new Worker(new URL('../workers/libraryStats.worker.ts', import.meta.url), { type: 'module' });
+    workerRef.current = worker;
+
+    const finish = () => {
+      worker.terminate();
+      if (workerRef.current === worker) workerRef.current = null;
+    };
+
+    worker.onmessage = (event: MessageEvent<LibraryStatsMessage>) => {
+      const message = event.data;
+      switch (message.type) {
+        case 'stats':
+          setState(prev => ({
+            ...prev,
+            stats: message.stats,
+            files: message.files,
+            progress: message.total > 0 ? message.loaded / message.total : 1
+          }));
+          break;
+        case 'fileError':
+          setState(prev => ({ ...prev, fileErrors: [...prev.fileErrors, `${message.fileName}: ${message.message}`] }));
+          break;
+        case 'done':
+          setState(prev => ({
+            ...prev,
+            stats: message.stats,
+            files: message.files,
+            loading: false,
+            progress: 1,
+            elapsedMs: message.elapsedMs
+          }));
+          finish();
+          break;
+        case 'error':
+          onErrorRef.current(message.message);
+          setState(prev => ({ ...prev, loading: false }));
+          finish();
+          break;
+      }
+    };
+    worker.postMessage({ files });
+  }, [cancel]);
+
+  return { ...state, analyze, cancel };
+}
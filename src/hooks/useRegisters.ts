@@ -3,7 +3,8 @@
  */
 
 import { useState, useCallback, useMemo } from 'react';
-import { CC1101_REGISTERS, PRESETS } from '../data/registers';
+import { getLoadedPreset } from '../data/presetCatalog';
+import { REGISTER_LAYOUT } from '../data/registerLayout';
 import {
   frequencyToRegisters,
   registersToFrequency,
@@ -17,6 +18,7 @@ import {
   validateRfParameters
 } from '../utils/calculations';
 import type { RfValidation } from '../utils/calculations';
+import { DEFAULT_PA_TABLE } from '../utils/image';
 
 export interface RegisterActions {
   setRegister: (addr: number, value: number) => void;
@@ -43,14 +45,12 @@ export interface DerivedValues {
 
 function initializeRegisters(): Record<number, number> {
   const registers: Record<number, number> = {};
-  for (const [addr, reg] of Object.entries(CC1101_REGISTERS)) {
+  for (const [addr, reg] of Object.entries(REGISTER_LAYOUT)) {
     registers[Number(addr)] = reg.default;
   }
   return registers;
 }
 
-const DEFAULT_PA_TABLE = [0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00];
-
 export function useRegisters() {
   const [registers, setRegisters] = useState<Record<number, number>>(initializeRegisters);
   const [paTable, setPaTable] = useState<number[]>(DEFAULT_PA_TABLE);
@@ -169,8 +169,9 @@ export function useRegisters() {
     setPaTable(getPaTable(freq, powerDbm, isASK));
   }, [registers]);
 
+  // Presets are offered once their catalog chunk has loaded
   const loadPreset = useCallback((presetName: string) => {
-    const preset = PRESETS[presetName];
+    const preset = getLoadedPreset(presetName);
     if (preset) {
       setRegisters(prev => ({ ...prev, ...preset.registers }));
       setPaTable([...preset.paTable]);
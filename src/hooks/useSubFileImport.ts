@@ -0,0 +1,88 @@
+/**
+ * .sub File Import Hook
+ */
+
+import { useState, useCallback, useEffect, useRef } from 'react';
+import type { SubImportMessage, SubPreset } from '../utils/subFile';
+
+export interface SubImportState {
+  fileName: string | null;
+  loading: boolean;
+  progress: number; // 0..1
+  pulses: Int32Array | null;
+  protocol: string | null;
+}
+
+export interface SubImportHandlers {
+  onPreset: (preset: SubPreset) => void;
+  onError: (message: string) => void;
+}
+
+const IDLE_STATE: SubImportState = {
+  fileName: null,
+  loading: false,
+  progress: 0,
+  pulses: null,
+  protocol: null
+};
+
+/**
+ * Parse .sub files on a worker; the preset is handed over as soon as the header is read
+ */
+export function useSubFileImport(handlers: SubImportHandlers) {
+  const [state, setState] = useState<SubImportState>(IDLE_STATE);
+  const workerRef = useRef<Worker | null>(null);
+  const handlersRef = useRef(handlers);
+  handlersRef.current = handlers;
+
+  const cancel = useCallback(() => {
+    workerRef.current?.terminate();
+    workerRef.current = null;
+  }, []);
+
+  useEffect(() => cancel, [cancel]);
+
+  const importFile = useCallback((file: File) => {
+    cancel();
+    setState({ ...IDLE_STATE, fileName: file.name, loading: true });
+
+    const worker = new Worker(new URL('../workers/subImport.worker.ts', import.meta.url), { type: 'module' });
+    workerRef.current = worker;
+
+    const finish = () => {
+      worker.terminate();
+      if (workerRef.current === worker) workerRef.current = null;
+    };
+
+    worker.onmessage = (event: MessageEvent<SubImportMessage>) => {
+      const message = event.data;
+      switch (message.type) {
+        case 'preset':
+          handlersRef.current.onPreset(message.preset);
+          break;
+        case 'progress':
+          setState(prev => ({ ...prev, progress: message.total > 0 ? message.loaded / message.total : 1 }));
+          break;
+        case 'done':
+          if (message.presetError) handlersRef.current.onError(message.presetError);
+          setState(prev => ({
+            ...prev,
+            loading: false,
+            progress: 1,
+            pulses: message.pulses,
+            protocol: message.protocol
+          }));
+          finish();
+          break;
+        case 'error':
+          handlersRef.current.onError(message.message);
+          setState(prev => ({ ...prev, loading: false }));
+          finish();
+          break;
+      }
+    };
+    worker.postMessage({ file });
+  }, [cancel]);
+
+  return { ...state, importFile, cancel };
+}
@@ -0,0 +1,21 @@
+import { describe, it, expect } from 'vitest';
+import * as core from './index';
+
+describe('Core Library Entry', () => {
+  it('exposes the converters and formats', () => {
+    expect(core.frequencyToRegisters(433.92)).toEqual({ FREQ2: 0x10, FREQ1: 0xB0, FREQ0: 0x71 });
+    expect(typeof core.generateFlipperSettingUser).toBe('function');
+    expect(typeof core.parseFieldConfig).toBe('function');
+    expect(typeof core.decodeImageBank).toBe('function');
+    expect(core.CC1101_REGISTERS[0x0D].name).toBe('FREQ2');
+  });
+
+  it('round-trips a preset through the public API', () => {
+    const preset = core.PRESETS['FM 2-FSK (433.92MHz)'];
+    const data = core.generateFlipperPresetData(preset.registers, preset.paTable);
+    const parsed = core.parseFlipperPresetData(data);
+
+    expect(parsed.paTable).toEqual(preset.paTable);
+    expect(parsed.registers[0x12]).toBe(preset.registers[0x12]);
+  });
+});
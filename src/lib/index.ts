@@ -0,0 +1,39 @@
+/**
+ * CC1101 Core Library Entry Point
+ *
+ * Register metadata, converters and import/export formats without React or
+ * DOM dependencies. Built separately by `npm run build:lib` (ESM + CJS +
+ * declarations in dist-lib/); every module is emitted on its own so bundlers
+ * keep only what is imported.
+ */
+
+export * from '../types/cc1101';
+export * from '../data/registers';
+export * from '../utils/calculations';
+export * from '../utils/image';
+export * from '../utils/derive';
+export * from '../utils/spi';
+export * from '../utils/hash';
+export * from '../utils/lines';
+export * from '../utils/export';
+export * from '../utils/diff';
+export * from '../utils/switchPlan';
+export * from '../utils/wakeRestore';
+export * from '../utils/binary';
+export * from '../utils/canonical';
+export * from '../utils/subFile';
+export * from '../utils/smartrf';
+export * from '../utils/fieldConfig';
+export * from '../utils/patch';
+export * from '../utils/validate';
+export * from '../utils/solve';
+export * from '../utils/cArray';
+export * from '../utils/presetIndex';
+export * from '../utils/nearestPreset';
+export * from '../utils/columnStore';
+export * from '../utils/predicate';
+export * from '../utils/libraryReader';
+export * from '../utils/analytics';
+export * from '../utils/libraryDiff';
+export * from '../utils/merge';
+export * from '../utils/fleet';
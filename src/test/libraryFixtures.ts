@@ -0,0 +1,37 @@
+/**
+ * Shared Library Test Fixtures
+ *
+ * Small preset libraries built from packed images, for the suites that
+ * compare, merge or diff whole libraries.
+ */
+
+import { compileFieldPath, writePath } from '../utils/fieldConfig';
+import type { FieldConfigBank } from '../utils/fieldConfig';
+import { IMAGE_SIZE } from '../utils/image';
+
+/**
+ * A bank of [name, image] entries, in order; names may repeat
+ */
+export function library(entries: [string, Uint8Array][]): FieldConfigBank {
+  const images = new Uint8Array(entries.length * IMAGE_SIZE);
+  entries.forEach(([, image], i) => images.set(image, i * IMAGE_SIZE));
+  return { names: entries.map(([name]) => name), images };
+}
+
+/**
+ * Copy of `image` with edits applied. Keys are field paths, or byte offsets
+ * for bits no field covers (reserved bits, PA table bytes).
+ */
+export function edit(image: Uint8Array, edits: Record<string, number>): Uint8Array {
+  const copy = image.slice();
+  for (const [key, value] of Object.entries(edits)) {
+    if (/^\d+$/.test(key)) {
+      copy[Number(key)] = value;
+      continue;
+    }
+    const compiled = compileFieldPath(key);
+    if (!compiled) throw new Error(`Unknown field ${key}`);
+    writePath(copy, compiled, value);
+  }
+  return copy;
+}
@@ -7,6 +7,7 @@ export interface RegisterField {
   bits: number[];
   description: string;
   options?: Record<number, string>;
+  recalibrate?: boolean; // If true, changing this field invalidates the frequency synthesizer calibration
 }
 
 export interface Register {
@@ -15,10 +16,20 @@ export interface Register {
   default: number;
   fields: RegisterField[];
   flipperExport?: boolean; // If false, exclude from Flipper custom preset export (defaults to true)
+  sleepRetained?: boolean; // If false, the value is lost in SLEEP state (defaults to true)
 }
 
 export type RegisterMap = Record<number, Register>;
 
+/** A field as known at startup; descriptions load on demand */
+export type RegisterFieldLayout = Omit<RegisterField, 'description'>;
+
+export interface RegisterLayout extends Omit<Register, 'fields'> {
+  fields: RegisterFieldLayout[];
+}
+
+export type RegisterLayoutMap = Record<number, RegisterLayout>;
+
 export type RegisterGroups = Record<string, number[]>;
 
 export interface PresetConfig {
@@ -35,6 +46,20 @@ export interface PresetConfig {
 
 export type PresetMap = Record<string, PresetConfig>;
 
+/** Preset catalog chunks; keyfobs are only loaded once unlocked */
+export type PresetChunkName = 'standard' | 'keyfob';
+
+/**
+ * A compiled preset: name, frequency, modulation, dataRate, bandwidth,
+ * deviation, preamble, syncMode, then the registers as 4-hex-digit address
+ * and value pairs, then the PA table as hex bytes ('' for the default table).
+ * Without the final `true`, registers are the ones that differ from their
+ * reset values; with it, the preset sets only the listed registers.
+ */
+export type PresetDelta =
+  | [string, number, number, number, number, number, number, number, string, string]
+  | [string, number, number, number, number, number, number, number, string, string, true];
+
 export type PATableMap = Record<string, Record<string, number[]>>;
 
 export interface ModulationFormat {
@@ -44,7 +69,14 @@ export interface ModulationFormat {
 
 export type ModulationMap = Record<number, ModulationFormat>;
 
-export type ExportFormat = 'flipper_setting' | 'c_array' | 'raw_hex';
+export type ExportFormat =
+  | 'flipper_setting'
+  | 'c_array'
+  | 'raw_hex'
+  | 'wake_restore'
+  | 'smartrf_listing'
+  | 'smartrf_header'
+  | 'field_config';
 
 export interface RegisterState {
   registers: Record<number, number>;
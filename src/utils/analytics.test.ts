@@ -0,0 +1,56 @@
+// @vitest-environment node
+import { describe, it, expect } from 'vitest';
+import { PRESETS } from '../data/registers';
+import { createLibraryStats } from './analytics';
+import { deriveImage } from './derive';
+import { IMAGE_SIZE, packPresetMap } from './image';
+import { validateImage } from './validate';
+
+describe('Preset Library Statistics', () => {
+  const { names, images } = packPresetMap(PRESETS);
+
+  it('counts distributions and validation failures like per-preset derivation', () => {
+    const stats = createLibraryStats();
+    names.forEach((name, i) => stats.add(images, name, i * IMAGE_SIZE));
+    const snapshot = stats.snapshot();
+
+    expect(snapshot.presets).toBe(names.length);
+    for (const histogram of [snapshot.frequency, snapshot.modulation, snapshot.bandwidth, snapshot.dataRate, snapshot.paPower]) {
+      expect(histogram.counts.reduce((a, b) => a + b, 0)).toBe(names.length);
+      expect(histogram.labels).toHaveLength(histogram.counts.length);
+    }
+
+    const modulation = new Array(8).fill(0);
+    let errors = 0;
+    const failures = new Map<string, number>();
+    names.forEach((_, i) => {
+      modulation[deriveImage(images, i * IMAGE_SIZE).modulation]++;
+      const issues = validateImage(images, i * IMAGE_SIZE).filter(issue => issue.severity !== 'info');
+      if (issues.some(issue => issue.severity === 'error')) errors++;
+      for (const issue of issues) failures.set(issue.code, (failures.get(issue.code) ?? 0) + 1);
+    });
+    expect(snapshot.modulation.counts).toEqual(modulation);
+    expect(snapshot.modulation.labels[3]).toBe('ASK/OOK');
+    expect(snapshot.presetsWithErrors).toBe(errors);
+    expect(new Map(snapshot.failures.map(f => [f.code, f.count]))).toEqual(failures);
+    expect(snapshot.paPower.labels).toContain('+10dBm');
+  });
+
+  it('clusters duplicate images and keeps earlier snapshots unchanged', () => {
+    const stats = createLibraryStats();
+    stats.add(images, 'first', 0);
+    const early = stats.snapshot();
+    stats.add(images, 'copy', 0);
+    stats.add(images.slice(0, IMAGE_SIZE), 'another copy');
+    stats.add(images, names[1], IMAGE_SIZE);
+    const late = stats.snapshot();
+
+    expect(early.presets).toBe(1);
+    expect(early.duplicates).toEqual([]);
+    expect(late.duplicatePresets).toBe(2);
+    expect(late.duplicates).toHaveLength(1);
+    expect(late.duplicates[0].count).toBe(3);
+    expect(late.duplicates[0].names).toEqual(['first', 'copy', 'another copy']);
+    expect(late.frequency.counts.reduce((a, b) => a + b, 0)).toBe(4);
+  });
+});
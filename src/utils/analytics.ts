@@ -0,0 +1,188 @@
+/**
+ * Preset Library Statistics
+ *
+ * Accumulates distributions, validation failures and duplicate clusters
+ * one preset at a time, so a snapshot can be taken while a library is
+ * still streaming in. Every distribution has fixed bins; snapshots are
+ * small regardless of library size.
+ */
+
+import { MODULATION_FORMATS, PA_TABLES } from '../data/registers';
+import { getBandwidthFromRegister, registersToDataRate, toHex } from './calculations';
+import { canonicalFingerprint } from './canonical';
+import { deriveImage } from './derive';
+import { fingerprint64 } from './hash';
+import { IMAGE_SIZE, REGISTER_COUNT } from './image';
+import { validateImage } from './validate';
+import type { ImageIssue, IssueSeverity } from './validate';
+
+export interface Histogram {
+  labels: string[];
+  counts: number[];
+}
+
+export interface FailureCount {
+  code: string;
+  severity: IssueSeverity;
+  count: number;
+}
+
+export interface LibraryDuplicateCluster {
+  fingerprint: string; // Canonical, device scope
+  count: number;
+  names: string[]; // First MAX_CLUSTER_NAMES members
+}
+
+export interface LibraryStats {
+  presets: number;
+  frequency: Histogram;  // FREQUENCY_BIN_MHZ bins
+  modulation: Histogram;
+  bandwidth: Histogram;  // One bin per channel filter setting, narrowest first
+  dataRate: Histogram;   // One bin per DRATE_E octave
+  paPower: Histogram;    // Active PA table entry, as dBm where it matches the band's table
+  failures: FailureCount[];
+  presetsWithErrors: number;
+  presetsWithWarnings: number;
+  duplicates: LibraryDuplicateCluster[]; // Largest MAX_CLUSTERS, largest first
+  duplicatePresets: number;       // Presets that behave like an earlier one
+}
+
+export type LibraryStatsMessage =
+  | { type: 'stats'; stats: LibraryStats; files: number; loaded: number; total: number }
+  | { type: 'fileError'; fileName: string; message: string }
+  | { type: 'done'; stats: LibraryStats; files: number; elapsedMs: number }
+  | { type: 'error'; message: string };
+
+export interface LibraryStatsAccumulator {
+  add: (image: Uint8Array, name: string, offset?: number) => void;
+  snapshot: () => LibraryStats;
+}
+
+const FREQUENCY_MIN_MHZ = 300;
+const FREQUENCY_BIN_MHZ = 10;
+const FREQUENCY_BINS = 63; // 300 - 930 MHz
+const MAX_CLUSTERS = 20;
+const MAX_CLUSTER_NAMES = 5;
+
+// Channel filter codes (MDMCFG4[7:4]) from narrowest to widest
+const BANDWIDTH_CODES = Array.from({ length: 16 }, (_, code) => code).reverse();
+
+// Per band, PA table byte -> power label
+const PA_POWER_LABELS: Map<string, Map<number, string>> = (() => {
+  const bands = new Map<string, Map<number, string>>();
+  for (const [band, powers] of Object.entries(PA_TABLES)) {
+    const labels = new Map<number, string>();
+    for (const [power, table] of Object.entries(powers)) labels.set(table[0], power);
+    bands.set(band, labels);
+  }
+  return bands;
+})();
+
+// Same band split as getPaTable
+function paBand(frequency: number): string {
+  if (frequency < 350) return '315MHz';
+  if (frequency < 500) return '433MHz';
+  if (frequency < 900) return '868MHz';
+  return '915MHz';
+}
+
+function histogram(labels: string[], counts: ArrayLike<number>): Histogram {
+  return { labels, counts: Array.from(counts) };
+}
+
+export function createLibraryStats(): LibraryStatsAccumulator {
+  let presets = 0;
+  let presetsWithErrors = 0;
+  let presetsWithWarnings = 0;
+  let duplicatePresets = 0;
+  const frequency = new Uint32Array(FREQUENCY_BINS + 2); // Plus below and above range
+  const modulation = new Uint32Array(8);
+  const bandwidth = new Uint32Array(16);
+  const dataRate = new Uint32Array(16);
+  const paPower = new Map<string, number>();
+  const failures = new Map<string, FailureCount>();
+  const clusters = new Map<string, LibraryDuplicateCluster>();
+  // Exact image fingerprint -> its non-info issues, so copies skip validation
+  const issues = new Map<string, ImageIssue[]>();
+  const scratch = new Uint8Array(IMAGE_SIZE);
+
+  return {
+    add(image, name, offset = 0) {
+      presets++;
+      const fingerprint = canonicalFingerprint(image, offset, 'device', scratch);
+      const cluster = clusters.get(fingerprint);
+      if (cluster) {
+        duplicatePresets++;
+        cluster.count++;
+        if (cluster.names.length < MAX_CLUSTER_NAMES) cluster.names.push(name);
+      } else {
+        clusters.set(fingerprint, { fingerprint, count: 1, names: [name] });
+      }
+
+      const exact = fingerprint64(image, offset, offset + IMAGE_SIZE);
+      let found = issues.get(exact);
+      if (!found) {
+        found = validateImage(image, offset).filter(issue => issue.severity !== 'info');
+        issues.set(exact, found);
+      }
+      if (found.some(issue => issue.severity === 'error')) presetsWithErrors++;
+      if (found.some(issue => issue.severity === 'warning')) presetsWithWarnings++;
+      for (const issue of found) {
+        const failure = failures.get(issue.code);
+        if (failure) failure.count++;
+        else failures.set(issue.code, { code: issue.code, severity: issue.severity, count: 1 });
+      }
+
+      const derived = deriveImage(image, offset);
+      const bin = Math.floor((derived.frequency - FREQUENCY_MIN_MHZ) / FREQUENCY_BIN_MHZ);
+      frequency[bin < 0 ? 0 : bin >= FREQUENCY_BINS ? FREQUENCY_BINS + 1 : bin + 1]++;
+      modulation[derived.modulation]++;
+      bandwidth[image[offset + 0x10] >> 4]++;
+      dataRate[image[offset + 0x10] & 0x0F]++;
+
+      const pa = image[offset + REGISTER_COUNT + (image[offset + 0x22] & 0x07)];
+      const label = PA_POWER_LABELS.get(paBand(derived.frequency))?.get(pa) ?? `0x${toHex(pa)}`;
+      paPower.set(label, (paPower.get(label) ?? 0) + 1);
+    },
+
+    snapshot() {
+      const frequencyLabels = [
+        `< ${FREQUENCY_MIN_MHZ}`,
+        ...Array.from({ length: FREQUENCY_BINS }, (_, i) => String(FREQUENCY_MIN_MHZ + i * FREQUENCY_BIN_MHZ)),
+        `>= ${FREQUENCY_MIN_MHZ + FREQUENCY_BINS * FREQUENCY_BIN_MHZ}`
+      ];
+      const modulationLabels = Array.from({ length: 8 }, (_, mod) => MODULATION_FORMATS[mod]?.name ?? `reserved ${mod}`);
+      const dataRateLabels = Array.from({ length: 16 }, (_, e) =>
+        `${registersToDataRate(e, 0).toPrecision(3)}-${registersToDataRate(e, 255).toPrecision(3)}`
+      );
+      const paEntries = [...paPower].sort((a, b) => b[1] - a[1]);
+
+      const duplicates: LibraryDuplicateCluster[] = [];
+      for (const cluster of clusters.values()) {
+        if (cluster.count > 1) duplicates.push(cluster);
+      }
+      duplicates.sort((a, b) => b.count - a.count);
+
+      return {
+        presets,
+        frequency: histogram(frequencyLabels, frequency),
+        modulation: histogram(modulationLabels, modulation),
+        bandwidth: histogram(
+          BANDWIDTH_CODES.map(code => String(getBandwidthFromRegister(code << 4))),
+          BANDWIDTH_CODES.map(code => bandwidth[code])
+        ),
+        dataRate: histogram(dataRateLabels, dataRate),
+        paPower: histogram(paEntries.map(([label]) => label), paEntries.map(([, count]) => count)),
+        failures: [...failures.values()].map(f => ({ ...f })).sort((a, b) => b.count - a.count),
+        presetsWithErrors,
+        presetsWithWarnings,
+        duplicates: duplicates.slice(0, MAX_CLUSTERS).map(({ fingerprint, count, names }) => ({
+          fingerprint,
+          count,
+          names: names.slice()
+        })),
+        duplicatePresets
+      };
+    }
+  };
+}
@@ -0,0 +1,128 @@
+import { describe, it, expect } from 'vitest';
+import { PRESETS } from '../data/registers';
+import {
+  encodeImageBank,
+  decodeImageBank,
+  compressImages,
+  decompressImages,
+  encodeNameTable,
+  indexNameTable,
+  BANK_HEADER_SIZE,
+} from '../utils/binary';
+import { generateRawHex, parseRawHex } from '../utils/export';
+import { crc32 } from '../utils/hash';
+import { IMAGE_SIZE, packImage, unpackImage } from '../utils/image';
+
+describe('Binary Image Bank', () => {
+  const entries = Object.entries(PRESETS).map(([name, preset]) => ({
+    name,
+    registers: preset.registers,
+    paTable: preset.paTable,
+  }));
+
+  it('computes the standard CRC-32', () => {
+    expect(crc32(new TextEncoder().encode('123456789'))).toBe(0xCBF43926);
+  });
+
+  it('round-trips through raw hex', () => {
+    const bank = decodeImageBank(encodeImageBank(entries));
+
+    expect(bank.count).toBe(entries.length);
+    entries.forEach((entry, i) => {
+      const decoded = bank.entry(i);
+      expect(decoded.name).toBe(entry.name);
+      // Partial presets are filled with reset values when packed
+      const expected = unpackImage(packImage(entry.registers, entry.paTable)).registers;
+      expect(generateRawHex(decoded.registers)).toBe(generateRawHex(expected));
+      expect(decoded.paTable).toEqual(entry.paTable);
+    });
+  });
+
+  it('encodes images parsed from raw hex byte-for-byte', () => {
+    const hex = generateRawHex(PRESETS['FM 2-FSK (433.92MHz)'].registers);
+    const bank = decodeImageBank(encodeImageBank([{ name: 'hex', registers: parseRawHex(hex), paTable: [] }]));
+
+    expect(generateRawHex(bank.entry(0).registers)).toBe(hex);
+  });
+
+  it('maps uncompressed images without copying', () => {
+    const buffer = encodeImageBank(entries);
+    const bank = decodeImageBank(buffer);
+
+    expect(bank.images.buffer).toBe(buffer);
+    expect(bank.images.byteOffset).toBe(BANK_HEADER_SIZE);
+  });
+
+  it('stores the crystal frequency', () => {
+    const bank = decodeImageBank(encodeImageBank(entries, { xoscFreq: 27000000 }));
+
+    expect(bank.xoscFreq).toBe(27000000);
+  });
+
+  it('round-trips the compressed variant', () => {
+    const plain = decodeImageBank(encodeImageBank(entries));
+    const packed = encodeImageBank(entries, { compress: true });
+    const bank = decodeImageBank(packed);
+
+    expect(bank.compressed).toBe(true);
+    expect(Array.from(bank.images)).toEqual(Array.from(plain.images));
+    expect(packed.byteLength).toBeLessThan(encodeImageBank(entries).byteLength);
+  });
+
+  it('round-trips the columnar variant', () => {
+    const plain = decodeImageBank(encodeImageBank(entries));
+    const bank = decodeImageBank(encodeImageBank(entries, { columnar: true }));
+
+    expect(bank.columnar).toBe(true);
+    expect(Array.from(bank.images)).toEqual(Array.from(plain.images));
+    expect(bank.name(2)).toBe(entries[2].name);
+    expect(() => encodeImageBank(entries, { columnar: true, compress: true })).toThrow('cannot be compressed');
+  });
+
+  it('handles long zero runs', () => {
+    const images = new Uint8Array(IMAGE_SIZE * 20);
+    for (let i = 0; i < 20; i++) images.set(new Uint8Array(IMAGE_SIZE).fill(0x5A), i * IMAGE_SIZE);
+
+    const restored = decompressImages(compressImages(images), images.length);
+    expect(Array.from(restored)).toEqual(Array.from(images));
+  });
+
+  it('rejects compressed payloads with trailing bytes', () => {
+    const images = new Uint8Array(IMAGE_SIZE * 2).fill(0x5A);
+    const compressed = compressImages(images);
+    const padded = new Uint8Array(compressed.length + 1);
+    padded.set(compressed);
+    padded[compressed.length] = 0x01;
+
+    expect(() => decompressImages(padded, images.length)).toThrow('payload length mismatch');
+  });
+
+  it('cuts overlong names on a character boundary', () => {
+    const name = '\u00e9'.repeat(0x8000); // Two bytes each: byte 0xFFFF starts no character
+    const decoded = decodeImageBank(encodeImageBank([{ ...entries[0], name }])).name(0);
+
+    expect(decoded.length).toBe(0x7FFF);
+    expect(decoded === name.slice(0, 0x7FFF)).toBe(true);
+  });
+
+  it('indexes name tables holding exactly the expected names', () => {
+    const table = encodeNameTable(['a', 'bc', '']);
+
+    expect(Array.from(indexNameTable(table, 3))).toEqual([0, 3, 7]);
+    expect(() => indexNameTable(table, 4)).toThrow('truncated name table');
+    expect(() => indexNameTable(table, 2)).toThrow('name table length mismatch');
+  });
+
+  it('rejects corrupted data', () => {
+    const bytes = new Uint8Array(encodeImageBank(entries));
+    bytes[BANK_HEADER_SIZE + 3] ^= 0xFF;
+
+    expect(() => decodeImageBank(bytes)).toThrow('CRC mismatch');
+  });
+
+  it('rejects foreign files', () => {
+    const bytes = new Uint8Array(64);
+
+    expect(() => decodeImageBank(bytes)).toThrow('bad magic');
+  });
+});
@@ -0,0 +1,346 @@
+/**
+ * Binary Register Image Bank
+ *
+ * Layout (little-endian):
+ *   0  magic "CC11"
+ *   4  u8  version
+ *   5  u8  flags (bit 0: compressed payload, bit 1: columnar payload)
+ *   6  u16 image size (47 registers + 8 PA bytes)
+ *   8  u32 image count
+ *   12 u32 crystal frequency in Hz
+ *   16 u32 payload length
+ *   20 u32 name table length
+ *   24 payload: count x image size bytes, or its compressed form; columnar
+ *      payloads hold image size columns of count bytes each instead
+ *   .. name table: per image, u16 UTF-8 length + bytes
+ *   .. u32 CRC-32 of everything before it
+ */
+
+import { XOSC_FREQ } from '../data/registers';
+import { crc32 } from './hash';
+import { DEFAULT_REGISTERS, IMAGE_SIZE, packPresetMap, unpackImage } from './image';
+
+export const BANK_MAGIC = 'CC11';
+export const BANK_VERSION = 1;
+export const BANK_HEADER_SIZE = 24;
+export const BANK_FLAG_COMPRESSED = 0x01;
+export const BANK_FLAG_COLUMNAR = 0x02;
+
+export interface BankEntry {
+  name: string;
+  registers: Record<number, number>;
+  paTable: number[];
+}
+
+export interface EncodeOptions {
+  compress?: boolean;
+  columnar?: boolean; // Not combinable with compress
+  xoscFreq?: number;
+}
+
+export interface ImageBank {
+  version: number;
+  compressed: boolean;
+  columnar: boolean;
+  count: number;
+  xoscFreq: number;
+  images: Uint8Array; // count x IMAGE_SIZE; a view into the source buffer when uncompressed and row-major
+  image: (index: number) => Uint8Array;
+  name: (index: number) => string;
+  entry: (index: number) => BankEntry;
+}
+
+/**
+ * Validated sections of a bank, viewed in place
+ */
+export interface BankSections {
+  version: number;
+  flags: number;
+  count: number;
+  xoscFreq: number;
+  payload: Uint8Array;
+  names: Uint8Array;       // Name table: per image, u16 UTF-8 length + bytes
+  nameOffsets: Uint32Array; // Start of each entry in `names`
+}
+
+// Delta reference for the first image: reset values and an empty PA table
+const REFERENCE_IMAGE = (() => {
+  const ref = new Uint8Array(IMAGE_SIZE);
+  ref.set(DEFAULT_REGISTERS);
+  return ref;
+})();
+
+/**
+ * Compress packed images: XOR each against the previous one, then run-length
+ * encode zeros as 0x00 followed by the run length.
+ */
+export function compressImages(images: Uint8Array): Uint8Array {
+  const out = new Uint8Array(images.length * 2 + 2);
+  let o = 0;
+  let zeros = 0;
+
+  const flush = () => {
+    while (zeros > 0) {
+      const run = Math.min(zeros, 255);
+      out[o++] = 0;
+      out[o++] = run;
+      zeros -= run;
+    }
+  };
+
+  for (let i = 0; i < images.length; i++) {
+    const ref = i < IMAGE_SIZE ? REFERENCE_IMAGE[i] : images[i - IMAGE_SIZE];
+    const delta = images[i] ^ ref;
+    if (delta === 0) {
+      zeros++;
+    } else {
+      flush();
+      out[o++] = delta;
+    }
+  }
+  flush();
+
+  return out.slice(0, o);
+}
+
+/**
+ * Reverse of compressImages
+ */
+export function decompressImages(data: Uint8Array, length: number): Uint8Array {
+  const images = new Uint8Array(length);
+  let o = 0;
+  let i = 0;
+
+  for (; i < data.length && o < length; i++) {
+    if (data[i] === 0) {
+      if (i + 1 >= data.length) throw new Error('Invalid image bank: truncated zero run');
+      o += data[++i];
+    } else {
+      images[o++] = data[i];
+    }
+  }
+  // Bytes left over once the images are full are as corrupt as missing ones
+  if (o !== length || i !== data.length) throw new Error('Invalid image bank: payload length mismatch');
+
+  for (i = 0; i < length; i++) {
+    const ref = i < IMAGE_SIZE ? REFERENCE_IMAGE[i] : images[i - IMAGE_SIZE];
+    images[i] ^= ref;
+  }
+  return images;
+}
+
+/**
+ * Row-major images to IMAGE_SIZE columns of `count` bytes
+ */
+export function toColumnMajor(images: Uint8Array, count: number): Uint8Array {
+  const columns = new Uint8Array(count * IMAGE_SIZE);
+  for (let row = 0; row < count; row++) {
+    for (let i = 0; i < IMAGE_SIZE; i++) columns[i * count + row] = images[row * IMAGE_SIZE + i];
+  }
+  return columns;
+}
+
+/**
+ * Reverse of toColumnMajor
+ */
+export function toRowMajor(columns: Uint8Array, count: number): Uint8Array {
+  const images = new Uint8Array(count * IMAGE_SIZE);
+  for (let i = 0; i < IMAGE_SIZE; i++) {
+    for (let row = 0; row < count; row++) images[row * IMAGE_SIZE + i] = columns[i * count + row];
+  }
+  return images;
+}
+
+/**
+ * UTF-8 bytes of a name, cut to at most 0xFFFF bytes on a code point boundary
+ */
+function encodeName(encoder: TextEncoder, name: string): Uint8Array {
+  const bytes = encoder.encode(name);
+  if (bytes.length <= 0xFFFF) return bytes;
+  let end = 0xFFFF;
+  while (end > 0 && (bytes[end] & 0xC0) === 0x80) end--; // Continuation byte: back off to its lead byte
+  return bytes.subarray(0, end);
+}
+
+/**
+ * Encode a name table: per name, u16 UTF-8 length + bytes
+ */
+export function encodeNameTable(names: string[]): Uint8Array {
+  const encoder = new TextEncoder();
+  const encoded = names.map(n => encodeName(encoder, n));
+  const table = new Uint8Array(encoded.reduce((sum, n) => sum + 2 + n.length, 0));
+  let offset = 0;
+  for (const name of encoded) {
+    table[offset] = name.length & 0xFF;
+    table[offset + 1] = name.length >> 8;
+    table.set(name, offset + 2);
+    offset += 2 + name.length;
+  }
+  return table;
+}
+
+/**
+ * Frame an already laid out payload and name table as a bank
+ */
+export function encodeBankSections(
+  payload: Uint8Array,
+  names: Uint8Array,
+  count: number,
+  flags: number,
+  xoscFreq: number = XOSC_FREQ
+): ArrayBuffer {
+  const total = BANK_HEADER_SIZE + payload.length + names.length + 4;
+  const buffer = new ArrayBuffer(total);
+  const bytes = new Uint8Array(buffer);
+  const view = new DataView(buffer);
+
+  bytes.set(new TextEncoder().encode(BANK_MAGIC), 0);
+  view.setUint8(4, BANK_VERSION);
+  view.setUint8(5, flags);
+  view.setUint16(6, IMAGE_SIZE, true);
+  view.setUint32(8, count, true);
+  view.setUint32(12, xoscFreq, true);
+  view.setUint32(16, payload.length, true);
+  view.setUint32(20, names.length, true);
+  bytes.set(payload, BANK_HEADER_SIZE);
+  bytes.set(names, BANK_HEADER_SIZE + payload.length);
+
+  const crcOffset = total - 4;
+  view.setUint32(crcOffset, crc32(bytes, 0, crcOffset), true);
+  return buffer;
+}
+
+/**
+ * Encode packed images and names into a bank
+ */
+export function encodePackedBank(
+  images: Uint8Array,
+  names: string[],
+  options: EncodeOptions = {}
+): ArrayBuffer {
+  const count = names.length;
+  if (images.length !== count * IMAGE_SIZE) {
+    throw new Error(`Expected ${count * IMAGE_SIZE} image bytes, got ${images.length}`);
+  }
+
+  if (options.compress && options.columnar) throw new Error('Columnar banks cannot be compressed');
+
+  let payload = images;
+  let flags = 0;
+  if (options.compress) {
+    payload = compressImages(images);
+    flags = BANK_FLAG_COMPRESSED;
+  } else if (options.columnar) {
+    payload = toColumnMajor(images, count);
+    flags = BANK_FLAG_COLUMNAR;
+  }
+  return encodeBankSections(payload, encodeNameTable(names), count, flags, options.xoscFreq);
+}
+
+/**
+ * Encode register maps into a bank
+ */
+export function encodeImageBank(entries: BankEntry[], options: EncodeOptions = {}): ArrayBuffer {
+  const { names, images } = packPresetMap(entries.map((entry): [string, BankEntry] => [entry.name, entry]));
+  return encodePackedBank(images, names, options);
+}
+
+/**
+ * Offset of each of `count` length-prefixed names; the table must hold
+ * exactly that many
+ */
+export function indexNameTable(names: Uint8Array, count: number): Uint32Array {
+  const offsets = new Uint32Array(count);
+  let offset = 0;
+  for (let i = 0; i < count; i++) {
+    if (offset + 2 > names.length) throw new Error('Invalid image bank: truncated name table');
+    offsets[i] = offset;
+    offset += 2 + (names[offset] | (names[offset + 1] << 8));
+  }
+  if (offset !== names.length) throw new Error('Invalid image bank: name table length mismatch');
+  return offsets;
+}
+
+/**
+ * Validate a bank and locate its sections without copying or decoding them
+ */
+export function readBankSections(source: ArrayBuffer | Uint8Array): BankSections {
+  const bytes = source instanceof Uint8Array ? source : new Uint8Array(source);
+  if (bytes.length < BANK_HEADER_SIZE + 4) {
+    throw new Error('Invalid image bank: too short');
+  }
+
+  const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+  const magic = String.fromCharCode(bytes[0], bytes[1], bytes[2], bytes[3]);
+  if (magic !== BANK_MAGIC) throw new Error('Invalid image bank: bad magic');
+
+  const version = view.getUint8(4);
+  if (version !== BANK_VERSION) throw new Error(`Unsupported image bank version ${version}`);
+
+  const flags = view.getUint8(5);
+  if ((flags & BANK_FLAG_COMPRESSED) && (flags & BANK_FLAG_COLUMNAR)) {
+    throw new Error('Invalid image bank: compressed columnar payload');
+  }
+  const imageSize = view.getUint16(6, true);
+  if (imageSize !== IMAGE_SIZE) throw new Error(`Unsupported image size ${imageSize}`);
+
+  const count = view.getUint32(8, true);
+  const xoscFreq = view.getUint32(12, true);
+  const payloadLength = view.getUint32(16, true);
+  const namesLength = view.getUint32(20, true);
+  const crcOffset = BANK_HEADER_SIZE + payloadLength + namesLength;
+  if (crcOffset + 4 !== bytes.length) throw new Error('Invalid image bank: length mismatch');
+  if (view.getUint32(crcOffset, true) !== crc32(bytes, 0, crcOffset)) {
+    throw new Error('Invalid image bank: CRC mismatch');
+  }
+  if (!(flags & BANK_FLAG_COMPRESSED) && payloadLength !== count * IMAGE_SIZE) {
+    throw new Error('Invalid image bank: payload length mismatch');
+  }
+
+  // Names are decoded on demand
+  const names = bytes.subarray(BANK_HEADER_SIZE + payloadLength, crcOffset);
+  const nameOffsets = indexNameTable(names, count);
+
+  return {
+    version,
+    flags,
+    count,
+    xoscFreq,
+    payload: bytes.subarray(BANK_HEADER_SIZE, BANK_HEADER_SIZE + payloadLength),
+    names,
+    nameOffsets
+  };
+}
+
+/**
+ * Validate and map a bank. Uncompressed row-major images are viewed in
+ * place, not copied.
+ */
+export function decodeImageBank(source: ArrayBuffer | Uint8Array): ImageBank {
+  const { version, flags, count, xoscFreq, payload, names, nameOffsets } = readBankSections(source);
+  const compressed = (flags & BANK_FLAG_COMPRESSED) !== 0;
+  const columnar = (flags & BANK_FLAG_COLUMNAR) !== 0;
+
+  let images = payload;
+  if (compressed) images = decompressImages(payload, count * IMAGE_SIZE);
+  else if (columnar) images = toRowMajor(payload, count);
+
+  const decoder = new TextDecoder();
+  const image = (index: number) => images.subarray(index * IMAGE_SIZE, (index + 1) * IMAGE_SIZE);
+  const name = (index: number) => {
+    const start = nameOffsets[index];
+    return decoder.decode(names.subarray(start + 2, start + 2 + (names[start] | (names[start + 1] << 8))));
+  };
+
+  return {
+    version,
+    compressed,
+    columnar,
+    count,
+    xoscFreq,
+    images,
+    image,
+    name,
+    entry: (index: number) => ({ name: name(index), ...unpackImage(images, index * IMAGE_SIZE) })
+  };
+}
@@ -0,0 +1,41 @@
+import { describe, it, expect } from 'vitest';
+import { PRESETS } from '../data/registers';
+import { generateCArray } from './export';
+import { parseCArrayPresets } from './cArray';
+
+describe('C Array Import', () => {
+  it('round-trips generateCArray output', () => {
+    const preset = PRESETS['GFSK 9.99kbps (433.92MHz)'];
+    const [parsed] = parseCArrayPresets(generateCArray('gfsk', preset.registers, preset.paTable));
+    expect(parsed.name).toBe('gfsk');
+    expect(parsed.registers).toEqual(preset.registers);
+    expect(parsed.paTable).toEqual(preset.paTable);
+  });
+
+  it('reads Flipper style pair arrays with register names', () => {
+    const source = `
+      static const uint8_t ook_async_regs[][2] = {
+        {CC1101_IOCFG0, 0x0D}, /* GDO0 async serial */
+        {CC1101_FREQ2, 0x10},
+        {MDMCFG2, 0x30},
+        {0, 0},
+      };
+      static const uint8_t ook_async_patable[8] = {0x00, 0xC0, 0, 0, 0, 0, 0, 0};
+    `;
+    const [parsed] = parseCArrayPresets(source);
+    expect(parsed.name).toBe('ook_async');
+    expect(parsed.registers).toEqual({ 0x02: 0x0D, 0x0D: 0x10, 0x12: 0x30 });
+    expect(parsed.paTable).toEqual([0x00, 0xC0, 0, 0, 0, 0, 0, 0]);
+  });
+
+  it('takes the PA table from after the terminator and skips unrelated arrays', () => {
+    const source = `
+      const uint8_t lut[3] = {1, 2, 300};
+      uint8_t custom[] = {0x10, 0x0C, 0x11, 0x22, 0x00, 0x00, 0xC0, 0, 0, 0, 0, 0, 0, 0};
+    `;
+    const presets = parseCArrayPresets(source);
+    expect(presets).toHaveLength(1);
+    expect(presets[0].registers).toEqual({ 0x10: 0x0C, 0x11: 0x22 });
+    expect(presets[0].paTable).toEqual([0xC0, 0, 0, 0, 0, 0, 0, 0]);
+  });
+});
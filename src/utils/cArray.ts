@@ -0,0 +1,97 @@
+/**
+ * C Array Import
+ *
+ * Reads the uint8_t arrays firmware keeps presets in:
+ *   - generateCArray output: NAME_registers[] with one value per address
+ *     0x00-0x2E, and NAME_pa_table[]
+ *   - Flipper style address/value pairs (flat or [][2]) terminated by
+ *     0x00, 0x00, with the PA bytes after the terminator or in a separate
+ *     *_patable[]; addresses may be CC1101_<REGISTER> names
+ */
+
+import { REGISTER_LAYOUT } from '../data/registerLayout';
+import { PA_TABLE_SIZE, REGISTER_COUNT } from './image';
+
+export interface CArrayPreset {
+  name: string;
+  registers: Record<number, number>;
+  paTable: number[]; // Empty when the file has no PA table for this preset
+}
+
+const REGISTER_ADDRESSES: Map<string, number> = (() => {
+  const map = new Map<string, number>();
+  for (const [addr, reg] of Object.entries(REGISTER_LAYOUT)) {
+    map.set(reg.name, Number(addr));
+  }
+  return map;
+})();
+
+// `uint8_t name[] = { ... };` or `uint8_t name[][2] = { {a, v}, ... };`
+const ARRAY_PATTERN = /uint8_t\s+(\w+)\s*\[[^\]]*\](?:\s*\[[^\]]*\])?\s*=\s*\{((?:[^{};]|\{[^{}]*\})*)\}/g;
+
+function stripComments(text: string): string {
+  return text.replace(/\/\*[\s\S]*?\*\//g, '').replace(/\/\/[^\n]*/g, '');
+}
+
+function parseValue(token: string): number | undefined {
+  if (/^0x[0-9a-f]{1,2}$/i.test(token)) return parseInt(token, 16);
+  if (/^\d{1,3}$/.test(token)) return Number(token);
+  const name = token.startsWith('CC1101_') ? token.slice(7) : token;
+  return REGISTER_ADDRESSES.get(name);
+}
+
+function parsePairs(values: number[]): { registers: Record<number, number>; paTable: number[] } | null {
+  const registers: Record<number, number> = {};
+  for (let i = 0; i + 1 < values.length; i += 2) {
+    const addr = values[i];
+    const value = values[i + 1];
+    if (addr === 0 && value === 0) {
+      return { registers, paTable: values.slice(i + 2, i + 2 + PA_TABLE_SIZE) };
+    }
+    if (addr >= REGISTER_COUNT) return null;
+    registers[addr] = value;
+  }
+  return null;
+}
+
+/**
+ * Extract every preset a C source or header defines. Arrays that are neither
+ * a register list nor a PA table are ignored.
+ */
+export function parseCArrayPresets(text: string): CArrayPreset[] {
+  const presets: CArrayPreset[] = [];
+  const byPrefix = new Map<string, CArrayPreset>();
+  const source = stripComments(text);
+
+  for (const match of source.matchAll(ARRAY_PATTERN)) {
+    const [, name, body] = match;
+    const tokens = body.replace(/[{}]/g, '').split(',').map(t => t.trim()).filter(t => t.length > 0);
+    const values = tokens.map(parseValue);
+    if (values.some(v => v === undefined || v > 0xFF)) continue;
+    const bytes = values as number[];
+
+    const paMatch = /^(\w*?)_?pa(_?table)?$/i.exec(name);
+    if (paMatch && bytes.length <= PA_TABLE_SIZE) {
+      const owner = byPrefix.get(paMatch[1]) ?? presets[presets.length - 1];
+      if (owner && owner.paTable.length === 0) owner.paTable = bytes;
+      continue;
+    }
+
+    const prefix = name.replace(/_?regs$|_?registers$/i, '');
+    let preset: CArrayPreset | null = null;
+    if (bytes.length === REGISTER_COUNT) {
+      const registers: Record<number, number> = {};
+      bytes.forEach((value, addr) => { registers[addr] = value; });
+      preset = { name: prefix, registers, paTable: [] };
+    } else {
+      const pairs = parsePairs(bytes);
+      if (pairs) preset = { name: prefix, ...pairs };
+    }
+    if (!preset) continue;
+
+    presets.push(preset);
+    byPrefix.set(prefix, preset);
+  }
+
+  return presets;
+}
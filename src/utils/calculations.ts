@@ -3,7 +3,7 @@
  */
 
 import { XOSC_FREQ, PA_TABLES } from '../data/registers';
-import type { Register } from '../types/cc1101';
+import type { RegisterLayout } from '../types/cc1101';
 
 /**
  * Calculate FREQ registers from MHz
@@ -153,7 +153,7 @@ export function getPaTable(freqMHz: number, powerDbm: number, isASK: boolean = f
 /**
  * Get valid bit indices for a register
  */
-export function getValidBits(reg: Register): Set<number> {
+export function getValidBits(reg: RegisterLayout): Set<number> {
   const validBits = new Set<number>();
   if (reg && reg.fields) {
     for (const field of reg.fields) {
@@ -168,7 +168,7 @@ export function getValidBits(reg: Register): Set<number> {
 /**
  * Get field name for a specific bit
  */
-export function getFieldNameForBit(reg: Register, bitIndex: number): string | null {
+export function getFieldNameForBit(reg: RegisterLayout, bitIndex: number): string | null {
   if (reg && reg.fields) {
     for (const field of reg.fields) {
       if (field.bits.includes(bitIndex)) {
@@ -0,0 +1,27 @@
+// @vitest-environment node
+import { bench, describe } from 'vitest';
+import { PRESETS } from '../data/registers';
+import { findDuplicateClusters } from './canonical';
+import { IMAGE_SIZE, packImage } from './image';
+
+const COUNT = 100_000;
+
+// 100k presets: 200 distinct channels, each with 500 variants in don't-care bits
+const fsk = PRESETS['FM 2-FSK (433.92MHz)'];
+const base = packImage(fsk.registers, fsk.paTable);
+const library = new Uint8Array(COUNT * IMAGE_SIZE);
+for (let i = 0; i < COUNT; i++) {
+  library.set(base, i * IMAGE_SIZE);
+  library[i * IMAGE_SIZE + 0x0A] = i % 200; // CHANNR
+  library[i * IMAGE_SIZE + 0x00] = i & 0x3F; // IOCFG2: don't care
+}
+
+describe('Duplicate clusters over 100k presets', () => {
+  bench('flipper scope', () => {
+    findDuplicateClusters(library, 'flipper');
+  });
+
+  bench('device scope', () => {
+    findDuplicateClusters(library, 'device');
+  });
+});
@@ -0,0 +1,85 @@
+import { describe, it, expect } from 'vitest';
+import { PRESETS } from '../data/registers';
+import {
+  canonicalizeImage,
+  canonicalFingerprint,
+  findDuplicateClusters,
+} from '../utils/canonical';
+import { fingerprint64 } from '../utils/hash';
+import { packImage, IMAGE_SIZE } from '../utils/image';
+
+describe('Canonicalization', () => {
+  const fsk = PRESETS['FM 2-FSK (433.92MHz)'];
+  const ook = PRESETS['AM 650kHz (433.92MHz)'];
+  const pack = (registers: Record<number, number>, paTable: number[]) => packImage(registers, paTable);
+
+  it('produces a stable 64-bit hex fingerprint', () => {
+    const bytes = new Uint8Array([1, 2, 3]);
+
+    expect(fingerprint64(bytes)).toMatch(/^[0-9a-f]{16}$/);
+    expect(fingerprint64(bytes)).toBe(fingerprint64(new Uint8Array([1, 2, 3])));
+    expect(fingerprint64(bytes)).not.toBe(fingerprint64(new Uint8Array([1, 2, 4])));
+  });
+
+  it('ignores reserved bits', () => {
+    // IOCFG0 has no reserved bits, FREND0 bit 7 is reserved
+    const a = pack(fsk.registers, fsk.paTable);
+    const b = pack({ ...fsk.registers, 0x22: fsk.registers[0x22] | 0x80 }, fsk.paTable);
+
+    expect(canonicalFingerprint(a)).toBe(canonicalFingerprint(b));
+  });
+
+  it('ignores registers the Flipper does not export', () => {
+    const a = pack(fsk.registers, fsk.paTable);
+    const b = pack({ ...fsk.registers, 0x00: 0x29, 0x01: 0x00 }, fsk.paTable);
+
+    expect(canonicalFingerprint(a)).toBe(canonicalFingerprint(b));
+    expect(canonicalFingerprint(a, 0, 'device')).not.toBe(canonicalFingerprint(b, 0, 'device'));
+  });
+
+  it('ignores SYNC words when sync is disabled', () => {
+    const a = pack(ook.registers, ook.paTable);
+    const b = pack({ ...ook.registers, 0x04: 0x46, 0x05: 0x4C }, ook.paTable);
+
+    expect(canonicalFingerprint(a)).toBe(canonicalFingerprint(b));
+  });
+
+  it('keeps SYNC words when sync is enabled', () => {
+    const a = pack(fsk.registers, fsk.paTable);
+    const b = pack({ ...fsk.registers, 0x04: 0x46 }, fsk.paTable);
+
+    expect(canonicalFingerprint(a)).not.toBe(canonicalFingerprint(b));
+  });
+
+  it('ignores PA entries past PA_POWER', () => {
+    const image = canonicalizeImage(pack(fsk.registers, [0xC0, 0x60, 0x50, 0, 0, 0, 0, 0]));
+
+    expect(Array.from(image.subarray(0x2F))).toEqual([0xC0, 0, 0, 0, 0, 0, 0, 0]);
+  });
+
+  it('clusters near-identical presets', () => {
+    const library = new Uint8Array(IMAGE_SIZE * 4);
+    packImage(fsk.registers, fsk.paTable, library, 0);
+    packImage({ ...fsk.registers, 0x00: 0x2E }, fsk.paTable, library, IMAGE_SIZE);
+    packImage(ook.registers, ook.paTable, library, IMAGE_SIZE * 2);
+    packImage({ ...ook.registers, 0x05: 0x00 }, ook.paTable, library, IMAGE_SIZE * 3);
+
+    const clusters = findDuplicateClusters(library);
+    expect(clusters.map(c => c.members)).toEqual([[0, 1], [2, 3]]);
+  });
+
+  it('clusters a 100k-preset library', () => {
+    const count = 100000;
+    const library = new Uint8Array(IMAGE_SIZE * count);
+    const base = pack(fsk.registers, fsk.paTable);
+    for (let i = 0; i < count; i++) {
+      library.set(base, i * IMAGE_SIZE);
+      library[i * IMAGE_SIZE + 0x0A] = i % 200; // CHANNR: 200 distinct presets
+      library[i * IMAGE_SIZE + 0x00] = i & 0x3F; // IOCFG2: don't care
+    }
+
+    const clusters = findDuplicateClusters(library);
+    expect(clusters).toHaveLength(200);
+    expect(clusters[0].members).toHaveLength(count / 200);
+  });
+});
@@ -0,0 +1,110 @@
+/**
+ * Don't-Care-Aware Canonicalization
+ * Clears bits that cannot affect behaviour so near-identical presets compare equal
+ */
+
+import { REGISTER_LAYOUT } from '../data/registerLayout';
+import { getValidBits } from './calculations';
+import { fingerprint64 } from './hash';
+import { IMAGE_SIZE, REGISTER_COUNT, PA_TABLE_SIZE } from './image';
+
+export type CanonicalScope = 'flipper' | 'device';
+
+/**
+ * Per-register mask of documented field bits
+ */
+export const FIELD_MASKS: Uint8Array = (() => {
+  const masks = new Uint8Array(REGISTER_COUNT);
+  for (let addr = 0; addr < REGISTER_COUNT; addr++) {
+    const reg = REGISTER_LAYOUT[addr];
+    let mask = 0;
+    if (reg) {
+      for (const bit of getValidBits(reg)) mask |= 1 << bit;
+    }
+    masks[addr] = mask;
+  }
+  return masks;
+})();
+
+// Field masks with registers the Flipper ignores (flipperExport: false) cleared
+const FLIPPER_MASKS: Uint8Array = FIELD_MASKS.map((mask, addr) =>
+  REGISTER_LAYOUT[addr]?.flipperExport === true ? mask : 0
+);
+
+/**
+ * Write the canonical form of a packed image into `target`.
+ * - reserved bits are cleared
+ * - 'flipper' scope also clears registers excluded from Flipper export
+ * - SYNC1/SYNC0 are cleared when sync mode is disabled
+ * - PA table entries past FREND0.PA_POWER are cleared
+ */
+export function canonicalizeImage(
+  image: Uint8Array,
+  offset = 0,
+  scope: CanonicalScope = 'flipper',
+  target: Uint8Array = new Uint8Array(IMAGE_SIZE)
+): Uint8Array {
+  const masks = scope === 'flipper' ? FLIPPER_MASKS : FIELD_MASKS;
+  for (let addr = 0; addr < REGISTER_COUNT; addr++) {
+    target[addr] = image[offset + addr] & masks[addr];
+  }
+
+  // Same sync check as the Flipper exporter
+  if ((image[offset + 0x12] & 0x03) === 0) {
+    target[0x04] = 0;
+    target[0x05] = 0;
+  }
+
+  const paPower = image[offset + 0x22] & 0x07;
+  for (let i = 0; i < PA_TABLE_SIZE; i++) {
+    target[REGISTER_COUNT + i] = i <= paPower ? image[offset + REGISTER_COUNT + i] : 0;
+  }
+
+  return target;
+}
+
+/**
+ * 64-bit fingerprint of an image's canonical form
+ */
+export function canonicalFingerprint(
+  image: Uint8Array,
+  offset = 0,
+  scope: CanonicalScope = 'flipper',
+  scratch: Uint8Array = new Uint8Array(IMAGE_SIZE)
+): string {
+  return fingerprint64(canonicalizeImage(image, offset, scope, scratch));
+}
+
+export interface DuplicateCluster {
+  fingerprint: string;
+  members: number[]; // Image indices, in input order
+}
+
+/**
+ * Group packed images (count x IMAGE_SIZE bytes) by canonical fingerprint.
+ * Only clusters with more than one member are returned.
+ */
+export function findDuplicateClusters(
+  images: Uint8Array,
+  scope: CanonicalScope = 'flipper'
+): DuplicateCluster[] {
+  const count = Math.floor(images.length / IMAGE_SIZE);
+  const scratch = new Uint8Array(IMAGE_SIZE);
+  const clusters = new Map<string, number[]>();
+
+  for (let i = 0; i < count; i++) {
+    const fingerprint = canonicalFingerprint(images, i * IMAGE_SIZE, scope, scratch);
+    const members = clusters.get(fingerprint);
+    if (members) {
+      members.push(i);
+    } else {
+      clusters.set(fingerprint, [i]);
+    }
+  }
+
+  const duplicates: DuplicateCluster[] = [];
+  for (const [fingerprint, members] of clusters) {
+    if (members.length > 1) duplicates.push({ fingerprint, members });
+  }
+  return duplicates;
+}
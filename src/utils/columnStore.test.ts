@@ -0,0 +1,62 @@
+import { describe, it, expect } from 'vitest';
+import { PRESETS } from '../data/registers';
+import { BANK_HEADER_SIZE, encodePackedBank } from './binary';
+import {
+  columnStoreFromImages,
+  countColumnPath,
+  encodeColumnStore,
+  filterColumnPath,
+  loadColumnStore,
+  readColumnPath
+} from './columnStore';
+import { compileFieldPath, readPath } from './fieldConfig';
+import { IMAGE_SIZE, packPresetMap } from './image';
+
+describe('Columnar Preset Store', () => {
+  const { names, images } = packPresetMap(PRESETS);
+  const store = columnStoreFromImages(images, names);
+
+  it('maps a columnar bank without copying', () => {
+    const buffer = encodeColumnStore(store);
+    const loaded = loadColumnStore(buffer);
+
+    expect(loaded.data.buffer).toBe(buffer);
+    expect(loaded.data.byteOffset).toBe(BANK_HEADER_SIZE);
+    expect(loaded.columns[0x12].buffer).toBe(buffer);
+    names.forEach((name, i) => {
+      expect(loaded.name(i)).toBe(name);
+      expect(Array.from(loaded.image(i))).toEqual(Array.from(images.subarray(i * IMAGE_SIZE, (i + 1) * IMAGE_SIZE)));
+    });
+  });
+
+  it('transposes row-major and compressed banks', () => {
+    for (const options of [{}, { compress: true }]) {
+      const loaded = loadColumnStore(encodePackedBank(images, names, options));
+      expect(Array.from(loaded.data)).toEqual(Array.from(store.data));
+      expect(loaded.name(names.length - 1)).toBe(names[names.length - 1]);
+    }
+  });
+
+  it('filters and counts over columns like a per-preset scan', () => {
+    const modFormat = compileFieldPath('MDMCFG2.MOD_FORMAT')!;
+    const frequency = compileFieldPath('FREQ')!;
+    const rows = Array.from({ length: names.length }, (_, i) => i);
+
+    const ook = filterColumnPath(store, modFormat, 3, 3);
+    expect(Array.from(ook)).toEqual(rows.filter(i => readPath(images, modFormat, i * IMAGE_SIZE) === 3));
+
+    const min = frequency.parse('433MHz')!;
+    const max = frequency.parse('435MHz')!;
+    const band = filterColumnPath(store, frequency, min, max, ook);
+    expect(Array.from(band)).toEqual(Array.from(ook).filter(i => {
+      const value = readColumnPath(store, frequency, i);
+      return value >= min && value <= max;
+    }));
+    expect(band.length).toBeGreaterThan(0);
+
+    const counts = countColumnPath(store, modFormat);
+    expect(counts[3]).toBe(ook.length);
+    expect(counts.reduce((a, b) => a + b, 0)).toBe(names.length);
+    expect(() => countColumnPath(store, frequency)).toThrow('spans several registers');
+  });
+});
@@ -0,0 +1,171 @@
+/**
+ * Columnar Preset Store
+ *
+ * One Uint8Array per image byte: register addresses 0x00 - 0x2E, then the
+ * eight PA table entries. The columns are views into a single buffer laid
+ * out like a columnar bank's payload, so such a bank loads without copying;
+ * names stay in the bank's length-prefixed string table and are decoded on
+ * demand. A million presets take 55 MB plus their names.
+ */
+
+import { XOSC_FREQ } from '../data/registers';
+import {
+  BANK_FLAG_COLUMNAR,
+  BANK_FLAG_COMPRESSED,
+  decompressImages,
+  encodeBankSections,
+  encodeNameTable,
+  indexNameTable,
+  readBankSections,
+  toColumnMajor
+} from './binary';
+import type { CompiledPath } from './fieldConfig';
+import { IMAGE_SIZE } from './image';
+
+export interface ColumnStore {
+  count: number;
+  xoscFreq: number;
+  data: Uint8Array;      // IMAGE_SIZE columns of `count` bytes, back to back
+  columns: Uint8Array[]; // columns[addr]; PATABLE[i] at columns[REGISTER_COUNT + i]
+  names: Uint8Array;     // Per row, u16 UTF-8 length + bytes
+  nameOffsets: Uint32Array;
+  name: (row: number) => string;
+  image: (row: number, target?: Uint8Array, offset?: number) => Uint8Array;
+}
+
+/**
+ * Wrap column-major data and a name table without copying either
+ */
+export function createColumnStore(
+  data: Uint8Array,
+  count: number,
+  names: Uint8Array,
+  nameOffsets: Uint32Array,
+  xoscFreq: number = XOSC_FREQ
+): ColumnStore {
+  if (data.length !== count * IMAGE_SIZE) {
+    throw new Error(`Expected ${count * IMAGE_SIZE} column bytes, got ${data.length}`);
+  }
+  const columns = Array.from({ length: IMAGE_SIZE }, (_, i) => data.subarray(i * count, (i + 1) * count));
+  const decoder = new TextDecoder();
+
+  return {
+    count,
+    xoscFreq,
+    data,
+    columns,
+    names,
+    nameOffsets,
+    name: row => {
+      const start = nameOffsets[row];
+      return decoder.decode(names.subarray(start + 2, start + 2 + (names[start] | (names[start + 1] << 8))));
+    },
+    image: (row, target = new Uint8Array(IMAGE_SIZE), offset = 0) => {
+      for (let i = 0; i < IMAGE_SIZE; i++) target[offset + i] = columns[i][row];
+      return target;
+    }
+  };
+}
+
+/**
+ * Transpose row-major packed images into a store
+ */
+export function columnStoreFromImages(images: Uint8Array, names: string[], xoscFreq?: number): ColumnStore {
+  const count = names.length;
+  if (images.length !== count * IMAGE_SIZE) {
+    throw new Error(`Expected ${count * IMAGE_SIZE} image bytes, got ${images.length}`);
+  }
+  const table = encodeNameTable(names);
+  return createColumnStore(toColumnMajor(images, count), count, table, indexNameTable(table, count), xoscFreq);
+}
+
+/**
+ * Load a binary bank. Columnar banks are viewed in place; row-major and
+ * compressed banks are transposed once.
+ */
+export function loadColumnStore(source: ArrayBuffer | Uint8Array): ColumnStore {
+  const { flags, count, xoscFreq, payload, names, nameOffsets } = readBankSections(source);
+  let data = payload;
+  if (flags & BANK_FLAG_COMPRESSED) data = toColumnMajor(decompressImages(payload, count * IMAGE_SIZE), count);
+  else if (!(flags & BANK_FLAG_COLUMNAR)) data = toColumnMajor(payload, count);
+  return createColumnStore(data, count, names, nameOffsets, xoscFreq);
+}
+
+/**
+ * Encode a store as a columnar bank
+ */
+export function encodeColumnStore(store: ColumnStore): ArrayBuffer {
+  return encodeBankSections(store.data, store.names, store.count, BANK_FLAG_COLUMNAR, store.xoscFreq);
+}
+
+/**
+ * Value of a field path in one row
+ */
+export function readColumnPath(store: ColumnStore, path: CompiledPath, row: number): number {
+  let value = 0;
+  for (const part of path.parts) {
+    value |= ((store.columns[part.addr][row] >> part.shift) & part.mask) << part.valueShift;
+  }
+  return value;
+}
+
+/**
+ * Rows where `min <= path <= max`, ascending. Restricted to `rows` when
+ * given; single-byte fields scan one column.
+ */
+export function filterColumnPath(
+  store: ColumnStore,
+  path: CompiledPath,
+  min: number,
+  max: number,
+  rows?: Uint32Array
+): Uint32Array {
+  const out = new Uint32Array(rows ? rows.length : store.count);
+  let n = 0;
+
+  if (path.parts.length === 1) {
+    const { addr, shift, mask } = path.parts[0];
+    const column = store.columns[addr];
+    if (rows) {
+      for (let i = 0; i < rows.length; i++) {
+        const value = (column[rows[i]] >> shift) & mask;
+        if (value >= min && value <= max) out[n++] = rows[i];
+      }
+    } else {
+      for (let row = 0; row < column.length; row++) {
+        const value = (column[row] >> shift) & mask;
+        if (value >= min && value <= max) out[n++] = row;
+      }
+    }
+  } else {
+    const columns = path.parts.map(part => store.columns[part.addr]);
+    const shifts = Int32Array.from(path.parts, part => part.shift);
+    const masks = Int32Array.from(path.parts, part => part.mask);
+    const valueShifts = Int32Array.from(path.parts, part => part.valueShift);
+    const count = rows ? rows.length : store.count;
+    for (let i = 0; i < count; i++) {
+      const row = rows ? rows[i] : i;
+      let value = 0;
+      for (let p = 0; p < columns.length; p++) value |= ((columns[p][row] >> shifts[p]) & masks[p]) << valueShifts[p];
+      if (value >= min && value <= max) out[n++] = row;
+    }
+  }
+
+  return out.slice(0, n);
+}
+
+/**
+ * Occurrences of each value of a single-byte field path, indexed by value
+ */
+export function countColumnPath(store: ColumnStore, path: CompiledPath, rows?: Uint32Array): Uint32Array {
+  if (path.parts.length !== 1) throw new Error(`${path.path} spans several registers`);
+  const { addr, shift, mask } = path.parts[0];
+  const column = store.columns[addr];
+  const counts = new Uint32Array(mask + 1);
+  if (rows) {
+    for (let i = 0; i < rows.length; i++) counts[(column[rows[i]] >> shift) & mask]++;
+  } else {
+    for (let row = 0; row < column.length; row++) counts[(column[row] >> shift) & mask]++;
+  }
+  return counts;
+}
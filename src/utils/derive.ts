@@ -0,0 +1,46 @@
+/**
+ * Derived RF Parameters from Packed Images
+ */
+
+import { MODULATION_FORMATS } from '../data/registers';
+import {
+  registersToFrequency,
+  registersToDataRate,
+  getBandwidthFromRegister,
+  registerToDeviation
+} from './calculations';
+
+export interface ImageDerived {
+  frequency: number;  // MHz
+  modulation: number; // MDMCFG2.MOD_FORMAT
+  dataRate: number;   // kBaud
+  bandwidth: number;  // kHz
+  deviation: number;  // kHz
+}
+
+export type DerivedKey = keyof ImageDerived;
+
+export const DERIVED_KEYS: DerivedKey[] = ['frequency', 'modulation', 'dataRate', 'bandwidth', 'deviation'];
+
+/**
+ * Same quantities as the editor's DerivedValues, read from an image
+ */
+export function deriveImage(image: Uint8Array, offset = 0): ImageDerived {
+  return {
+    frequency: registersToFrequency(image[offset + 0x0D], image[offset + 0x0E], image[offset + 0x0F]),
+    modulation: (image[offset + 0x12] >> 4) & 0x07,
+    dataRate: registersToDataRate(image[offset + 0x10], image[offset + 0x11]),
+    bandwidth: getBandwidthFromRegister(image[offset + 0x10]),
+    deviation: registerToDeviation(image[offset + 0x15])
+  };
+}
+
+/**
+ * MOD_FORMAT from a format name (case-insensitive) or its number
+ */
+export function parseModulation(text: string): number | null {
+  for (const [value, format] of Object.entries(MODULATION_FORMATS)) {
+    if (format.name.toLowerCase() === text.toLowerCase()) return Number(value);
+  }
+  return /^\d+$/.test(text) ? Number(text) : null;
+}
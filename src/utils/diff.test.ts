@@ -0,0 +1,118 @@
+import { describe, it, expect } from 'vitest';
+import { PRESETS } from '../data/registers';
+import {
+  planReconfiguration,
+  diffRegisterFields,
+  generateDiffCArray,
+  generateDiffJson,
+  FULL_REWRITE_BYTES,
+} from '../utils/diff';
+import { coalesceAddresses } from '../utils/spi';
+
+describe('Differential Reconfiguration', () => {
+  const fsk = PRESETS['FM 2-FSK (433.92MHz)'];
+  const gfsk = PRESETS['GFSK 9.99kbps (433.92MHz)'];
+
+  describe('coalesceAddresses', () => {
+    it('merges adjacent addresses into one burst', () => {
+      expect(coalesceAddresses([0x10, 0x11, 0x12])).toEqual([{ start: 0x10, length: 3 }]);
+    });
+
+    it('bridges a single unchanged register', () => {
+      expect(coalesceAddresses([0x10, 0x12])).toEqual([{ start: 0x10, length: 3 }]);
+    });
+
+    it('keeps distant addresses in separate transactions', () => {
+      expect(coalesceAddresses([0x06, 0x10])).toEqual([
+        { start: 0x06, length: 1 },
+        { start: 0x10, length: 1 },
+      ]);
+    });
+  });
+
+  describe('diffRegisterFields', () => {
+    it('reports changed fields by name', () => {
+      const changes = diffRegisterFields(0x12, 0x03, 0x12);
+      expect(changes.map(c => c.field)).toEqual(['MOD_FORMAT', 'SYNC_MODE']);
+    });
+
+    it('reports reserved bit changes without a field name', () => {
+      // IOCFG2 bit 7 is not part of any field
+      const changes = diffRegisterFields(0x00, 0x06, 0x86);
+      expect(changes).toHaveLength(1);
+      expect(changes[0].field).toBeNull();
+    });
+  });
+
+  describe('planReconfiguration', () => {
+    it('writes only the changed registers', () => {
+      const plan = planReconfiguration(fsk.registers, fsk.paTable, gfsk.registers, gfsk.paTable);
+
+      expect(plan.changedRegisters).toEqual([0x06, 0x10, 0x11, 0x12, 0x15, 0x23, 0x24, 0x25, 0x26]);
+      expect(plan.ops[0]).toEqual({ op: 'strobe', strobe: 'SIDLE' });
+      expect(plan.ops).toContainEqual({ op: 'write', addr: 0x10, values: [0xC8, 0x93, 0x12] });
+      expect(plan.spiBytes).toBeLessThan(FULL_REWRITE_BYTES);
+    });
+
+    it('defers calibration to FS_AUTOCAL when enabled', () => {
+      const plan = planReconfiguration(fsk.registers, fsk.paTable, gfsk.registers, gfsk.paTable);
+
+      // FSCAL2.VCO_CORE_H_EN changes, MCSM0.FS_AUTOCAL = 1
+      expect(plan.calibration).toBe('auto');
+      expect(plan.ops.some(op => op.op === 'strobe' && op.strobe === 'SCAL')).toBe(false);
+    });
+
+    it('issues SCAL after a frequency change without auto calibration', () => {
+      const from = { ...fsk.registers, 0x18: 0x08 };
+      const to = { ...from, 0x0E: 0xB5, 0x0F: 0x5E };
+      const plan = planReconfiguration(from, fsk.paTable, to, fsk.paTable);
+
+      expect(plan.calibration).toBe('strobe');
+      expect(plan.ops[plan.ops.length - 1]).toEqual({ op: 'strobe', strobe: 'SCAL' });
+    });
+
+    it('writes the PA table up to the last changed entry', () => {
+      const to = [0xC0, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00];
+      const plan = planReconfiguration(fsk.registers, fsk.paTable, fsk.registers, to);
+
+      expect(plan.ops).toContainEqual({ op: 'patable', values: [0xC0, 0x60] });
+    });
+
+    it('returns an empty plan for identical images', () => {
+      const plan = planReconfiguration(fsk.registers, fsk.paTable, fsk.registers, fsk.paTable);
+
+      expect(plan.ops).toHaveLength(0);
+      expect(plan.spiBytes).toBe(0);
+    });
+
+    it('skips SIDLE when the caller guarantees IDLE', () => {
+      const plan = planReconfiguration(fsk.registers, fsk.paTable, gfsk.registers, gfsk.paTable, {
+        assumeIdle: true,
+      });
+
+      expect(plan.ops[0].op).toBe('write');
+    });
+  });
+
+  describe('generateDiffCArray', () => {
+    it('emits length-prefixed transactions with burst headers', () => {
+      const plan = planReconfiguration(fsk.registers, fsk.paTable, gfsk.registers, gfsk.paTable);
+      const result = generateDiffCArray('FSK', 'GFSK', plan);
+
+      expect(result).toContain('static const uint8_t FSK_to_GFSK[]');
+      expect(result).toContain('0x01, 0x36,  // SIDLE');
+      expect(result).toContain('0x04, 0x50, 0xC8, 0x93, 0x12,  // MDMCFG4..MDMCFG2');
+      expect(result).toContain('0x00\n};');
+    });
+  });
+
+  describe('generateDiffJson', () => {
+    it('emits a parseable op list', () => {
+      const plan = planReconfiguration(fsk.registers, fsk.paTable, gfsk.registers, gfsk.paTable);
+      const parsed = JSON.parse(generateDiffJson(plan));
+
+      expect(parsed.ops).toHaveLength(plan.ops.length);
+      expect(parsed.spiBytes).toBe(plan.spiBytes);
+    });
+  });
+});
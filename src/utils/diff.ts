@@ -0,0 +1,266 @@
+/**
+ * Differential Reconfiguration
+ * Plans the minimal SPI sequence that moves the radio from one register image to another
+ */
+
+import { REGISTER_LAYOUT } from '../data/registerLayout';
+import { extractFieldValue, toHex } from './calculations';
+import { packImage, REGISTER_COUNT, PA_TABLE_SIZE } from './image';
+import {
+  STROBES,
+  PATABLE_ADDR,
+  TRANSACTION_OVERHEAD,
+  coalesceAddresses,
+  writeHeader
+} from './spi';
+import type { StrobeName } from './spi';
+
+export type ReconfigOp =
+  | { op: 'strobe'; strobe: StrobeName }
+  | { op: 'write'; addr: number; values: number[] }
+  | { op: 'patable'; values: number[] };
+
+export interface FieldChange {
+  addr: number;
+  register: string;
+  field: string | null; // null for bits outside any documented field
+  from: number;
+  to: number;
+}
+
+export type CalibrationMode = 'none' | 'auto' | 'strobe';
+
+export interface DiffPlan {
+  changes: FieldChange[];
+  changedRegisters: number[];
+  paTableChanged: boolean;
+  calibration: CalibrationMode;
+  ops: ReconfigOp[];
+  spiBytes: number;
+  transactions: number;
+  fullBytes: number;
+  fullTransactions: number;
+}
+
+export interface DiffOptions {
+  assumeIdle?: boolean; // Caller guarantees the radio is already in IDLE
+  overhead?: number; // Per-transaction cost in byte times
+}
+
+// SIDLE + burst 0x00-0x2E + PATABLE burst + SCAL
+export const FULL_REWRITE_BYTES = 1 + (1 + REGISTER_COUNT) + (1 + PA_TABLE_SIZE) + 1;
+export const FULL_REWRITE_TRANSACTIONS = 4;
+
+/**
+ * Compare two register values field by field
+ */
+export function diffRegisterFields(addr: number, from: number, to: number): FieldChange[] {
+  const reg = REGISTER_LAYOUT[addr];
+  const changes: FieldChange[] = [];
+  if (from === to) return changes;
+
+  let covered = 0;
+  for (const field of reg?.fields ?? []) {
+    for (const bit of field.bits) covered |= 1 << bit;
+    const a = extractFieldValue(from, field.bits);
+    const b = extractFieldValue(to, field.bits);
+    if (a !== b) {
+      changes.push({ addr, register: reg.name, field: field.name, from: a, to: b });
+    }
+  }
+
+  const reservedFrom = from & ~covered & 0xFF;
+  const reservedTo = to & ~covered & 0xFF;
+  if (reservedFrom !== reservedTo) {
+    changes.push({
+      addr,
+      register: reg?.name ?? `0x${toHex(addr)}`,
+      field: null,
+      from: reservedFrom,
+      to: reservedTo
+    });
+  }
+
+  return changes;
+}
+
+function requiresRecalibration(changes: FieldChange[]): boolean {
+  return changes.some(change => {
+    if (change.field === null) return false;
+    const field = REGISTER_LAYOUT[change.addr]?.fields.find(f => f.name === change.field);
+    return field?.recalibrate === true;
+  });
+}
+
+/**
+ * Calibration needed after applying `changes` to reach image `to`
+ */
+export function calibrationFor(changes: FieldChange[], to: Uint8Array): CalibrationMode {
+  if (!requiresRecalibration(changes)) return 'none';
+  // FS_AUTOCAL = 1 calibrates on the next IDLE -> RX/TX transition anyway
+  const fsAutocal = (to[0x18] >> 4) & 0x03;
+  return fsAutocal === 1 ? 'auto' : 'strobe';
+}
+
+/**
+ * Plan the transition between two packed images
+ */
+export function planImageDiff(from: Uint8Array, to: Uint8Array, options: DiffOptions = {}): DiffPlan {
+  const overhead = options.overhead ?? TRANSACTION_OVERHEAD;
+  const changes: FieldChange[] = [];
+  const changedRegisters: number[] = [];
+
+  for (let addr = 0; addr < REGISTER_COUNT; addr++) {
+    if (from[addr] !== to[addr]) {
+      changedRegisters.push(addr);
+      changes.push(...diffRegisterFields(addr, from[addr], to[addr]));
+    }
+  }
+
+  // PATABLE writes always start at index 0, so write up to the last changed entry
+  let lastPaChange = -1;
+  for (let i = 0; i < PA_TABLE_SIZE; i++) {
+    if (from[REGISTER_COUNT + i] !== to[REGISTER_COUNT + i]) lastPaChange = i;
+  }
+  const paTableChanged = lastPaChange >= 0;
+
+  const calibration = calibrationFor(changes, to);
+
+  const ops: ReconfigOp[] = [];
+  if (changedRegisters.length > 0 || paTableChanged) {
+    if (!options.assumeIdle) {
+      ops.push({ op: 'strobe', strobe: 'SIDLE' });
+    }
+    for (const range of coalesceAddresses(changedRegisters, overhead)) {
+      ops.push({
+        op: 'write',
+        addr: range.start,
+        values: Array.from(to.subarray(range.start, range.start + range.length))
+      });
+    }
+    if (paTableChanged) {
+      ops.push({
+        op: 'patable',
+        values: Array.from(to.subarray(REGISTER_COUNT, REGISTER_COUNT + lastPaChange + 1))
+      });
+    }
+    if (calibration === 'strobe') {
+      ops.push({ op: 'strobe', strobe: 'SCAL' });
+    }
+  }
+
+  return {
+    changes,
+    changedRegisters,
+    paTableChanged,
+    calibration,
+    ops,
+    spiBytes: opsByteCost(ops),
+    transactions: ops.length,
+    fullBytes: FULL_REWRITE_BYTES,
+    fullTransactions: FULL_REWRITE_TRANSACTIONS
+  };
+}
+
+/**
+ * Plan the transition between two register maps
+ */
+export function planReconfiguration(
+  fromRegisters: Record<number, number>,
+  fromPaTable: number[],
+  toRegisters: Record<number, number>,
+  toPaTable: number[],
+  options: DiffOptions = {}
+): DiffPlan {
+  return planImageDiff(
+    packImage(fromRegisters, fromPaTable),
+    packImage(toRegisters, toPaTable),
+    options
+  );
+}
+
+/**
+ * SPI bytes (header + data) for a list of operations
+ */
+export function opsByteCost(ops: ReconfigOp[]): number {
+  return ops.reduce((sum, op) => sum + opTransaction(op).length, 0);
+}
+
+/**
+ * Raw SPI bytes of one operation (header followed by data)
+ */
+export function opTransaction(op: ReconfigOp): number[] {
+  switch (op.op) {
+    case 'strobe':
+      return [STROBES[op.strobe]];
+    case 'write':
+      return [writeHeader(op.addr, op.values.length > 1), ...op.values];
+    case 'patable':
+      return [writeHeader(PATABLE_ADDR, op.values.length > 1), ...op.values];
+  }
+}
+
+/**
+ * Human-readable label for an operation
+ */
+export function describeOp(op: ReconfigOp): string {
+  switch (op.op) {
+    case 'strobe':
+      return op.strobe;
+    case 'write': {
+      const first = REGISTER_LAYOUT[op.addr]?.name ?? `0x${toHex(op.addr)}`;
+      if (op.values.length === 1) return first;
+      const lastAddr = op.addr + op.values.length - 1;
+      const last = REGISTER_LAYOUT[lastAddr]?.name ?? `0x${toHex(lastAddr)}`;
+      return `${first}..${last}`;
+    }
+    case 'patable':
+      return `PATABLE[0..${op.values.length - 1}]`;
+  }
+}
+
+/**
+ * Generate C array of length-prefixed SPI transactions
+ * Each entry is a length byte followed by the transaction bytes; a zero length ends the list.
+ */
+export function generateDiffCArray(fromName: string, toName: string, plan: DiffPlan): string {
+  const safeName = `${fromName}_to_${toName}`.replace(/[^a-zA-Z0-9_]/g, '_');
+  let output = `// CC1101 Differential Reconfiguration: ${fromName} -> ${toName}\n`;
+  output += `// Generated by CC1101 Register Editor\n`;
+  output += `// ${plan.changedRegisters.length} registers changed, ${plan.spiBytes} SPI bytes`;
+  output += ` (full rewrite: ${plan.fullBytes})\n`;
+  if (plan.calibration === 'auto') {
+    output += `// Recalibration handled by MCSM0.FS_AUTOCAL on the next RX/TX\n`;
+  }
+  output += `\n${generateOpsTable(safeName, plan.ops)}`;
+  return output;
+}
+
+/**
+ * Generate a C table of length-prefixed SPI transactions
+ */
+export function generateOpsTable(identifier: string, ops: ReconfigOp[]): string {
+  let output = `static const uint8_t ${identifier}[] = {\n`;
+
+  for (const op of ops) {
+    const bytes = opTransaction(op);
+    const hex = [bytes.length, ...bytes].map(b => `0x${toHex(b)}`).join(', ');
+    output += `    ${hex},  // ${describeOp(op)}\n`;
+  }
+
+  output += `    0x00\n};\n`;
+  return output;
+}
+
+/**
+ * Generate JSON op list
+ */
+export function generateDiffJson(plan: DiffPlan): string {
+  return JSON.stringify({
+    changedRegisters: plan.changedRegisters,
+    calibration: plan.calibration,
+    spiBytes: plan.spiBytes,
+    fullBytes: plan.fullBytes,
+    ops: plan.ops
+  }, null, 2);
+}
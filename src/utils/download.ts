@@ -0,0 +1,12 @@
+/**
+ * Browser File Download
+ */
+
+export function downloadFile(data: BlobPart, fileName: string, type = 'text/plain'): void {
+  const url = URL.createObjectURL(new Blob([data], { type }));
+  const link = document.createElement('a');
+  link.href = url;
+  link.download = fileName;
+  link.click();
+  URL.revokeObjectURL(url);
+}
@@ -6,6 +6,8 @@ import {
   generateRawHex,
   parseFlipperPresetData,
   parseRawHex,
+  tokenizeFlipperPresetData,
+  joinFlipperTokens,
 } from '../utils/export';
 
 describe('Export Utilities', () => {
@@ -39,6 +41,38 @@ describe('Export Utilities', () => {
     });
   });
 
+  describe('tokenizeFlipperPresetData', () => {
+    it('produces register, terminator and PA tokens in order', () => {
+      const tokens = tokenizeFlipperPresetData(sampleRegisters, samplePaTable);
+
+      expect(tokens.map(t => t.kind)).toEqual(['register', 'terminator', ...samplePaTable.map(() => 'pa')]);
+    });
+
+    it('joins to the same text as generateFlipperPresetData', () => {
+      const tokens = tokenizeFlipperPresetData(sampleRegisters, samplePaTable);
+
+      expect(joinFlipperTokens(tokens)).toBe(generateFlipperPresetData(sampleRegisters, samplePaTable));
+    });
+
+    it('drops SYNC words when sync mode is disabled', () => {
+      const registers = { 0x04: 0xD3, 0x05: 0x91, 0x12: 0x30 };
+      const tokens = tokenizeFlipperPresetData(registers, samplePaTable);
+
+      expect(tokens.some(t => t.kind === 'register' && t.addr === 0x04)).toBe(false);
+    });
+
+    it('reuses unchanged tokens after a one-byte edit', () => {
+      const before = tokenizeFlipperPresetData({ 0x02: 0x06, 0x03: 0x47 }, samplePaTable);
+      const after = tokenizeFlipperPresetData({ 0x02: 0x06, 0x03: 0x07 }, samplePaTable, before);
+
+      expect(after[0]).toBe(before[0]);
+      expect(after[1]).not.toBe(before[1]);
+      expect(after[1].text).toBe('03 07');
+      expect(after.slice(2)).toEqual(before.slice(2));
+      after.slice(2).forEach((token, i) => expect(token).toBe(before[i + 2]));
+    });
+  });
+
   describe('generateFlipperSettingUser', () => {
     it('generates valid setting_user format', () => {
       const result = generateFlipperSettingUser('TestPreset', sampleRegisters, samplePaTable);
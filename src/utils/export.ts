@@ -3,17 +3,34 @@
  */
 
 import type { ExportFormat } from '../types/cc1101';
-import { CC1101_REGISTERS } from '../data/registers';
+import { REGISTER_LAYOUT } from '../data/registerLayout';
 import { toHex } from './calculations';
+import { generateFieldConfig } from './fieldConfig';
+import { generateSmartRfHeader, generateSmartRfListing } from './smartrf';
+import { generateWakeRestoreCArray } from './wakeRestore';
+
+export type FlipperToken =
+  | { kind: 'register'; key: string; addr: number; value: number; text: string }
+  | { kind: 'terminator'; key: string; text: string }
+  | { kind: 'pa'; key: string; index: number; value: number; text: string };
+
+const TERMINATOR_TOKEN: FlipperToken = { kind: 'terminator', key: 'terminator', text: '00 00' };
 
 /**
- * Generate Flipper Zero Custom_preset_data format
+ * Tokenize Flipper Zero Custom_preset_data.
+ * Tokens whose value is unchanged from `previous` are reused by identity,
+ * so consumers can skip work for everything a one-byte edit did not touch.
  */
-export function generateFlipperPresetData(
+export function tokenizeFlipperPresetData(
   registers: Record<number, number>,
-  paTable: number[]
-): string {
-  const parts: string[] = [];
+  paTable: number[],
+  previous: FlipperToken[] = []
+): FlipperToken[] {
+  const reusable = new Map<string, FlipperToken>();
+  for (const token of previous) {
+    reusable.set(token.key, token);
+  }
+  const tokens: FlipperToken[] = [];
 
   // Check sync mode from MDMCFG2 to determine if SYNC words should be included
   const mdmcfg2 = registers[0x12] ?? 0x13; // Default value
@@ -23,29 +40,62 @@ export function generateFlipperPresetData(
   // Add register address-value pairs (only those meant for Flipper export)
   for (let addr = 0; addr <= 0x2E; addr++) {
     const value = registers[addr];
-    const regDef = CC1101_REGISTERS[addr];
-    
+    const regDef = REGISTER_LAYOUT[addr];
+
     // Skip SYNC1/SYNC0 if sync mode is disabled
     if ((addr === 0x04 || addr === 0x05) && !isSyncEnabled) {
       continue;
     }
-    
+
     // Only include if explicitly marked for Flipper export
     if (value !== undefined && regDef?.flipperExport === true) {
-      parts.push(toHex(addr));
-      parts.push(toHex(value));
+      const key = `reg-${addr}`;
+      const prev = reusable.get(key);
+      tokens.push(prev?.kind === 'register' && prev.value === value
+        ? prev
+        : { kind: 'register', key, addr, value, text: `${toHex(addr)} ${toHex(value)}` });
     }
   }
 
   // Add terminator
-  parts.push('00', '00');
+  tokens.push(TERMINATOR_TOKEN);
 
   // Add PA table
-  paTable.forEach(byte => {
-    parts.push(toHex(byte));
+  paTable.forEach((value, index) => {
+    const key = `pa-${index}`;
+    const prev = reusable.get(key);
+    tokens.push(prev?.kind === 'pa' && prev.value === value
+      ? prev
+      : { kind: 'pa', key, index, value, text: toHex(value) });
   });
 
-  return parts.join(' ');
+  return tokens;
+}
+
+/**
+ * Render a token stream as Custom_preset_data text
+ */
+export function joinFlipperTokens(tokens: FlipperToken[]): string {
+  return tokens.map(token => token.text).join(' ');
+}
+
+/**
+ * Generate Flipper Zero Custom_preset_data format
+ */
+export function generateFlipperPresetData(
+  registers: Record<number, number>,
+  paTable: number[]
+): string {
+  return joinFlipperTokens(tokenizeFlipperPresetData(registers, paTable));
+}
+
+/**
+ * Wrap Custom_preset_data in the setting_user format
+ */
+export function formatFlipperSettingUser(presetName: string, presetData: string): string {
+  return `Custom_preset_name: ${presetName}
+Custom_preset_module: CC1101
+Custom_preset_data: ${presetData}`;
 }
 
 /**
@@ -56,9 +106,18 @@ export function generateFlipperSettingUser(
   registers: Record<number, number>,
   paTable: number[]
 ): string {
-  return `Custom_preset_name: ${presetName}
-Custom_preset_module: CC1101
-Custom_preset_data: ${generateFlipperPresetData(registers, paTable)}`;
+  return formatFlipperSettingUser(presetName, generateFlipperPresetData(registers, paTable));
+}
+
+/**
+ * Generate one setting_user file holding several presets
+ */
+export function generateFlipperSettingUserBatch(
+  presets: { name: string; registers: Record<number, number>; paTable: number[] }[]
+): string {
+  return presets
+    .map(p => generateFlipperSettingUser(p.name, p.registers, p.paTable))
+    .join('\n\n') + '\n';
 }
 
 /**
@@ -76,7 +135,7 @@ export function generateCArray(
 
   for (let addr = 0; addr <= 0x2E; addr++) {
     const value = registers[addr];
-    const reg = CC1101_REGISTERS[addr];
+    const reg = REGISTER_LAYOUT[addr];
     if (value !== undefined && reg) {
       output += `    0x${toHex(value)},  // 0x${toHex(addr)} ${reg.name}\n`;
     }
@@ -120,24 +179,29 @@ export function generateExport(
       return generateCArray(presetName, registers, paTable);
     case 'raw_hex':
       return generateRawHex(registers);
+    case 'wake_restore':
+      return generateWakeRestoreCArray(presetName, registers, paTable);
+    case 'smartrf_listing':
+      return generateSmartRfListing(presetName, registers, paTable);
+    case 'smartrf_header':
+      return generateSmartRfHeader(presetName, registers, paTable);
+    case 'field_config':
+      return generateFieldConfig(presetName, registers, paTable);
     default:
       return '';
   }
 }
 
 /**
- * Parse Flipper Custom_preset_data format
+ * Parse Flipper Custom_preset_data, keeping only the registers it lists
  */
-export function parseFlipperPresetData(
+export function parseFlipperPresetPairs(
   data: string
 ): { registers: Record<number, number>; paTable: number[] } {
   const cleanData = data.replace(/Custom_preset_data:\s*/i, '').trim();
   const bytes = cleanData.split(/\s+/).map(b => parseInt(b, 16));
 
   const registers: Record<number, number> = {};
-  for (let addr = 0; addr <= 0x2E; addr++) {
-    registers[addr] = 0;
-  }
   const paTable: number[] = [];
 
   let i = 0;
@@ -162,6 +226,23 @@ export function parseFlipperPresetData(
   return { registers, paTable };
 }
 
+/**
+ * Parse Flipper Custom_preset_data format
+ */
+export function parseFlipperPresetData(
+  data: string
+): { registers: Record<number, number>; paTable: number[] } {
+  const { registers: listed, paTable } = parseFlipperPresetPairs(data);
+
+  const registers: Record<number, number> = {};
+  for (let addr = 0; addr <= 0x2E; addr++) {
+    registers[addr] = 0;
+  }
+  Object.assign(registers, listed);
+
+  return { registers, paTable };
+}
+
 /**
  * Parse raw hex (just register values in order)
  */
@@ -0,0 +1,26 @@
+// @vitest-environment node
+import { bench, describe } from 'vitest';
+import { PRESETS } from '../data/registers';
+import type { PresetConfig } from '../types/cc1101';
+import { generateFieldConfigFile, parseFieldConfig } from './fieldConfig';
+import { packPresetMap } from './image';
+
+const COUNT = 10_000;
+
+// A 10k-preset repository cycling through the built-in presets
+const entries = Object.entries(PRESETS);
+const { names, images } = packPresetMap(Array.from({ length: COUNT }, (_, i): [string, PresetConfig] => {
+  const [name, preset] = entries[i % entries.length];
+  return [`${name} #${i}`, preset];
+}));
+const text = generateFieldConfigFile({ names, images });
+
+describe('Field config over 10k presets', () => {
+  bench('parse', () => {
+    parseFieldConfig(text);
+  });
+
+  bench('generate', () => {
+    generateFieldConfigFile({ names, images });
+  });
+});
@@ -0,0 +1,105 @@
+import { describe, it, expect } from 'vitest';
+import { PRESETS } from '../data/registers';
+import {
+  compileFieldPath,
+  readPath,
+  writePath,
+  parseFieldConfig,
+  parseFieldConfigPreset,
+  generateFieldConfig,
+  generateFieldConfigFile,
+  isFieldConfig,
+} from '../utils/fieldConfig';
+import { DEFAULT_REGISTERS, packImage, packPresetMap } from '../utils/image';
+import { registersToFrequency } from '../utils/calculations';
+import { generateExport } from '../utils/export';
+import type { PresetConfig } from '../types/cc1101';
+
+describe('Field Config Format', () => {
+  it('compiles field paths to shift and mask', () => {
+    const modFormat = compileFieldPath('mdmcfg2.mod_format');
+
+    expect(modFormat?.parts).toEqual([{ addr: 0x12, shift: 4, mask: 0x07, valueShift: 0 }]);
+    expect(compileFieldPath('MDMCFG2.NOPE')).toBeUndefined();
+  });
+
+  it('writes fields without touching neighbouring bits', () => {
+    const image = packImage({ 0x12: 0x03 }, []);
+    writePath(image, compileFieldPath('MDMCFG2.MOD_FORMAT')!, 1);
+
+    expect(image[0x12]).toBe(0x13);
+    expect(readPath(image, compileFieldPath('MDMCFG2.SYNC_MODE')!)).toBe(3);
+  });
+
+  it('accepts option labels, units and integers', () => {
+    const { registers } = parseFieldConfigPreset(`
+MDMCFG2.MOD_FORMAT = GFSK   # labels are case-insensitive
+MDMCFG4.CHANBW = 270kHz
+FREQ = 433.92 MHz
+MDMCFG4.DRATE_E = 0x0A
+`);
+
+    expect((registers[0x12] >> 4) & 0x07).toBe(1);
+    expect(registers[0x10]).toBe(0x6A);
+    expect(registersToFrequency(registers[0x0D], registers[0x0E], registers[0x0F])).toBeCloseTo(433.92, 3);
+  });
+
+  it('lists only values that differ from defaults', () => {
+    expect(generateFieldConfig('Defaults', {}, [0xC0])).toBe('[Defaults]\n');
+
+    const text = generateFieldConfig('OOK', { 0x12: 0x33 }, [0xC0]);
+    expect(text).toBe('[OOK]\nMDMCFG2.MOD_FORMAT = ASK/OOK\n');
+  });
+
+  it('falls back to a whole-register line for reserved bits', () => {
+    const text = generateFieldConfig('Odd', { 0x07: DEFAULT_REGISTERS[0x07] | 0x10 }, [0xC0]);
+
+    expect(text).toContain('PKTCTRL1 = 0x');
+    expect(parseFieldConfigPreset(text).registers[0x07]).toBe(DEFAULT_REGISTERS[0x07] | 0x10);
+  });
+
+  it('round-trips every built-in preset', () => {
+    for (const [name, preset] of Object.entries(PRESETS)) {
+      const { names, images } = parseFieldConfig(generateFieldConfig(name, preset.registers, preset.paTable));
+
+      expect(names).toEqual([name]);
+      expect(Array.from(images)).toEqual(Array.from(packImage(preset.registers, preset.paTable)));
+    }
+  });
+
+  it('reads a bare FREQ as MHz and rejects carriers outside the bands', () => {
+    const freq = compileFieldPath('FREQ')!;
+
+    expect(freq.parse('433.92')).toBe(freq.parse('433.92MHz'));
+    expect(freq.parse('433920 kHz')).toBe(freq.parse('433.92MHz'));
+    expect(freq.parse('433920000')).toBeNull();
+    expect(freq.parse('500MHz')).toBeNull();
+    expect(() => parseFieldConfig('[A]\nFREQ = 100 Hz\n')).toThrow('Line 2: invalid value "100 Hz" for FREQ');
+  });
+
+  it('reports the failing line', () => {
+    expect(() => parseFieldConfig('[A]\nMDMCFG2.MOD_FORMAT = 8\n')).toThrow('Line 2');
+    expect(() => parseFieldConfig('[A]\n\nMDMCFG9.X = 1\n')).toThrow('Line 3: unknown field MDMCFG9.X');
+  });
+
+  it('parses a 10k-preset repository losslessly', () => {
+    const entries = Object.entries(PRESETS);
+    const { names, images } = packPresetMap(Array.from({ length: 10000 }, (_, i): [string, PresetConfig] => {
+      const [name, preset] = entries[i % entries.length];
+      return [`${name} #${i}`, preset];
+    }));
+    const text = generateFieldConfigFile({ names, images });
+    const parsed = parseFieldConfig(text);
+
+    expect(parsed.names).toHaveLength(10000);
+    expect(Array.from(parsed.images)).toEqual(Array.from(images));
+  });
+
+  it('is detected and exported', () => {
+    const preset = PRESETS['GFSK 9.99kbps (433.92MHz)'];
+    const text = generateExport('field_config', 'G', preset.registers, preset.paTable);
+
+    expect(isFieldConfig(text)).toBe(true);
+    expect(isFieldConfig('02 0D 03 47 00 00 C0')).toBe(false);
+  });
+});
@@ -0,0 +1,393 @@
+/**
+ * Field-Level Config Format
+ *
+ * A reviewable text form of register images. Each preset is a section
+ * listing only what differs from the reset values:
+ *
+ *   [Custom_433]
+ *   FREQ = 433.92MHz
+ *   MDMCFG4.CHANBW = 271kHz
+ *   MDMCFG2.MOD_FORMAT = GFSK
+ *   PKTCTRL0 = 0x32          # whole register when reserved bits differ
+ *   PATABLE = 00 C0 00 00 00 00 00 00
+ *
+ * Field paths are compiled once from the register metadata into
+ * (address, shift, mask) parts; parsing applies writes to packed images.
+ */
+
+import { XOSC_FREQ } from '../data/registers';
+import { REGISTER_LAYOUT } from '../data/registerLayout';
+import { getBandwidthFromRegister, toHex } from './calculations';
+import { createLineSplitter } from './lines';
+import { FREQUENCY_BANDS } from './validate';
+import {
+  DEFAULT_PA_TABLE,
+  DEFAULT_REGISTERS,
+  IMAGE_SIZE,
+  PA_TABLE_SIZE,
+  REGISTER_COUNT,
+  packImage,
+  unpackImage
+} from './image';
+
+export interface FieldPart {
+  addr: number;
+  shift: number;       // Bit position in the register
+  mask: number;        // Unshifted width mask
+  valueShift: number;  // Bit position in the path value
+}
+
+export interface CompiledPath {
+  path: string;
+  parts: FieldPart[];
+  max: number;
+  parse: (text: string) => number | null;
+  format: (value: number) => string;
+}
+
+export interface FieldConfigBank {
+  names: string[];
+  images: Uint8Array; // names.length x IMAGE_SIZE
+}
+
+export interface FieldConfigParser {
+  push: (chunk: string) => void;
+  end: () => FieldConfigBank;
+}
+
+const PATABLE_KEY = 'PATABLE';
+const UNTITLED = 'Untitled';
+
+const DEFAULT_IMAGE = packImage({}, DEFAULT_PA_TABLE);
+
+/**
+ * Parse an integer in decimal, 0x hex or 0b binary
+ */
+function parseInteger(text: string): number | null {
+  if (/^0x[0-9a-f]+$/i.test(text)) return parseInt(text.slice(2), 16);
+  if (/^0b[01]+$/i.test(text)) return parseInt(text.slice(2), 2);
+  if (/^\d+$/.test(text)) return parseInt(text, 10);
+  return null;
+}
+
+/**
+ * Parse a number with an optional unit, scaled to `unit`
+ */
+export function parseQuantity(text: string, unit: 'Hz' | 'kHz' | 'MHz'): number | null {
+  const match = /^(\d+(?:\.\d+)?)\s*(hz|khz|mhz)?$/i.exec(text);
+  if (!match) return null;
+  const scale: Record<string, number> = { hz: 1, khz: 1e3, mhz: 1e6 };
+  const given = scale[(match[2] ?? unit).toLowerCase()];
+  return (parseFloat(match[1]) * given) / scale[unit.toLowerCase()];
+}
+
+function formatInteger(value: number, max: number): string {
+  return max < 16 ? String(value) : `0x${toHex(value)}`;
+}
+
+function compileField(regName: string, addr: number, fieldName: string, bits: number[], options?: Record<number, string>): CompiledPath {
+  const shift = Math.min(...bits);
+  const mask = (1 << bits.length) - 1;
+  const labels = new Map<string, number>();
+  if (options) {
+    for (const [value, label] of Object.entries(options)) {
+      if (!labels.has(label.toLowerCase())) labels.set(label.toLowerCase(), Number(value));
+    }
+  }
+
+  return {
+    path: `${regName}.${fieldName}`,
+    parts: [{ addr, shift, mask, valueShift: 0 }],
+    max: mask,
+    parse: text => labels.get(text.toLowerCase()) ?? parseInteger(text),
+    format: value => options?.[value] ?? formatInteger(value, mask)
+  };
+}
+
+function compileRegister(regName: string, addr: number): CompiledPath {
+  return {
+    path: regName,
+    parts: [{ addr, shift: 0, mask: 0xFF, valueShift: 0 }],
+    max: 0xFF,
+    parse: parseInteger,
+    format: value => `0x${toHex(value)}`
+  };
+}
+
+/**
+ * Whether a carrier lies in one of the CC1101's synthesizer bands
+ */
+export function inFrequencyBand(hz: number): boolean {
+  return FREQUENCY_BANDS.some(([low, high]) => hz >= low * 1e6 && hz <= high * 1e6);
+}
+
+// Carrier frequency across FREQ2[5:0], FREQ1, FREQ0; a bare number is MHz,
+// as in query ranges and predicates
+const FREQUENCY_PATH: CompiledPath = {
+  path: 'FREQ',
+  parts: [
+    { addr: 0x0D, shift: 0, mask: 0x3F, valueShift: 16 },
+    { addr: 0x0E, shift: 0, mask: 0xFF, valueShift: 8 },
+    { addr: 0x0F, shift: 0, mask: 0xFF, valueShift: 0 }
+  ],
+  max: 0x3FFFFF,
+  parse: text => {
+    const mhz = parseQuantity(text, 'MHz');
+    if (mhz === null || !inFrequencyBand(mhz * 1e6)) return null;
+    return Math.round((mhz * 1e6 * 65536) / XOSC_FREQ);
+  },
+  format: value => `${parseFloat(((value * XOSC_FREQ) / 65536 / 1e6).toFixed(6))}MHz`
+};
+
+// Channel filter bandwidth: CHANBW_E and CHANBW_M as one value, parsed to the nearest setting
+const CHANBW_KHZ = Array.from({ length: 16 }, (_, code) => getBandwidthFromRegister(code << 4));
+const CHANBW_PATH: CompiledPath = {
+  path: 'MDMCFG4.CHANBW',
+  parts: [{ addr: 0x10, shift: 4, mask: 0x0F, valueShift: 0 }],
+  max: 0x0F,
+  parse: text => {
+    const khz = parseQuantity(text, 'kHz');
+    if (khz === null) return null;
+    let best = 0;
+    CHANBW_KHZ.forEach((bw, code) => {
+      if (Math.abs(bw - khz) < Math.abs(CHANBW_KHZ[best] - khz)) best = code;
+    });
+    return best;
+  },
+  format: value => `${CHANBW_KHZ[value]}kHz`
+};
+
+// Fields rendered through a composite path instead of individually
+const COMPOSITE_FIELDS = new Set([
+  'FREQ2.FREQ[21:16]', 'FREQ1.FREQ[15:8]', 'FREQ0.FREQ[7:0]',
+  'MDMCFG4.CHANBW_E', 'MDMCFG4.CHANBW_M'
+]);
+
+// Per register: the paths used when writing a config, in output order
+const OUTPUT_PATHS: CompiledPath[][] = [];
+
+// Every accepted path, upper-cased
+const PATHS: Map<string, CompiledPath> = (() => {
+  const paths = new Map<string, CompiledPath>();
+  for (let addr = 0; addr < REGISTER_COUNT; addr++) {
+    const reg = REGISTER_LAYOUT[addr];
+    const output: CompiledPath[] = [];
+    if (addr === 0x0D) output.push(FREQUENCY_PATH);
+    if (addr === 0x10) output.push(CHANBW_PATH);
+    if (reg) {
+      paths.set(reg.name, compileRegister(reg.name, addr));
+      for (const field of reg.fields) {
+        const compiled = compileField(reg.name, addr, field.name, field.bits, field.options);
+        paths.set(compiled.path.toUpperCase(), compiled);
+        if (!COMPOSITE_FIELDS.has(compiled.path)) output.push(compiled);
+      }
+    }
+    OUTPUT_PATHS.push(output);
+  }
+  paths.set(FREQUENCY_PATH.path, FREQUENCY_PATH);
+  paths.set(CHANBW_PATH.path, CHANBW_PATH);
+  return paths;
+})();
+
+// Bits of each register covered by at least one field
+const FIELD_COVERAGE: Uint8Array = (() => {
+  const coverage = new Uint8Array(REGISTER_COUNT);
+  for (let addr = 0; addr < REGISTER_COUNT; addr++) {
+    for (const field of REGISTER_LAYOUT[addr]?.fields ?? []) {
+      for (const bit of field.bits) coverage[addr] |= 1 << bit;
+    }
+  }
+  return coverage;
+})();
+
+/**
+ * Look up a compiled field path, e.g. "MDMCFG2.MOD_FORMAT", "FREQ", "PKTCTRL0"
+ */
+export function compileFieldPath(path: string): CompiledPath | undefined {
+  return PATHS.get(path.trim().toUpperCase());
+}
+
+/**
+ * Read a path value from a packed image
+ */
+export function readPath(image: Uint8Array, compiled: CompiledPath, offset = 0): number {
+  let value = 0;
+  for (const part of compiled.parts) {
+    value |= ((image[offset + part.addr] >> part.shift) & part.mask) << part.valueShift;
+  }
+  return value;
+}
+
+/**
+ * Write a path value into a packed image
+ */
+export function writePath(image: Uint8Array, compiled: CompiledPath, value: number, offset = 0): void {
+  for (const part of compiled.parts) {
+    const i = offset + part.addr;
+    image[i] = (image[i] & ~(part.mask << part.shift)) | (((value >>> part.valueShift) & part.mask) << part.shift);
+  }
+}
+
+/**
+ * Create an incremental config parser; errors carry the line number
+ */
+export function createFieldConfigParser(): FieldConfigParser {
+  const names: string[] = [];
+  let images = new Uint8Array(IMAGE_SIZE * 16);
+  let current = -1;
+  let lineNumber = 0;
+
+  const startPreset = (name: string) => {
+    current = names.length;
+    names.push(name);
+    if ((current + 1) * IMAGE_SIZE > images.length) {
+      const grown = new Uint8Array(images.length * 2);
+      grown.set(images);
+      images = grown;
+    }
+    images.set(DEFAULT_IMAGE, current * IMAGE_SIZE);
+  };
+
+  const fail = (message: string): never => {
+    throw new Error(`Line ${lineNumber}: ${message}`);
+  };
+
+  const onLine = (raw: string) => {
+    lineNumber++;
+    const trimmed = raw.trim();
+    if (trimmed.charCodeAt(0) === 91) { // [name], which may itself contain '#'
+      const close = trimmed.lastIndexOf(']');
+      if (close === -1) fail('unterminated section name');
+      startPreset(trimmed.slice(1, close).trim());
+      return;
+    }
+
+    const hash = trimmed.indexOf('#');
+    const line = hash === -1 ? trimmed : trimmed.slice(0, hash).trimEnd();
+    if (line.length === 0) return;
+
+    const eq = line.indexOf('=');
+    if (eq === -1) fail(`expected PATH = VALUE, got "${line}"`);
+    const key = line.slice(0, eq).trim().toUpperCase();
+    const text = line.slice(eq + 1).trim();
+    if (current === -1) startPreset(UNTITLED);
+    const offset = current * IMAGE_SIZE;
+
+    if (key === PATABLE_KEY) {
+      const bytes = text.split(/[\s,]+/).filter(Boolean);
+      if (bytes.length > PA_TABLE_SIZE) fail(`PATABLE has ${bytes.length} entries, at most ${PA_TABLE_SIZE}`);
+      for (let i = 0; i < PA_TABLE_SIZE; i++) {
+        const value = i < bytes.length ? parseInt(bytes[i].replace(/^0x/i, ''), 16) : 0;
+        if (!(value >= 0 && value <= 0xFF)) fail(`invalid PATABLE byte "${bytes[i]}"`);
+        images[offset + REGISTER_COUNT + i] = value;
+      }
+      return;
+    }
+
+    const compiled = PATHS.get(key);
+    if (!compiled) return fail(`unknown field ${key}`);
+    const value = compiled.parse(text);
+    if (value === null || value < 0 || value > compiled.max) {
+      fail(`invalid value "${text}" for ${compiled.path}`);
+    }
+    writePath(images, compiled, value as number, offset);
+  };
+
+  const splitter = createLineSplitter(onLine);
+
+  return {
+    push: splitter.push,
+    end() {
+      splitter.end();
+      return { names, images: images.slice(0, names.length * IMAGE_SIZE) };
+    }
+  };
+}
+
+/**
+ * Parse a complete config file into packed images
+ */
+export function parseFieldConfig(text: string): FieldConfigBank {
+  const parser = createFieldConfigParser();
+  parser.push(text);
+  return parser.end();
+}
+
+/**
+ * Parse the first preset of a config, for the import box
+ */
+export function parseFieldConfigPreset(
+  text: string
+): { name: string; registers: Record<number, number>; paTable: number[] } {
+  const { names, images } = parseFieldConfig(text);
+  if (names.length === 0) throw new Error('No settings found');
+  return { name: names[0], ...unpackImage(images) };
+}
+
+/**
+ * Quick check used to route pasted text to this importer
+ */
+export function isFieldConfig(text: string): boolean {
+  return /^\s*(\[[^\]\n]*\]\s*$|[A-Z][A-Z0-9_]*(\.[A-Z0-9_[\]:]+)?\s*=)/m.test(text);
+}
+
+/**
+ * Render the body of one preset section from a packed image
+ */
+export function formatFieldConfigImage(image: Uint8Array, offset = 0): string[] {
+  const lines: string[] = [];
+
+  for (let addr = 0; addr < REGISTER_COUNT; addr++) {
+    const value = image[offset + addr];
+    const reg = REGISTER_LAYOUT[addr];
+    if (!reg) continue;
+
+    for (const compiled of OUTPUT_PATHS[addr]) {
+      // Composites start here but may span later registers
+      const current = readPath(image, compiled, offset);
+      if (compiled.parts.length > 1 || compiled === CHANBW_PATH) {
+        if (current !== readPath(DEFAULT_IMAGE, compiled)) {
+          lines.push(`${compiled.path} = ${compiled.format(current)}`);
+        }
+        continue;
+      }
+      if (value === DEFAULT_REGISTERS[addr]) break;
+      if (((value ^ DEFAULT_REGISTERS[addr]) & ~FIELD_COVERAGE[addr] & 0xFF) !== 0) {
+        lines.push(`${reg.name} = 0x${toHex(value)}`);
+        break;
+      }
+      if (current !== readPath(DEFAULT_IMAGE, compiled)) {
+        lines.push(`${compiled.path} = ${compiled.format(current)}`);
+      }
+    }
+  }
+
+  const paStart = offset + REGISTER_COUNT;
+  const pa = image.subarray(paStart, paStart + PA_TABLE_SIZE);
+  if (pa.some((b, i) => b !== DEFAULT_PA_TABLE[i])) {
+    lines.push(`${PATABLE_KEY} = ${Array.from(pa, b => toHex(b)).join(' ')}`);
+  }
+
+  return lines;
+}
+
+/**
+ * Generate a field-level config section for one preset
+ */
+export function generateFieldConfig(
+  presetName: string,
+  registers: Record<number, number>,
+  paTable: number[]
+): string {
+  const image = packImage(registers, paTable.length > 0 ? paTable : DEFAULT_PA_TABLE);
+  return `[${presetName}]\n${formatFieldConfigImage(image).map(line => line + '\n').join('')}`;
+}
+
+/**
+ * Generate a config file holding every image of a bank
+ */
+export function generateFieldConfigFile(bank: FieldConfigBank): string {
+  return bank.names
+    .map((name, i) => `[${name}]\n${formatFieldConfigImage(bank.images, i * IMAGE_SIZE).map(line => line + '\n').join('')}`)
+    .join('\n');
+}
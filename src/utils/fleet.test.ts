@@ -0,0 +1,64 @@
+// @vitest-environment node
+import { describe, it, expect } from 'vitest';
+import { PA_TABLES } from '../data/registers';
+import { compileFieldPath, parseFieldConfig, readPath } from './fieldConfig';
+import { buildFleet, createCsvRow, csvField, csvNumber, splitCsvLine } from './fleet';
+import { IMAGE_SIZE, REGISTER_COUNT } from './image';
+
+const TEMPLATE = `
+[Unit {serial} ch{channel}]
+MDMCFG2.MOD_FORMAT = GFSK
+FREQ = 433.92MHz + {offset} kHz   # trimmed per unit
+CHANNR = {channel}
+POWER = {power} dBm
+`;
+
+describe('Fleet Preset Templates', () => {
+  it('splits CSV lines in place', () => {
+    const row = splitCsvLine(' a , "b, ""c""",, -1.25,0x1F', createCsvRow(2));
+    expect(row.count).toBe(5);
+    expect([0, 1, 2, 3, 4].map(i => csvField(row, i))).toEqual(['a', 'b, "c"', '', '-1.25', '0x1F']);
+    expect([3, 4].map(i => csvNumber(row, i))).toEqual([-1.25, 31]);
+    expect([0, 2, 5].map(i => csvNumber(row, i))).toEqual([NaN, NaN, NaN]);
+    expect(csvNumber(splitCsvLine('433.92', row), 0)).toBe(parseFloat('433.92'));
+  });
+
+  it('writes bound fields over the static image', () => {
+    const bank = buildFleet(TEMPLATE, 'serial,offset,channel,power\nA1,-12.5,3,10\n\nA2,0,200,-30\n');
+    expect(bank.names).toEqual(['Unit A1 ch3', 'Unit A2 ch200']);
+
+    const expected = parseFieldConfig(
+      '[A1]\nMDMCFG2.MOD_FORMAT = GFSK\nFREQ = 433907500Hz\nCHANNR = 3\nPATABLE = ' +
+      PA_TABLES['433MHz']['+10dBm'].map(value => value.toString(16)).join(' ') + '\n' +
+      '[A2]\nMDMCFG2.MOD_FORMAT = GFSK\nFREQ = 433.92MHz\nCHANNR = 200\nPATABLE = 12'
+    );
+    expect(bank.images).toEqual(expected.images);
+  });
+
+  it('binds absolute frequencies, labels and the PA_POWER slot', () => {
+    const template = 'FREND0.PA_POWER = 1\nFREQ = {mhz} MHz\nMDMCFG2.MOD_FORMAT = {mod}\nPOWER = {dbm}\n';
+    const bank = buildFleet(template, 'name,mhz,mod,dbm\n"x, 1",868.3,ASK/OOK,0\nx2,315,0x1,-9\n');
+    const freq = compileFieldPath('FREQ')!;
+    const format = compileFieldPath('MDMCFG2.MOD_FORMAT')!;
+
+    expect(bank.names).toEqual(['x, 1', 'x2']);
+    expect(freq.format(readPath(bank.images, freq))).toBe('868.299866MHz');
+    expect(readPath(bank.images, format)).toBe(3);
+    expect(readPath(bank.images, format, IMAGE_SIZE)).toBe(1);
+    // Nearest level in each unit's band, in PATABLE[1]
+    expect(bank.images[REGISTER_COUNT + 1]).toBe(PA_TABLES['868MHz']['0dBm'][0]);
+    expect(bank.images[IMAGE_SIZE + REGISTER_COUNT + 1]).toBe(PA_TABLES['315MHz']['-10dBm'][0]);
+  });
+
+  it('reports template lines and CSV lines', () => {
+    expect(() => buildFleet('CHANNR = {chan}', 'name,channel\n')).toThrow('Line 1: unknown column "chan"; the CSV has name, channel');
+    expect(() => buildFleet('[a]\n[b]', 'name\n')).toThrow('Line 2: a template holds a single section');
+    expect(() => buildFleet('\nMDMCFG2 = 1 + {x}', 'x\n')).toThrow('Line 2: unsupported binding');
+    expect(() => buildFleet('\n\nFOO = 1', 'name\n')).toThrow('Line 3: unknown field FOO');
+    expect(() => buildFleet('CHANNR = 1', 'serial\n')).toThrow('Template: unknown column "name"');
+    expect(() => buildFleet('CHANNR = {c}', 'name,c\na,1\nb,256\n')).toThrow('Line 3: invalid c "256" for CHANNR');
+    expect(() => buildFleet('FREQ = 433.92MHz - {o} kHz', 'name,o\na,x\n')).toThrow('Line 2: invalid o "x" for FREQ');
+    // Bare base frequencies are MHz; carriers outside the bands are rejected
+    expect(() => buildFleet('FREQ = 433.92 + {o} MHz', 'name,o\na,0\nb,100\n')).toThrow('Line 3: invalid o "100" for FREQ');
+  });
+});
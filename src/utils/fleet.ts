@@ -0,0 +1,411 @@
+/**
+ * Fleet Preset Templates
+ *
+ * Builds one preset per device from a template and a CSV of per-unit
+ * parameters. A template is a field config section whose name and values
+ * may refer to CSV columns:
+ *
+ *   [Unit {serial}]
+ *   MDMCFG2.MOD_FORMAT = GFSK
+ *   FREQ = 433.92MHz + {offset} kHz   # trimmed frequency offset
+ *   CHANNR = {channel}
+ *   POWER = {power} dBm               # nearest PA table entry for the band
+ *
+ * Static lines are parsed once into a base image. Each binding compiles to
+ * a closure that parses its cell in place and writes the affected register
+ * bits, so building a unit is one image copy plus the bound writes.
+ */
+
+import { PA_TABLES, XOSC_FREQ } from '../data/registers';
+import { compileFieldPath, inFrequencyBand, parseFieldConfig, parseQuantity, writePath } from './fieldConfig';
+import type { CompiledPath, FieldConfigBank } from './fieldConfig';
+import { DEFAULT_PA_TABLE, IMAGE_SIZE, REGISTER_COUNT, packImage } from './image';
+
+/** One CSV line split in place: field i is line.slice(starts[i], ends[i]) */
+export interface CsvRow {
+  line: string;
+  count: number;
+  starts: Int32Array;
+  ends: Int32Array;
+  escaped: Uint8Array; // Quoted field containing "" escapes
+}
+
+export interface FleetTemplate {
+  columns: string[]; // CSV columns the template reads
+  /** Build one unit into `image` at `offset`; returns the preset name */
+  write: (row: CsvRow, image: Uint8Array, offset?: number) => string;
+}
+
+type Writer = (row: CsvRow, image: Uint8Array, offset: number) => void;
+
+const QUOTE = 34;
+const SPACE = 32;
+const TAB = 9;
+
+const FREND0 = 0x22;
+const PA_POWER_MASK = 0x07;
+const UNIT_SCALE: Record<string, number> = { hz: 1, khz: 1e3, mhz: 1e6 };
+const DEFAULT_IMAGE = packImage({}, DEFAULT_PA_TABLE);
+
+/**
+ * Row buffer for splitCsvLine; grows to the widest line seen
+ */
+export function createCsvRow(capacity = 16): CsvRow {
+  return {
+    line: '',
+    count: 0,
+    starts: new Int32Array(capacity),
+    ends: new Int32Array(capacity),
+    escaped: new Uint8Array(capacity)
+  };
+}
+
+function growRow(row: CsvRow): void {
+  const starts = new Int32Array(row.starts.length * 2);
+  const ends = new Int32Array(row.ends.length * 2);
+  const escaped = new Uint8Array(row.escaped.length * 2);
+  starts.set(row.starts);
+  ends.set(row.ends);
+  escaped.set(row.escaped);
+  row.starts = starts;
+  row.ends = ends;
+  row.escaped = escaped;
+}
+
+function isBlank(code: number): boolean {
+  return code === SPACE || code === TAB;
+}
+
+/**
+ * Split a CSV line into `row` without copying fields. Unquoted fields are
+ * trimmed; quoted fields may contain commas and "" escapes.
+ */
+export function splitCsvLine(line: string, row: CsvRow): CsvRow {
+  const length = line.length;
+  let i = 0;
+  let count = 0;
+  row.line = line;
+
+  for (;;) {
+    if (count === row.starts.length) growRow(row);
+    while (i < length && isBlank(line.charCodeAt(i))) i++;
+
+    let start = i;
+    let end: number;
+    let escaped = 0;
+    if (line.charCodeAt(i) === QUOTE) {
+      start = ++i;
+      while (i < length) {
+        if (line.charCodeAt(i) === QUOTE) {
+          if (line.charCodeAt(i + 1) !== QUOTE) break;
+          escaped = 1;
+          i++;
+        }
+        i++;
+      }
+      end = i;
+      i = line.indexOf(',', i);
+    } else {
+      i = line.indexOf(',', i);
+      end = i === -1 ? length : i;
+      while (end > start && isBlank(line.charCodeAt(end - 1))) end--;
+    }
+
+    row.starts[count] = start;
+    row.ends[count] = end;
+    row.escaped[count] = escaped;
+    count++;
+    if (i === -1) break;
+    i++; // Past the comma
+  }
+
+  row.count = count;
+  return row;
+}
+
+/**
+ * Text of field i, or '' past the end of the row
+ */
+export function csvField(row: CsvRow, i: number): string {
+  if (i >= row.count) return '';
+  const text = row.line.slice(row.starts[i], row.ends[i]);
+  return row.escaped[i] ? text.replace(/""/g, '"') : text;
+}
+
+/**
+ * Field i as a decimal or 0x hex number, scanned in place; NaN otherwise
+ */
+export function csvNumber(row: CsvRow, i: number): number {
+  if (i >= row.count) return NaN;
+  const line = row.line;
+  const end = row.ends[i];
+  let p = row.starts[i];
+
+  let sign = 1;
+  const first = line.charCodeAt(p);
+  if (first === 45 || first === 43) { // - +
+    if (first === 45) sign = -1;
+    p++;
+  }
+
+  if (line.charCodeAt(p) === 48 && (line.charCodeAt(p + 1) | 0x20) === 120) { // 0x
+    let value = 0;
+    p += 2;
+    if (p === end) return NaN;
+    for (; p < end; p++) {
+      const c = line.charCodeAt(p) | 0x20;
+      const digit = c >= 48 && c <= 57 ? c - 48 : c >= 97 && c <= 102 ? c - 87 : -1;
+      if (digit < 0) return NaN;
+      value = value * 16 + digit;
+    }
+    return sign * value;
+  }
+
+  // Digits as one integer, divided once by the fraction's power of ten,
+  // which rounds the same way as parseFloat
+  let mantissa = 0;
+  let digits = 0;
+  let scale = 1;
+  let fraction = false;
+  for (; p < end; p++) {
+    const c = line.charCodeAt(p);
+    if (c >= 48 && c <= 57) {
+      mantissa = mantissa * 10 + (c - 48);
+      digits++;
+      if (fraction) scale *= 10;
+    } else if (c === 46 && !fraction) {
+      fraction = true;
+    } else {
+      return NaN;
+    }
+  }
+  return digits === 0 ? NaN : (sign * mantissa) / scale;
+}
+
+/**
+ * Paths that take plain integers (registers and fields), as opposed to
+ * quantities such as FREQ and MDMCFG4.CHANBW
+ */
+function takesIntegers(compiled: CompiledPath): boolean {
+  return compiled.parse('1') === 1 && compiled.parse('0x2') === 2;
+}
+
+/**
+ * Closure storing a range-checked value into the path's register bits
+ */
+function compileStore(compiled: CompiledPath): (image: Uint8Array, offset: number, value: number) => void {
+  if (compiled.parts.length !== 1) {
+    return (image, offset, value) => writePath(image, compiled, value, offset);
+  }
+  const { addr, shift, mask } = compiled.parts[0];
+  const keep = ~(mask << shift) & 0xFF;
+  return (image, offset, value) => {
+    const i = offset + addr;
+    image[i] = (image[i] & keep) | (value << shift);
+  };
+}
+
+// PA table byte per band, ordered as in PA_TABLES
+interface PowerLevels {
+  dBm: number[];
+  values: number[];
+}
+
+const POWER_BANDS: PowerLevels[] = ['315MHz', '433MHz', '868MHz', '915MHz'].map(band => ({
+  dBm: Object.keys(PA_TABLES[band]).map(level => parseInt(level)),
+  values: Object.values(PA_TABLES[band]).map(table => table[0])
+}));
+
+// FREQ words where the 433, 868 and 915 MHz bands start (as in getPaTable)
+const BAND_WORDS = [350e6, 500e6, 900e6].map(hz => (hz * 65536) / XOSC_FREQ);
+
+/**
+ * PA setting nearest `dBm` for the carrier in FREQ2..FREQ0
+ */
+function powerFor(image: Uint8Array, offset: number, dBm: number): number {
+  const word = ((image[offset + 0x0D] & 0x3F) << 16) | (image[offset + 0x0E] << 8) | image[offset + 0x0F];
+  let band = 0;
+  while (band < BAND_WORDS.length && word >= BAND_WORDS[band]) band++;
+
+  const levels = POWER_BANDS[band];
+  let best = 0;
+  for (let i = 1; i < levels.dBm.length; i++) {
+    if (Math.abs(levels.dBm[i] - dBm) < Math.abs(levels.dBm[best] - dBm)) best = i;
+  }
+  return levels.values[best];
+}
+
+const PLACEHOLDER = /\{(\w+)\}/g;
+const COLUMN = /^\{(\w+)\}$/;
+const COLUMN_WITH_UNIT = /^\{(\w+)\}\s*(hz|khz|mhz|dbm)$/i;
+const OFFSET = /^(.+?)\s*([+-])\s*\{(\w+)\}\s*(hz|khz|mhz)?$/i;
+
+/**
+ * Compile a template against the CSV header. Template errors carry the
+ * template line number; unit errors thrown by `write` name the column.
+ */
+export function compileFleetTemplate(text: string, header: string[]): FleetTemplate {
+  const lookup = new Map(header.map((column, i) => [column.trim().toLowerCase(), i]));
+  const used: string[] = [];
+  const writers: Writer[] = [];
+  const powerWriters: Writer[] = []; // Run last: they read FREQ and FREND0
+  const staticLines: string[] = [];
+  let pattern: string | null = null;
+  let lineNumber = 0;
+
+  let patternLine = 0;
+
+  const fail = (message: string): never => {
+    throw new Error(lineNumber > 0 ? `Line ${lineNumber}: ${message}` : `Template: ${message}`);
+  };
+  const column = (name: string): number => {
+    const index = lookup.get(name.toLowerCase());
+    if (index === undefined) fail(`unknown column "${name}"; the CSV has ${header.join(', ')}`);
+    if (!used.includes(header[index!])) used.push(header[index!]);
+    return index!;
+  };
+  const invalid = (row: CsvRow, index: number, target: string): never => {
+    throw new Error(`invalid ${header[index]} "${csvField(row, index)}" for ${target}`);
+  };
+
+  const bindFrequency = (index: number, baseHz: number, scale: number) => {
+    const store = compileStore(compileFieldPath('FREQ')!);
+    writers.push((row, image, offset) => {
+      const hz = baseHz + csvNumber(row, index) * scale;
+      if (!inFrequencyBand(hz)) invalid(row, index, 'FREQ'); // Also NaN
+      store(image, offset, Math.round((hz * 65536) / XOSC_FREQ));
+    });
+  };
+
+  const bindPath = (compiled: CompiledPath, index: number) => {
+    const store = compileStore(compiled);
+    const integers = takesIntegers(compiled);
+    writers.push((row, image, offset) => {
+      let value = integers ? csvNumber(row, index) : NaN;
+      if (Number.isNaN(value)) value = compiled.parse(csvField(row, index)) ?? NaN; // Option labels, quantities
+      if (!(Number.isInteger(value) && value >= 0 && value <= compiled.max)) invalid(row, index, compiled.path);
+      store(image, offset, value);
+    });
+  };
+
+  const bindPower = (index: number) => {
+    powerWriters.push((row, image, offset) => {
+      const dBm = csvNumber(row, index);
+      if (Number.isNaN(dBm)) invalid(row, index, 'POWER');
+      image[offset + REGISTER_COUNT + (image[offset + FREND0] & PA_POWER_MASK)] = powerFor(image, offset, dBm);
+    });
+  };
+
+  for (const raw of text.split(/\r?\n/)) {
+    lineNumber++;
+    const trimmed = raw.trim();
+    if (trimmed.charCodeAt(0) === 91) { // [name pattern]
+      const close = trimmed.lastIndexOf(']');
+      if (close === -1) fail('unterminated section name');
+      if (pattern !== null) fail('a template holds a single section');
+      pattern = trimmed.slice(1, close).trim();
+      patternLine = lineNumber;
+      staticLines.push('');
+      continue;
+    }
+
+    const hash = trimmed.indexOf('#');
+    const line = hash === -1 ? trimmed : trimmed.slice(0, hash).trimEnd();
+    const eq = line.indexOf('=');
+    if (eq === -1 || !line.includes('{')) {
+      staticLines.push(raw); // Left to the field config parser, errors included
+      continue;
+    }
+    staticLines.push('');
+
+    const key = line.slice(0, eq).trim().toUpperCase();
+    const value = line.slice(eq + 1).trim();
+    let match: RegExpExecArray | null;
+    if (key === 'POWER') {
+      match = COLUMN.exec(value) ?? COLUMN_WITH_UNIT.exec(value);
+      if (!match || (match[2] && match[2].toLowerCase() !== 'dbm')) fail(`expected POWER = {column} dBm, got "${value}"`);
+      bindPower(column(match![1]));
+      continue;
+    }
+
+    const compiled = compileFieldPath(key);
+    if (!compiled) fail(`unknown field ${key}`);
+    if ((match = COLUMN.exec(value))) {
+      bindPath(compiled!, column(match[1]));
+    } else if (compiled!.path === 'FREQ' && (match = COLUMN_WITH_UNIT.exec(value)) && match[2].toLowerCase() !== 'dbm') {
+      bindFrequency(column(match[1]), 0, UNIT_SCALE[match[2].toLowerCase()]);
+    } else if (compiled!.path === 'FREQ' && (match = OFFSET.exec(value))) {
+      const baseMHz = parseQuantity(match[1], 'MHz'); // Bare numbers are MHz, as for FREQ
+      if (baseMHz === null) fail(`invalid base frequency "${match[1]}"`);
+      const scale = UNIT_SCALE[(match[4] ?? 'Hz').toLowerCase()];
+      bindFrequency(column(match[3]), baseMHz! * 1e6, match[2] === '-' ? -scale : scale);
+    } else {
+      fail(`unsupported binding "${value}" for ${compiled!.path}; ` +
+        'expected {column}, or for FREQ {column} MHz or BASE + {column} kHz');
+    }
+  }
+
+  const base = parseFieldConfig(staticLines.join('\n'));
+  const baseImage = base.names.length > 0 ? base.images.subarray(0, IMAGE_SIZE) : DEFAULT_IMAGE;
+
+  // Name pattern: literal text between column placeholders
+  lineNumber = patternLine; // The default {name} has no line
+  const literals: string[] = [];
+  const nameColumns: number[] = [];
+  let last = 0;
+  const source = pattern ?? '{name}';
+  for (const match of source.matchAll(PLACEHOLDER)) {
+    literals.push(source.slice(last, match.index));
+    nameColumns.push(column(match[1]));
+    last = match.index! + match[0].length;
+  }
+  literals.push(source.slice(last));
+
+  let name: (row: CsvRow) => string;
+  if (nameColumns.length === 1 && literals[0] === '' && literals[1] === '') {
+    const index = nameColumns[0];
+    name = row => csvField(row, index);
+  } else {
+    name = row => {
+      let text = literals[0];
+      for (let i = 0; i < nameColumns.length; i++) text += csvField(row, nameColumns[i]) + literals[i + 1];
+      return text;
+    };
+  }
+
+  const all = writers.concat(powerWriters);
+  return {
+    columns: used,
+    write(row, image, offset = 0) {
+      image.set(baseImage, offset);
+      for (let i = 0; i < all.length; i++) all[i](row, image, offset);
+      return name(row);
+    }
+  };
+}
+
+/**
+ * Build every unit of a CSV (header line first) into one bank; errors
+ * carry the CSV line number
+ */
+export function buildFleet(template: string, csv: string): FieldConfigBank {
+  const lines = csv.split(/\r?\n/);
+  const headerLine = lines.findIndex(line => line.trim().length > 0);
+  if (headerLine === -1) throw new Error('CSV has no header row');
+
+  const row = createCsvRow();
+  splitCsvLine(lines[headerLine], row);
+  const compiled = compileFleetTemplate(template, Array.from({ length: row.count }, (_, i) => csvField(row, i)));
+
+  const names: string[] = [];
+  const images = new Uint8Array((lines.length - headerLine - 1) * IMAGE_SIZE);
+  for (let i = headerLine + 1; i < lines.length; i++) {
+    if (lines[i].trim().length === 0) continue;
+    try {
+      names.push(compiled.write(splitCsvLine(lines[i], row), images, names.length * IMAGE_SIZE));
+    } catch (err) {
+      throw new Error(`Line ${i + 1}: ${(err as Error).message}`);
+    }
+  }
+  return { names, images: images.slice(0, names.length * IMAGE_SIZE) };
+}
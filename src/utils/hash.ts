@@ -0,0 +1,51 @@
+/**
+ * Checksums and Content Hashes
+ */
+
+const CRC32_TABLE: Uint32Array = (() => {
+  const table = new Uint32Array(256);
+  for (let n = 0; n < 256; n++) {
+    let c = n;
+    for (let k = 0; k < 8; k++) {
+      c = c & 1 ? 0xEDB88320 ^ (c >>> 1) : c >>> 1;
+    }
+    table[n] = c >>> 0;
+  }
+  return table;
+})();
+
+/**
+ * CRC-32 (IEEE 802.3), same as zlib/PNG
+ */
+export function crc32(bytes: Uint8Array, start = 0, end = bytes.length): number {
+  let crc = 0xFFFFFFFF;
+  for (let i = start; i < end; i++) {
+    crc = CRC32_TABLE[(crc ^ bytes[i]) & 0xFF] ^ (crc >>> 8);
+  }
+  return (crc ^ 0xFFFFFFFF) >>> 0;
+}
+
+function fmix32(h: number): number {
+  h ^= h >>> 16;
+  h = Math.imul(h, 0x85EBCA6B);
+  h ^= h >>> 13;
+  h = Math.imul(h, 0xC2B2AE35);
+  h ^= h >>> 16;
+  return h >>> 0;
+}
+
+/**
+ * Stable 64-bit content hash as 16 hex digits.
+ * Two independent 32-bit lanes (FNV-1a and a multiply-rotate lane), each avalanched.
+ */
+export function fingerprint64(bytes: Uint8Array, start = 0, end = bytes.length): string {
+  let h1 = 0x811C9DC5;
+  let h2 = 0x9747B28C ^ (end - start);
+  for (let i = start; i < end; i++) {
+    const b = bytes[i];
+    h1 = Math.imul(h1 ^ b, 0x01000193);
+    h2 = Math.imul(h2 ^ b, 0x5BD1E995);
+    h2 = (h2 << 13) | (h2 >>> 19);
+  }
+  return fmix32(h1).toString(16).padStart(8, '0') + fmix32(h2).toString(16).padStart(8, '0');
+}
@@ -0,0 +1,82 @@
+/**
+ * Packed Register Image Helpers
+ *
+ * A register image is a flat byte array: 47 register values (0x00 - 0x2E)
+ * followed by the 8-byte PA table.
+ */
+
+import { REGISTER_LAYOUT } from '../data/registerLayout';
+import type { PresetConfig } from '../types/cc1101';
+import type { FieldConfigBank } from './fieldConfig';
+
+type PackablePreset = Pick<PresetConfig, 'registers' | 'paTable'>;
+
+export const REGISTER_COUNT = 0x2F;
+export const PA_TABLE_SIZE = 8;
+export const IMAGE_SIZE = REGISTER_COUNT + PA_TABLE_SIZE;
+
+/**
+ * Chip reset values for every register address
+ */
+export const DEFAULT_REGISTERS: Uint8Array = (() => {
+  const defaults = new Uint8Array(REGISTER_COUNT);
+  for (let addr = 0; addr < REGISTER_COUNT; addr++) {
+    defaults[addr] = REGISTER_LAYOUT[addr]?.default ?? 0;
+  }
+  return defaults;
+})();
+
+/**
+ * PA table the editor starts from
+ */
+export const DEFAULT_PA_TABLE = [0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00];
+
+/**
+ * Pack a register map and PA table into an image.
+ * Missing registers fall back to their reset values, missing PA bytes to 0x00.
+ */
+export function packImage(
+  registers: Record<number, number>,
+  paTable: number[],
+  target: Uint8Array = new Uint8Array(IMAGE_SIZE),
+  offset = 0
+): Uint8Array {
+  for (let addr = 0; addr < REGISTER_COUNT; addr++) {
+    target[offset + addr] = registers[addr] ?? DEFAULT_REGISTERS[addr];
+  }
+  for (let i = 0; i < PA_TABLE_SIZE; i++) {
+    target[offset + REGISTER_COUNT + i] = paTable[i] ?? 0;
+  }
+  return target;
+}
+
+/**
+ * Pack named presets into one bank, in order: a preset map such as PRESETS,
+ * or [name, preset] entries when names may repeat
+ */
+export function packPresetMap(
+  presets: Record<string, PackablePreset> | Array<[string, PackablePreset]>
+): FieldConfigBank {
+  const entries = Array.isArray(presets) ? presets : Object.entries(presets);
+  const images = new Uint8Array(entries.length * IMAGE_SIZE);
+  entries.forEach(([, preset], i) => packImage(preset.registers, preset.paTable, images, i * IMAGE_SIZE));
+  return { names: entries.map(([name]) => name), images };
+}
+
+/**
+ * Unpack an image back into a register map and PA table
+ */
+export function unpackImage(
+  image: Uint8Array,
+  offset = 0
+): { registers: Record<number, number>; paTable: number[] } {
+  const registers: Record<number, number> = {};
+  for (let addr = 0; addr < REGISTER_COUNT; addr++) {
+    registers[addr] = image[offset + addr];
+  }
+  const paTable: number[] = [];
+  for (let i = 0; i < PA_TABLE_SIZE; i++) {
+    paTable.push(image[offset + REGISTER_COUNT + i]);
+  }
+  return { registers, paTable };
+}
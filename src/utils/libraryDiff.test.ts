@@ -0,0 +1,65 @@
+// @vitest-environment node
+import { describe, it, expect } from 'vitest';
+import { PRESETS } from '../data/registers';
+import { edit, library } from '../test/libraryFixtures';
+import { REGISTER_COUNT, packImage } from './image';
+import { compareLibraries, comparePairImages, matchLibraries, packPairImages } from './libraryDiff';
+
+describe('Library Version Comparison', () => {
+  const [fsk, ook, gfsk] = ['FM 2-FSK (433.92MHz)', 'AM 650kHz (433.92MHz)', 'GFSK 9.99kbps (433.92MHz)']
+    .map(name => packImage(PRESETS[name].registers, PRESETS[name].paTable));
+
+  it('matches by name, then renames by canonical fingerprint', () => {
+    const before = library([['fsk', fsk], ['ook', ook], ['gone', gfsk], ['dup', fsk], ['dup', ook]]);
+    // SYNC words are don't-care with sync off, so the renamed OOK preset still matches
+    const syncOff = (ook[0x12] & 0x03) === 0 ? edit(ook, { [0x04]: ook[0x04] ^ 0xFF }) : ook;
+    const after = library([['dup', ook], ['ook renamed', syncOff], ['fsk', fsk], ['dup', fsk], ['new', edit(gfsk, { [0x0F]: 1 })]]);
+
+    const match = matchLibraries(before, after);
+    const pairs = Array.from({ length: match.renamed.length }, (_, p) =>
+      [before.names[match.pairs[p * 2]], after.names[match.pairs[p * 2 + 1]], match.renamed[p]]
+    );
+
+    expect(pairs).toEqual([['fsk', 'fsk', 0], ['dup', 'dup', 0], ['dup', 'dup', 0], ['ook', 'ook renamed', 1]]);
+    expect(match.pairs[2 * 1 + 1]).toBe(0); // Repeated names pair in order
+    expect(match.removed.map(i => before.names[i])).toEqual(['gone']);
+    expect(match.added.map(j => after.names[j])).toEqual(['new']);
+  });
+
+  it('grades each change by its strongest impact', () => {
+    const paPower = fsk[0x22] & 0x07;
+    const before = library([['same', fsk], ['freq', fsk], ['pa', fsk], ['sync', fsk], ['reserved', fsk]]);
+    const after = library([
+      ['same', fsk],
+      ['freq', edit(fsk, { [0x0F]: fsk[0x0F] + 1 })],
+      ['pa', edit(fsk, { [REGISTER_COUNT + paPower]: fsk[REGISTER_COUNT + paPower] ^ 0x01 })],
+      ['sync', edit(fsk, { [0x04]: fsk[0x04] ^ 0x01 })],
+      ['reserved', edit(fsk, { [0x0B]: fsk[0x0B] | 0x80 })] // FSCTRL1 bit 7 is reserved
+    ]);
+
+    const { changes } = compareLibraries(before, after);
+    expect(changes.map(c => [before.names[c.pair], c.impact])).toEqual([
+      ['freq', 'rf'], ['pa', 'power'], ['sync', (fsk[0x12] & 0x03) === 0 ? 'dont-care' : 'fields'], ['reserved', 'dont-care']
+    ]);
+    expect(changes[0].derived.map(d => d.key)).toEqual(['frequency']);
+    expect(changes[0].changes.map(c => [c.register, c.affects])).toEqual([['FREQ0', ['frequency']]]);
+    expect(changes[1].paTable).toEqual([paPower]);
+  });
+
+  it('gives the same result shard by shard', () => {
+    const names = Object.keys(PRESETS);
+    const images = names.map(name => packImage(PRESETS[name].registers, PRESETS[name].paTable));
+    const before = library(names.map((name, i) => [name, images[i]]));
+    const after = library(names.map((name, i) => [name, images[(i + 1) % images.length]]));
+    const match = matchLibraries(before, after);
+    const whole = comparePairImages(packPairImages(before.images, after.images, match));
+
+    const sharded = [];
+    for (let start = 0; start < names.length; start += 3) {
+      const end = Math.min(names.length, start + 3);
+      sharded.push(...comparePairImages(packPairImages(before.images, after.images, match, start, end), start));
+    }
+    expect(sharded).toEqual(whole);
+    expect(whole.length).toBeGreaterThan(0);
+  });
+});
@@ -0,0 +1,226 @@
+/**
+ * Library Version Comparison
+ *
+ * Matches the presets of two library versions by name, then the leftovers
+ * by canonical fingerprint (a rename), and compares each matched pair field
+ * by field. Every changed pair is graded by its strongest impact:
+ *
+ *   rf         a derived RF parameter (frequency, modulation, data rate,
+ *              bandwidth, deviation) changed
+ *   power      the active PA table entry or FREND0.PA_POWER changed
+ *   fields     other documented fields changed
+ *   dont-care  only bits that cannot affect behaviour changed
+ *
+ * Pair comparison works on interleaved packed images so shards of pairs
+ * can be handed to workers as one transferable buffer.
+ */
+
+import { REGISTER_LAYOUT } from '../data/registerLayout';
+import { canonicalFingerprint, canonicalizeImage } from './canonical';
+import { DERIVED_KEYS, deriveImage } from './derive';
+import type { DerivedKey } from './derive';
+import { diffRegisterFields } from './diff';
+import type { FieldChange } from './diff';
+import type { FieldConfigBank } from './fieldConfig';
+import { IMAGE_SIZE, PA_TABLE_SIZE, REGISTER_COUNT } from './image';
+
+export type ChangeImpact = 'rf' | 'power' | 'fields' | 'dont-care';
+
+/** Strongest first */
+export const CHANGE_IMPACTS: ChangeImpact[] = ['rf', 'power', 'fields', 'dont-care'];
+
+export interface DerivedChange {
+  key: DerivedKey;
+  from: number;
+  to: number;
+}
+
+export interface ComparedFieldChange extends FieldChange {
+  affects: DerivedKey[]; // Derived parameters this field feeds
+}
+
+export interface PairChange {
+  pair: number; // Index into the compared pairs
+  impact: ChangeImpact;
+  derived: DerivedChange[];
+  changes: ComparedFieldChange[];
+  paTable: number[]; // PA table indices that changed
+}
+
+export interface LibraryMatch {
+  pairs: Int32Array;   // before, after index per matched pair
+  renamed: Uint8Array; // Per pair: 1 when matched by fingerprint rather than name
+  removed: number[];   // Unmatched before indices
+  added: number[];     // Unmatched after indices
+}
+
+export interface LibraryComparison {
+  match: LibraryMatch;
+  changes: PairChange[]; // Pairs whose images differ, in pair order
+}
+
+// Register bits each derived parameter is computed from, as in deriveImage
+const DERIVED_BITS: Record<DerivedKey, [number, number][]> = {
+  frequency: [[0x0D, 0x3F], [0x0E, 0xFF], [0x0F, 0xFF]],
+  modulation: [[0x12, 0x70]],
+  dataRate: [[0x10, 0x0F], [0x11, 0xFF]],
+  bandwidth: [[0x10, 0xF0]],
+  deviation: [[0x15, 0x77]]
+};
+
+// Per address: bit mask of every field, keyed by field name
+const FIELD_BITS: Map<string, number>[] = Array.from({ length: REGISTER_COUNT }, (_, addr) => {
+  const masks = new Map<string, number>();
+  for (const field of REGISTER_LAYOUT[addr]?.fields ?? []) {
+    masks.set(field.name, field.bits.reduce((mask, bit) => mask | (1 << bit), 0));
+  }
+  return masks;
+});
+
+function fieldAffects(change: FieldChange): DerivedKey[] {
+  const mask = change.field === null ? 0xFF : FIELD_BITS[change.addr].get(change.field) ?? 0;
+  return DERIVED_KEYS.filter(key =>
+    DERIVED_BITS[key].some(([addr, bits]) => addr === change.addr && (bits & mask) !== 0)
+  );
+}
+
+/**
+ * Pair presets by name (in order, for repeated names), then pair what is
+ * left by canonical fingerprint
+ */
+export function matchLibraries(before: FieldConfigBank, after: FieldConfigBank): LibraryMatch {
+  const byName = new Map<string, number[]>();
+  after.names.forEach((name, j) => {
+    const list = byName.get(name);
+    if (list) list.push(j);
+    else byName.set(name, [j]);
+  });
+
+  const pairs: number[] = [];
+  const renamed: number[] = [];
+  const matchedAfter = new Uint8Array(after.names.length);
+  const unmatchedBefore: number[] = [];
+  before.names.forEach((name, i) => {
+    const j = byName.get(name)?.shift();
+    if (j === undefined) {
+      unmatchedBefore.push(i);
+      return;
+    }
+    pairs.push(i, j);
+    renamed.push(0);
+    matchedAfter[j] = 1;
+  });
+
+  const scratch = new Uint8Array(IMAGE_SIZE);
+  const byFingerprint = new Map<string, number[]>();
+  for (let j = 0; j < after.names.length; j++) {
+    if (matchedAfter[j]) continue;
+    const fingerprint = canonicalFingerprint(after.images, j * IMAGE_SIZE, 'device', scratch);
+    const list = byFingerprint.get(fingerprint);
+    if (list) list.push(j);
+    else byFingerprint.set(fingerprint, [j]);
+  }
+
+  const removed: number[] = [];
+  for (const i of unmatchedBefore) {
+    const j = byFingerprint.get(canonicalFingerprint(before.images, i * IMAGE_SIZE, 'device', scratch))?.shift();
+    if (j === undefined) {
+      removed.push(i);
+      continue;
+    }
+    pairs.push(i, j);
+    renamed.push(1);
+    matchedAfter[j] = 1;
+  }
+
+  const added: number[] = [];
+  for (let j = 0; j < after.names.length; j++) {
+    if (!matchedAfter[j]) added.push(j);
+  }
+
+  return { pairs: Int32Array.from(pairs), renamed: Uint8Array.from(renamed), removed, added };
+}
+
+/**
+ * Interleave the matched images, before then after, for pairs
+ * [start, end) into one buffer
+ */
+export function packPairImages(
+  before: Uint8Array,
+  after: Uint8Array,
+  match: LibraryMatch,
+  start = 0,
+  end = match.renamed.length
+): Uint8Array {
+  const images = new Uint8Array((end - start) * 2 * IMAGE_SIZE);
+  for (let p = start; p < end; p++) {
+    const i = match.pairs[p * 2];
+    const j = match.pairs[p * 2 + 1];
+    const offset = (p - start) * 2 * IMAGE_SIZE;
+    images.set(before.subarray(i * IMAGE_SIZE, (i + 1) * IMAGE_SIZE), offset);
+    images.set(after.subarray(j * IMAGE_SIZE, (j + 1) * IMAGE_SIZE), offset + IMAGE_SIZE);
+  }
+  return images;
+}
+
+/**
+ * Compare interleaved image pairs; identical pairs are left out
+ */
+export function comparePairImages(images: Uint8Array, firstPair = 0): PairChange[] {
+  const count = Math.floor(images.length / (2 * IMAGE_SIZE));
+  const canonicalBefore = new Uint8Array(IMAGE_SIZE);
+  const canonicalAfter = new Uint8Array(IMAGE_SIZE);
+  const results: PairChange[] = [];
+
+  for (let p = 0; p < count; p++) {
+    const a = p * 2 * IMAGE_SIZE;
+    const b = a + IMAGE_SIZE;
+    let same = true;
+    for (let k = 0; k < IMAGE_SIZE && same; k++) same = images[a + k] === images[b + k];
+    if (same) continue;
+
+    const changes: ComparedFieldChange[] = [];
+    for (let addr = 0; addr < REGISTER_COUNT; addr++) {
+      for (const change of diffRegisterFields(addr, images[a + addr], images[b + addr])) {
+        changes.push({ ...change, affects: fieldAffects(change) });
+      }
+    }
+    const paTable: number[] = [];
+    for (let k = 0; k < PA_TABLE_SIZE; k++) {
+      if (images[a + REGISTER_COUNT + k] !== images[b + REGISTER_COUNT + k]) paTable.push(k);
+    }
+
+    const derivedBefore = deriveImage(images, a);
+    const derivedAfter = deriveImage(images, b);
+    const derived: DerivedChange[] = [];
+    for (const key of DERIVED_KEYS) {
+      if (derivedBefore[key] !== derivedAfter[key]) derived.push({ key, from: derivedBefore[key], to: derivedAfter[key] });
+    }
+
+    let impact: ChangeImpact;
+    if (derived.length > 0) {
+      impact = 'rf';
+    } else if (
+      (images[a + 0x22] & 0x07) !== (images[b + 0x22] & 0x07) ||
+      images[a + REGISTER_COUNT + (images[a + 0x22] & 0x07)] !== images[b + REGISTER_COUNT + (images[b + 0x22] & 0x07)]
+    ) {
+      impact = 'power';
+    } else {
+      canonicalizeImage(images, a, 'device', canonicalBefore);
+      canonicalizeImage(images, b, 'device', canonicalAfter);
+      impact = canonicalBefore.every((byte, k) => byte === canonicalAfter[k]) ? 'dont-care' : 'fields';
+    }
+
+    results.push({ pair: firstPair + p, impact, derived, changes, paTable });
+  }
+
+  return results;
+}
+
+/**
+ * Match and compare two libraries in-process
+ */
+export function compareLibraries(before: FieldConfigBank, after: FieldConfigBank): LibraryComparison {
+  const match = matchLibraries(before, after);
+  return { match, changes: comparePairImages(packPairImages(before.images, after.images, match)) };
+}
@@ -0,0 +1,71 @@
+// @vitest-environment node
+import { describe, it, expect } from 'vitest';
+import { PRESETS } from '../data/registers';
+import { encodePackedBank } from './binary';
+import {
+  generateCArray,
+  generateFlipperPresetData,
+  generateFlipperSettingUserBatch,
+  generateRawHex,
+  parseFlipperPresetPairs
+} from './export';
+import { generateFieldConfig } from './fieldConfig';
+import { IMAGE_SIZE, packImage, unpackImage } from './image';
+import { createLibraryReader, readLibraryBank } from './libraryReader';
+
+const names = Object.keys(PRESETS);
+const expected = names.map(name => Array.from(packImage(PRESETS[name].registers, PRESETS[name].paTable)));
+// Every register, so formats that only write the registers they are given round trip
+const presets = expected.map(image => unpackImage(Uint8Array.from(image)));
+
+// Feed text in small chunks so lines and sections straddle chunk boundaries
+function read(fileName: string, text: string, chunkSize = 7) {
+  const presets: { name: string; image: number[] }[] = [];
+  const reader = createLibraryReader(fileName, (image, name) => presets.push({ name, image: Array.from(image) }));
+  for (let i = 0; i < text.length; i += chunkSize) reader.push(text.slice(i, i + chunkSize));
+  reader.end();
+  return presets;
+}
+
+describe('Streaming Preset Library Reader', () => {
+  it('streams setting_user and field config files preset by preset', () => {
+    const batch = generateFlipperSettingUserBatch(names.map((name, i) => ({ name, ...presets[i] })));
+    // setting_user leaves out the registers the Flipper sets itself
+    const flipper = presets.map(({ registers, paTable }) => {
+      const listed = parseFlipperPresetPairs(generateFlipperPresetData(registers, paTable));
+      return Array.from(packImage(listed.registers, listed.paTable));
+    });
+    expect(read('setting_user', batch)).toEqual(names.map((name, i) => ({ name, image: flipper[i] })));
+
+    const config = names.map((name, i) => generateFieldConfig(name, presets[i].registers, presets[i].paTable)).join('\n');
+    expect(read('library.cfg', config)).toEqual(names.map((name, i) => ({ name, image: expected[i] })));
+
+    let reported = 0;
+    const reader = createLibraryReader('library.cfg', () => reported++);
+    reader.push(config.slice(0, config.indexOf(`[${names[2]}]`)));
+    expect(reported).toBe(1); // The second section can still grow until the next header
+    reader.push(config.slice(config.indexOf(`[${names[2]}]`)));
+    reader.end();
+    expect(reported).toBe(names.length);
+  });
+
+  it('detects raw hex, C array and binary bank libraries', () => {
+    const hex = presets.map(preset => generateRawHex(preset.registers)).join('\n');
+    const fromHex = read('dump.txt', `# exported\n${hex}\n`);
+    expect(fromHex.map(p => p.name)).toEqual(names.map((_, i) => `dump_${i + 1}`));
+    fromHex.forEach((p, i) => expect(p.image.slice(0, 0x2F)).toEqual(expected[i].slice(0, 0x2F)));
+
+    const source = generateCArray(names[0], presets[0].registers, presets[0].paTable);
+    expect(read('preset.h', source).map(p => p.image)).toEqual([expected[0]]);
+
+    const images = new Uint8Array(names.length * IMAGE_SIZE);
+    expected.forEach((image, i) => images.set(image, i * IMAGE_SIZE));
+    const banked: string[] = [];
+    expect(readLibraryBank(encodePackedBank(images, names, { columnar: true }), (_, name) => banked.push(name))).toBe(names.length);
+    expect(banked).toEqual(names);
+  });
+
+  it('reports malformed input', () => {
+    expect(() => read('broken.sub', 'Filetype: Flipper SubGhz RAW File\nVersion: 1\n')).toThrow();
+  });
+});
@@ -0,0 +1,179 @@
+/**
+ * Streaming Preset Library Reader
+ *
+ * Detects a library file's format from its name and first lines and
+ * reports each preset as a packed image as soon as it is complete.
+ * setting_user, raw hex and field config files stream line by line;
+ * .sub, C array and SmartRF files are parsed once their text is complete.
+ */
+
+import { decodeImageBank } from './binary';
+import { parseCArrayPresets } from './cArray';
+import { parseRawHex } from './export';
+import { parseFieldConfig } from './fieldConfig';
+import { DEFAULT_PA_TABLE, DEFAULT_REGISTERS, IMAGE_SIZE, REGISTER_COUNT, packImage } from './image';
+import { createLineSplitter } from './lines';
+import { isSmartRfListing, parseSmartRfListing } from './smartrf';
+import { parseSubFile } from './subFile';
+
+/** `image` may be reused once the handler returns; copy it to keep it */
+export type LibraryPresetHandler = (image: Uint8Array, name: string) => void;
+
+export interface LibraryReader {
+  push: (chunk: string) => void;
+  end: () => void;
+}
+
+type LineFormat = 'flipper' | 'raw-hex' | 'field-config';
+
+const RAW_HEX_LINE = /^[0-9a-f]{2}([\s,]+[0-9a-f]{2}){46}/i;
+// Char code -> hex digit value, -1 for anything else
+const HEX_DIGITS = Int8Array.from({ length: 128 }, (_, code) => {
+  const digit = parseInt(String.fromCharCode(code), 16);
+  return Number.isNaN(digit) ? -1 : digit;
+});
+const SETTING_DATA_LINE = /^[0-9a-f]{2}( [0-9a-f]{2})+$/i;
+
+/**
+ * Pack setting_user preset data straight into `image`, with the same
+ * result as parseFlipperPresetPairs followed by packImage but without
+ * building a register map per preset
+ */
+function packFlipperPresetData(line: string, image: Uint8Array, bytes: Uint8Array): void {
+  let count = 0;
+  let value = -1;
+  for (let i = line.indexOf(':') + 1; i < line.length; i++) {
+    const code = line.charCodeAt(i);
+    const digit = code < 128 ? HEX_DIGITS[code] : -1;
+    if (digit < 0) {
+      if (value >= 0 && count < bytes.length) bytes[count++] = value;
+      value = -1;
+    } else {
+      value = value < 0 ? digit : ((value << 4) | digit) & 0xFF;
+    }
+  }
+  if (value >= 0 && count < bytes.length) bytes[count++] = value;
+
+  image.set(DEFAULT_REGISTERS);
+  image.fill(0, REGISTER_COUNT);
+  for (let i = 0; i < count - 2; i += 2) {
+    const addr = bytes[i];
+    if (addr === 0 && bytes[i + 1] === 0) {
+      image.set(bytes.subarray(i + 2, Math.min(i + 10, count)), REGISTER_COUNT);
+      return;
+    }
+    if (addr < REGISTER_COUNT) image[addr] = bytes[i + 1];
+  }
+}
+
+function fileBaseName(fileName: string): string {
+  const base = fileName.slice(fileName.lastIndexOf('/') + 1);
+  const dot = base.lastIndexOf('.');
+  return dot > 0 ? base.slice(0, dot) : base;
+}
+
+/**
+ * Report every preset in a binary image bank
+ */
+export function readLibraryBank(source: ArrayBuffer | Uint8Array, onPreset: LibraryPresetHandler): number {
+  const bank = decodeImageBank(source);
+  for (let i = 0; i < bank.count; i++) {
+    onPreset(bank.images.subarray(i * IMAGE_SIZE, (i + 1) * IMAGE_SIZE), bank.name(i) || `preset_${i + 1}`);
+  }
+  return bank.count;
+}
+
+/**
+ * Reader for one text file; throws from push/end on malformed input
+ */
+export function createLibraryReader(fileName: string, onPreset: LibraryPresetHandler): LibraryReader {
+  const lower = fileName.toLowerCase();
+  const wholeText = lower.endsWith('.sub') || lower.endsWith('.h') || lower.endsWith('.c');
+  let format: LineFormat | 'whole' | null = wholeText ? 'whole' : null;
+  let count = 0;
+  const nextName = () => `${fileBaseName(fileName)}_${++count}`;
+
+  const emit = (registers: Record<number, number>, paTable: number[], name: string) => {
+    onPreset(packImage(registers, paTable), name);
+  };
+
+  // setting_user state
+  let pendingName: string | null = null;
+  const scratch = new Uint8Array(IMAGE_SIZE);
+  const scratchBytes = new Uint8Array(512);
+  // field config state: the current [name] section
+  let section: string[] = [];
+  // .sub, C array, SmartRF and undetected text
+  let buffered: string[] = [];
+
+  const flushSection = () => {
+    if (section.length === 0) return;
+    const { names, images } = parseFieldConfig(section.join('\n'));
+    section = [];
+    names.forEach((name, i) => onPreset(images.subarray(i * IMAGE_SIZE, (i + 1) * IMAGE_SIZE), name));
+  };
+
+  const detect = (trimmed: string): LineFormat | 'whole' | null => {
+    if (trimmed.startsWith('#define')) return 'whole';
+    if (trimmed.length === 0 || trimmed.startsWith('#')) return null;
+    if (trimmed.startsWith('Filetype:')) return trimmed.includes('Setting') ? 'flipper' : 'whole';
+    if (trimmed.startsWith('Version:') || trimmed.startsWith('Custom_preset')) return 'flipper';
+    if (trimmed.startsWith('[') || /^[A-Za-z_]\w*(\.\w+)?\s*=/.test(trimmed)) return 'field-config';
+    if (RAW_HEX_LINE.test(trimmed)) return 'raw-hex';
+    return 'whole';
+  };
+
+  const line = (text: string) => {
+    const trimmed = text.trim();
+    if (format === null) {
+      format = detect(trimmed);
+      if (format === null) return;
+    }
+
+    switch (format) {
+      case 'whole':
+        buffered.push(text);
+        return;
+      case 'raw-hex':
+        if (trimmed.length > 0 && !trimmed.startsWith('#')) emit(parseRawHex(trimmed), DEFAULT_PA_TABLE, nextName());
+        return;
+      case 'field-config':
+        if (trimmed.startsWith('[')) flushSection();
+        section.push(text);
+        return;
+      case 'flipper':
+        if (trimmed.startsWith('Custom_preset_name:')) {
+          pendingName = trimmed.slice('Custom_preset_name:'.length).trim();
+        } else if (trimmed.startsWith('Custom_preset_data:') || SETTING_DATA_LINE.test(trimmed)) {
+          packFlipperPresetData(trimmed, scratch, scratchBytes);
+          onPreset(scratch, pendingName ?? nextName());
+          pendingName = null;
+        }
+        return;
+    }
+  };
+
+  const splitter = createLineSplitter(line);
+
+  return {
+    push: splitter.push,
+    end() {
+      splitter.end();
+      if (format === 'field-config') flushSection();
+      if (format !== 'whole') return;
+
+      const text = buffered.join('\n');
+      buffered = [];
+      if (lower.endsWith('.sub') || text.startsWith('Filetype: Flipper SubGhz')) {
+        const sub = parseSubFile(text);
+        if (!sub.preset) throw new Error(sub.presetError ?? 'No preset');
+        emit(sub.preset.registers, sub.preset.paTable, sub.preset.name);
+      } else if (isSmartRfListing(text)) {
+        const listing = parseSmartRfListing(text);
+        emit(listing.registers, listing.paTable, fileBaseName(fileName));
+      } else {
+        for (const preset of parseCArrayPresets(text)) emit(preset.registers, preset.paTable, preset.name);
+      }
+    }
+  };
+}
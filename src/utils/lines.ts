@@ -0,0 +1,73 @@
+/**
+ * Incremental Line Splitter
+ * Shared tokenizer front end for the streaming importers
+ */
+
+export interface LineSplitter {
+  push: (chunk: string) => void;
+  end: () => void;
+}
+
+/**
+ * Feed text in arbitrary chunks; `onLine` receives each complete line
+ * without its terminator (LF or CRLF).
+ */
+export function createLineSplitter(onLine: (line: string) => void): LineSplitter {
+  let carry = '';
+
+  return {
+    push(chunk: string) {
+      let start = 0;
+      let newline = chunk.indexOf('\n');
+      if (newline === -1) {
+        carry += chunk;
+        return;
+      }
+
+      let line = carry + chunk.slice(0, newline);
+      carry = '';
+      while (newline !== -1) {
+        onLine(line.endsWith('\r') ? line.slice(0, -1) : line);
+        start = newline + 1;
+        newline = chunk.indexOf('\n', start);
+        if (newline !== -1) line = chunk.slice(start, newline);
+      }
+      carry = chunk.slice(start);
+    },
+    end() {
+      if (carry.length > 0) {
+        onLine(carry.endsWith('\r') ? carry.slice(0, -1) : carry);
+        carry = '';
+      }
+    }
+  };
+}
+
+/**
+ * Split a complete string through the same path as streamed input
+ */
+export function forEachLine(text: string, onLine: (line: string) => void): void {
+  const splitter = createLineSplitter(onLine);
+  splitter.push(text);
+  splitter.end();
+}
+
+/**
+ * Stream a Blob/File as decoded text chunks
+ */
+export async function readTextChunks(
+  blob: Blob,
+  onChunk: (text: string, loaded: number) => void
+): Promise<void> {
+  const reader = blob.stream().getReader();
+  const decoder = new TextDecoder();
+  let loaded = 0;
+
+  for (;;) {
+    const { done, value } = await reader.read();
+    if (done) break;
+    loaded += value.byteLength;
+    onChunk(decoder.decode(value, { stream: true }), loaded);
+  }
+  onChunk(decoder.decode(), loaded);
+}
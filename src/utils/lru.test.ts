@@ -0,0 +1,28 @@
+import { describe, it, expect } from 'vitest';
+import { createLruCache } from './lru';
+
+describe('LRU Cache', () => {
+  it('evicts least recently used entries past the size budget', () => {
+    const cache = createLruCache<string>(10, value => value.length);
+    cache.set('a', 'aaaa');
+    cache.set('b', 'bbbb');
+    expect(cache.get('a')).toBe('aaaa'); // a is now most recent
+    cache.set('c', 'cccc');
+
+    expect(cache.get('b')).toBeUndefined();
+    expect(cache.get('a')).toBe('aaaa');
+    expect(cache.get('c')).toBe('cccc');
+    expect(cache.bytes()).toBe(8);
+  });
+
+  it('replaces existing keys and skips values over the budget', () => {
+    const cache = createLruCache<string>(10, value => value.length);
+    cache.set('a', 'aaaa');
+    cache.set('a', 'aa');
+    cache.set('huge', 'x'.repeat(11));
+
+    expect(cache.size()).toBe(1);
+    expect(cache.bytes()).toBe(2);
+    expect(cache.get('huge')).toBeUndefined();
+  });
+});
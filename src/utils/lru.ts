@@ -0,0 +1,45 @@
+/**
+ * Least-Recently-Used Cache
+ * Bounded by total size; Map insertion order doubles as recency order.
+ */
+
+export interface LruCache<V> {
+  get: (key: string) => V | undefined;
+  set: (key: string, value: V) => void;
+  size: () => number;  // Entries
+  bytes: () => number; // Sum of sizeOf over entries
+}
+
+export function createLruCache<V>(maxBytes: number, sizeOf: (value: V) => number): LruCache<V> {
+  const entries = new Map<string, V>();
+  let total = 0;
+
+  return {
+    get(key) {
+      const value = entries.get(key);
+      if (value !== undefined) {
+        entries.delete(key);
+        entries.set(key, value);
+      }
+      return value;
+    },
+    set(key, value) {
+      const size = sizeOf(value);
+      if (size > maxBytes) return;
+      const previous = entries.get(key);
+      if (previous !== undefined) {
+        total -= sizeOf(previous);
+        entries.delete(key);
+      }
+      entries.set(key, value);
+      total += size;
+      for (const [oldest, evicted] of entries) {
+        if (total <= maxBytes) break;
+        entries.delete(oldest);
+        total -= sizeOf(evicted);
+      }
+    },
+    size: () => entries.size,
+    bytes: () => total
+  };
+}
@@ -0,0 +1,71 @@
+// @vitest-environment node
+import { describe, it, expect } from 'vitest';
+import { PRESETS } from '../data/registers';
+import { edit, library } from '../test/libraryFixtures';
+import { IMAGE_SIZE, packImage } from './image';
+import { MERGE_UNITS, mergeImages, mergeLibraries } from './merge';
+
+const fsk = packImage(PRESETS['FM 2-FSK (433.92MHz)'].registers, PRESETS['FM 2-FSK (433.92MHz)'].paTable);
+const ook = packImage(PRESETS['AM 650kHz (433.92MHz)'].registers, PRESETS['AM 650kHz (433.92MHz)'].paTable);
+
+function frequencyWord(image: Uint8Array): number {
+  return ((image[0x0D] & 0x3F) << 16) | (image[0x0E] << 8) | image[0x0F];
+}
+
+describe('Three-Way Preset Merge', () => {
+  it('links fields that split one value', () => {
+    const paths = MERGE_UNITS.map(unit => unit.path);
+    expect(paths).toContain('FREQ');
+    expect(paths).toContain('DRATE');
+    expect(paths).toContain('MDMCFG4.CHANBW');
+    expect(paths).toContain('MDMCFG2.MOD_FORMAT');
+    expect(paths).not.toContain('FREQ0.FREQ[7:0]');
+    // Every image bit belongs to exactly one unit
+    const seen = new Uint8Array(IMAGE_SIZE);
+    for (const unit of MERGE_UNITS) {
+      unit.offsets.forEach((offset, p) => {
+        expect(seen[offset] & unit.masks[p]).toBe(0);
+        seen[offset] |= unit.masks[p];
+      });
+    }
+    expect(Array.from(seen)).toEqual(new Array(IMAGE_SIZE).fill(0xFF));
+  });
+
+  it('combines edits to different fields of one register and reports overlapping ones', () => {
+    const ours = edit(fsk, { 'MDMCFG2.MOD_FORMAT': 1, 'FREQ': 0x10B071 });
+    const theirs = edit(fsk, { 'MDMCFG2.SYNC_MODE': 1, 'FREQ': 0x10A762 });
+    const target = new Uint8Array(IMAGE_SIZE);
+
+    const conflicts = mergeImages(fsk, 0, ours, 0, theirs, 0, target, 0);
+    expect(conflicts).toEqual([{ path: 'FREQ', base: frequencyWord(fsk), ours: 0x10B071, theirs: 0x10A762 }]);
+    expect((target[0x12] >> 4) & 0x07).toBe(1);
+    expect(target[0x12] & 0x07).toBe(1);
+    expect(target[0x0F]).toBe(0x71); // Ours by default
+
+    mergeImages(fsk, 0, ours, 0, theirs, 0, target, 0, { prefer: 'theirs' });
+    expect(target[0x0F]).toBe(0x62);
+    expect((target[0x12] >> 4) & 0x07).toBe(1);
+
+    // Different bytes of one linked value still conflict
+    const low = edit(fsk, { 'FREQ0.FREQ[7:0]': fsk[0x0F] ^ 1 });
+    const high = edit(fsk, { 'FREQ1.FREQ[15:8]': fsk[0x0E] ^ 1 });
+    expect(mergeImages(fsk, 0, low, 0, high, 0, target, 0).map(c => c.path)).toEqual(['FREQ']);
+  });
+
+  it('merges libraries in one pass with preset-level conflicts', () => {
+    const base = library([['a', fsk], ['b', fsk], ['c', ook], ['d', ook]]);
+    const ours = library([['a', edit(fsk, { 'MDMCFG2.MOD_FORMAT': 1 })], ['c', ook], ['d', edit(ook, { 'PKTLEN.PACKET_LENGTH': 9 })], ['x', edit(fsk, { 'PKTLEN.PACKET_LENGTH': 9 })]]);
+    const theirs = library([['a', edit(fsk, { 'DEVIATN': 0x47 })], ['b', fsk], ['y', ook], ['x', edit(fsk, { 'PKTLEN.PACKET_LENGTH': 7 })]]);
+
+    const result = mergeLibraries(base, ours, theirs);
+    // b: removed by us, untouched by them; c: removed by them, untouched by us
+    expect(result.names).toEqual(['a', 'd', 'x', 'y']);
+    expect(result.merged).toBe(1);
+    expect((result.images[0x12] >> 4) & 0x07).toBe(1);
+    expect(result.images[0x15]).toBe(0x47);
+    expect(result.conflicts.map(c => [c.name, c.kind, c.deletedBy ?? null, c.fields.map(f => f.path)])).toEqual([
+      ['d', 'delete-modify', 'theirs', []],
+      ['x', 'add-add', null, ['PKTLEN.PACKET_LENGTH']]
+    ]);
+  });
+});
@@ -0,0 +1,282 @@
+/**
+ * Three-Way Preset Merge
+ *
+ * Merges two edited versions of a preset (ours, theirs) against their
+ * common base one merge unit at a time. A unit is a register field from
+ * REGISTER_LAYOUT, the reserved bits of a register, or one PA table entry.
+ * Fields that split one value across registers or exponent/mantissa pairs
+ * (FREQ, SYNC, DRATE, MDMCFG4.CHANBW, ...) form a single unit, so a merge
+ * never combines half of each side's frequency or data rate.
+ *
+ * A unit changed on one side takes that side's value; changed identically
+ * on both, it takes either. Changed differently on both, it is a conflict:
+ * reported with all three values and resolved to `prefer`.
+ */
+
+import { REGISTER_LAYOUT } from '../data/registerLayout';
+import type { FieldConfigBank } from './fieldConfig';
+import { DEFAULT_PA_TABLE, IMAGE_SIZE, PA_TABLE_SIZE, REGISTER_COUNT, packImage } from './image';
+
+export type MergeSide = 'ours' | 'theirs';
+
+export interface MergeUnit {
+  path: string;       // e.g. "MDMCFG2.MOD_FORMAT", "FREQ", "PKTCTRL0 (reserved)", "PATABLE[0]"
+  offsets: number[];  // Image byte offsets, most significant first
+  masks: number[];    // Bits of each byte, in place
+}
+
+export interface FieldConflict {
+  path: string;
+  base: number;
+  ours: number;
+  theirs: number;
+}
+
+export type PresetConflictKind = 'content' | 'delete-modify' | 'add-add';
+
+export interface PresetConflict {
+  name: string;
+  kind: PresetConflictKind;
+  fields: FieldConflict[];  // content and add-add conflicts
+  deletedBy?: MergeSide;    // delete-modify: the side that removed the preset
+}
+
+export interface LibraryMerge extends FieldConfigBank {
+  conflicts: PresetConflict[];
+  merged: number; // Base presets both sides edited differently
+}
+
+export interface MergeOptions {
+  prefer?: MergeSide; // Resolution of conflicting units (default ours)
+}
+
+// Fields named STEM[hi:lo], STEM_E or STEM_M combine with the rest of their stem
+const LINKED_FIELD = /^(.*?)(\[\d+:\d+\]|_E|_M)$/;
+
+/**
+ * Every merge unit of a packed image: single-register units in address
+ * order, then linked fields, then the PA table
+ */
+export const MERGE_UNITS: MergeUnit[] = (() => {
+  const units: MergeUnit[] = [];
+  const linked = new Map<string, { regs: Set<string>; offsets: number[]; masks: number[] }>();
+  const linkedOrder: string[] = [];
+
+  for (let addr = 0; addr < REGISTER_COUNT; addr++) {
+    const reg = REGISTER_LAYOUT[addr];
+    if (!reg) continue;
+    let covered = 0;
+    for (const field of reg.fields) {
+      const mask = field.bits.reduce((bits, bit) => bits | (1 << bit), 0);
+      covered |= mask;
+      const stem = LINKED_FIELD.exec(field.name)?.[1];
+      if (!stem) {
+        units.push({ path: `${reg.name}.${field.name}`, offsets: [addr], masks: [mask] });
+        continue;
+      }
+      let group = linked.get(stem);
+      if (!group) {
+        group = { regs: new Set(), offsets: [], masks: [] };
+        linked.set(stem, group);
+        linkedOrder.push(stem);
+      }
+      group.regs.add(reg.name);
+      group.offsets.push(addr);
+      group.masks.push(mask);
+    }
+    const reserved = ~covered & 0xFF;
+    if (reserved !== 0) units.push({ path: `${reg.name} (reserved)`, offsets: [addr], masks: [reserved] });
+  }
+
+  for (const stem of linkedOrder) {
+    const { regs, offsets, masks } = linked.get(stem)!;
+    const [regName] = regs;
+    const path = regs.size > 1 || regName === stem ? stem : `${regName}.${stem}`;
+    units.push({ path, offsets, masks });
+  }
+
+  for (let i = 0; i < PA_TABLE_SIZE; i++) {
+    units.push({ path: `PATABLE[${i}]`, offsets: [REGISTER_COUNT + i], masks: [0xFF] });
+  }
+  return units;
+})();
+
+// Flattened units: per unit, the range of its parts in UNIT_OFFSETS/UNIT_MASKS
+const UNIT_STARTS = new Int32Array(MERGE_UNITS.length + 1);
+const UNIT_OFFSETS = Int32Array.from(MERGE_UNITS.flatMap(unit => unit.offsets));
+const UNIT_MASKS = Uint8Array.from(MERGE_UNITS.flatMap(unit => unit.masks));
+MERGE_UNITS.forEach((unit, u) => {
+  UNIT_STARTS[u + 1] = UNIT_STARTS[u] + unit.offsets.length;
+});
+
+const DEFAULT_IMAGE = packImage({}, DEFAULT_PA_TABLE);
+
+// Value of unit `u` as one number, parts concatenated most significant first
+function unitValue(image: Uint8Array, offset: number, u: number): number {
+  let value = 0;
+  for (let p = UNIT_STARTS[u]; p < UNIT_STARTS[u + 1]; p++) {
+    const mask = UNIT_MASKS[p];
+    const shift = 31 - Math.clz32(mask & -mask);
+    const width = 32 - Math.clz32(mask >> shift);
+    value = value * (1 << width) + ((image[offset + UNIT_OFFSETS[p]] & mask) >> shift);
+  }
+  return value;
+}
+
+function unitEqual(a: Uint8Array, aOffset: number, b: Uint8Array, bOffset: number, u: number): boolean {
+  for (let p = UNIT_STARTS[u]; p < UNIT_STARTS[u + 1]; p++) {
+    const mask = UNIT_MASKS[p];
+    if ((a[aOffset + UNIT_OFFSETS[p]] & mask) !== (b[bOffset + UNIT_OFFSETS[p]] & mask)) return false;
+  }
+  return true;
+}
+
+function copyUnit(source: Uint8Array, sourceOffset: number, target: Uint8Array, targetOffset: number, u: number): void {
+  for (let p = UNIT_STARTS[u]; p < UNIT_STARTS[u + 1]; p++) {
+    const mask = UNIT_MASKS[p];
+    const at = UNIT_OFFSETS[p];
+    target[targetOffset + at] = (target[targetOffset + at] & ~mask) | (source[sourceOffset + at] & mask);
+  }
+}
+
+function imagesEqual(a: Uint8Array, aOffset: number, b: Uint8Array, bOffset: number): boolean {
+  for (let i = 0; i < IMAGE_SIZE; i++) {
+    if (a[aOffset + i] !== b[bOffset + i]) return false;
+  }
+  return true;
+}
+
+/**
+ * Merge one image into `target` at `targetOffset`. Returns the conflicting
+ * units, empty when the merge is clean.
+ */
+export function mergeImages(
+  base: Uint8Array, baseOffset: number,
+  ours: Uint8Array, oursOffset: number,
+  theirs: Uint8Array, theirsOffset: number,
+  target: Uint8Array, targetOffset: number,
+  options: MergeOptions = {}
+): FieldConflict[] {
+  const conflicts: FieldConflict[] = [];
+  // Whole-image shortcuts cover presets edited on one side only
+  if (imagesEqual(theirs, theirsOffset, base, baseOffset) || imagesEqual(ours, oursOffset, theirs, theirsOffset)) {
+    target.set(ours.subarray(oursOffset, oursOffset + IMAGE_SIZE), targetOffset);
+    return conflicts;
+  }
+  if (imagesEqual(ours, oursOffset, base, baseOffset)) {
+    target.set(theirs.subarray(theirsOffset, theirsOffset + IMAGE_SIZE), targetOffset);
+    return conflicts;
+  }
+
+  const preferTheirs = options.prefer === 'theirs';
+  target.set(ours.subarray(oursOffset, oursOffset + IMAGE_SIZE), targetOffset);
+  for (let u = 0; u < MERGE_UNITS.length; u++) {
+    if (unitEqual(ours, oursOffset, theirs, theirsOffset, u)) continue;
+    if (unitEqual(ours, oursOffset, base, baseOffset, u)) {
+      copyUnit(theirs, theirsOffset, target, targetOffset, u);
+    } else if (!unitEqual(theirs, theirsOffset, base, baseOffset, u)) {
+      conflicts.push({
+        path: MERGE_UNITS[u].path,
+        base: unitValue(base, baseOffset, u),
+        ours: unitValue(ours, oursOffset, u),
+        theirs: unitValue(theirs, theirsOffset, u)
+      });
+      if (preferTheirs) copyUnit(theirs, theirsOffset, target, targetOffset, u);
+    }
+  }
+  return conflicts;
+}
+
+// Per preset, its name plus occurrence count, so repeated names pair in order
+function presetKeys(names: string[]): string[] {
+  const seen = new Map<string, number>();
+  return names.map(name => {
+    const n = seen.get(name) ?? 0;
+    seen.set(name, n + 1);
+    return `${name}\u0000${n}`;
+  });
+}
+
+function indexKeys(keys: string[]): Map<string, number> {
+  return new Map(keys.map((key, i) => [key, i]));
+}
+
+/**
+ * Merge whole libraries, pairing presets by name (repeated names in
+ * order of appearance). The result keeps our
+ * order, followed by presets only they added.
+ *
+ * - removed on one side and untouched on the other: removed
+ * - removed on one side and edited on the other: kept edited, reported
+ * - added on both sides: merged against the chip's reset image
+ */
+export function mergeLibraries(
+  base: FieldConfigBank,
+  ours: FieldConfigBank,
+  theirs: FieldConfigBank,
+  options: MergeOptions = {}
+): LibraryMerge {
+  const oursKeys = presetKeys(ours.names);
+  const theirsKeys = presetKeys(theirs.names);
+  const baseIndex = indexKeys(presetKeys(base.names));
+  const oursIndex = indexKeys(oursKeys);
+  const theirsIndex = indexKeys(theirsKeys);
+  const names: string[] = [];
+  const images = new Uint8Array((ours.names.length + theirs.names.length) * IMAGE_SIZE);
+  const conflicts: PresetConflict[] = [];
+  let merged = 0;
+
+  const keep = (name: string, source: Uint8Array, index: number) => {
+    images.set(source.subarray(index * IMAGE_SIZE, (index + 1) * IMAGE_SIZE), names.length * IMAGE_SIZE);
+    names.push(name);
+  };
+
+  ours.names.forEach((name, o) => {
+    const b = baseIndex.get(oursKeys[o]);
+    const t = theirsIndex.get(oursKeys[o]);
+    const oursOffset = o * IMAGE_SIZE;
+
+    if (t === undefined) {
+      if (b === undefined) {
+        keep(name, ours.images, o);
+      } else if (!imagesEqual(ours.images, oursOffset, base.images, b * IMAGE_SIZE)) {
+        conflicts.push({ name, kind: 'delete-modify', fields: [], deletedBy: 'theirs' });
+        keep(name, ours.images, o);
+      }
+      return;
+    }
+
+    const theirsOffset = t * IMAGE_SIZE;
+    const [baseImage, baseOffset] = b === undefined ? [DEFAULT_IMAGE, 0] : [base.images, b * IMAGE_SIZE];
+    const fields = mergeImages(
+      baseImage, baseOffset,
+      ours.images, oursOffset,
+      theirs.images, theirsOffset,
+      images, names.length * IMAGE_SIZE,
+      options
+    );
+    names.push(name);
+    if (fields.length > 0) conflicts.push({ name, kind: b === undefined ? 'add-add' : 'content', fields });
+    if (
+      b !== undefined &&
+      !imagesEqual(ours.images, oursOffset, baseImage, baseOffset) &&
+      !imagesEqual(theirs.images, theirsOffset, baseImage, baseOffset) &&
+      !imagesEqual(ours.images, oursOffset, theirs.images, theirsOffset)
+    ) {
+      merged++;
+    }
+  });
+
+  theirs.names.forEach((name, t) => {
+    if (oursIndex.has(theirsKeys[t])) return;
+    const b = baseIndex.get(theirsKeys[t]);
+    if (b === undefined) {
+      keep(name, theirs.images, t);
+    } else if (!imagesEqual(theirs.images, t * IMAGE_SIZE, base.images, b * IMAGE_SIZE)) {
+      conflicts.push({ name, kind: 'delete-modify', fields: [], deletedBy: 'ours' });
+      keep(name, theirs.images, t);
+    }
+  });
+
+  return { names, images: images.slice(0, names.length * IMAGE_SIZE), conflicts, merged };
+}
@@ -0,0 +1,46 @@
+import { describe, it, expect } from 'vitest';
+import { PRESETS } from '../data/registers';
+import { IMAGE_SIZE, packImage, packPresetMap } from './image';
+import { buildNearestPresetIndex, nearestPresets } from './nearestPreset';
+import { solveImage } from './solve';
+
+describe('Closest Known Preset', () => {
+  it('finds a preset and reports the fields edited away from it', () => {
+    const library = packPresetMap(PRESETS);
+    const index = buildNearestPresetIndex(library.images, library.names);
+    const preset = PRESETS['GFSK 9.99kbps (433.92MHz)'];
+    const image = packImage(preset.registers, preset.paTable);
+
+    const [exact] = nearestPresets(index, image, 1);
+    expect(exact.name).toBe('GFSK 9.99kbps (433.92MHz)');
+    expect(exact.distance).toBe(0);
+    expect(exact.changes).toEqual([]);
+
+    const edited = solveImage({ dataRate: 10.5 }, image);
+    const [near] = nearestPresets(index, edited, 1);
+    expect(near.name).toBe('GFSK 9.99kbps (433.92MHz)');
+    expect(near.changes.map(change => `${change.register}.${change.field}`)).toContain('MDMCFG3.DRATE_M');
+  });
+
+  it('matches a linear scan', () => {
+    const count = 500;
+    const images = new Uint8Array(count * IMAGE_SIZE);
+    const random = (seed: number) => ((seed * 2654435761) >>> 0) / 2 ** 32;
+    const target = (i: number) => ({
+      frequency: 300 + random(i) * 620,
+      modulation: [0, 1, 3, 4, 7][i % 5],
+      dataRate: 0.6 + random(i + 7919) * 250,
+      bandwidth: 58 + random(i + 104729) * 700,
+      deviation: 1.6 + random(i + 1299709) * 300
+    });
+    for (let i = 0; i < count; i++) images.set(solveImage(target(i)), i * IMAGE_SIZE);
+    const index = buildNearestPresetIndex(images, Array.from({ length: count }, (_, i) => `p${i}`));
+
+    for (let q = 0; q < 50; q++) {
+      const image = solveImage(target(count + q));
+      const all = nearestPresets(index, image, count).map(match => match.distance);
+      const top = nearestPresets(index, image, 5);
+      expect(top.map(match => match.distance)).toEqual(all.slice(0, 5));
+    }
+  });
+});
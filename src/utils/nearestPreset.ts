@@ -0,0 +1,169 @@
+/**
+ * Closest Known Preset
+ *
+ * A k-d tree over each preset's derived RF parameters. Frequency, data
+ * rate, bandwidth and deviation are log-scaled over the chip's range so a
+ * full-range difference on any axis costs 1; a modulation mismatch costs
+ * MODULATION_PENALTY. Deviation is ignored for ASK/OOK, which has none.
+ */
+
+import { deriveImage } from './derive';
+import type { ImageDerived } from './derive';
+import { diffRegisterFields } from './diff';
+import type { FieldChange } from './diff';
+import { IMAGE_SIZE, REGISTER_COUNT } from './image';
+
+export interface PresetMatch {
+  id: number;
+  name: string;
+  distance: number;
+  derived: ImageDerived;
+  changes: FieldChange[]; // Register fields from the preset to the query image
+}
+
+export interface NearestPresetIndex {
+  count: number;
+  names: string[];
+  images: Uint8Array;
+  derived: ImageDerived[];
+  points: Float64Array; // DIMENSIONS coordinates per preset
+  // Implicit balanced k-d tree: node = midpoint of its range, split on
+  // axis depth % DIMENSIONS
+  treeIds: Int32Array;
+}
+
+const DIMENSIONS = 5;
+const MODULATION_AXIS = 4;
+const MODULATION_PENALTY = 1;
+
+// [min, max] of each continuous axis, log-scaled between them
+const AXIS_RANGES: [number, number][] = [
+  [300, 928],  // Frequency, MHz
+  [0.6, 500],  // Data rate, kBaud
+  [58, 812],   // Bandwidth, kHz
+  [1.5, 380]   // Deviation, kHz
+];
+
+function scale(value: number, [min, max]: [number, number]): number {
+  const clamped = Math.min(Math.max(value, min), max);
+  return Math.log(clamped / min) / Math.log(max / min);
+}
+
+function toPoint(derived: ImageDerived, point: Float64Array, offset = 0): void {
+  point[offset] = scale(derived.frequency, AXIS_RANGES[0]);
+  point[offset + 1] = scale(derived.dataRate, AXIS_RANGES[1]);
+  point[offset + 2] = scale(derived.bandwidth, AXIS_RANGES[2]);
+  point[offset + 3] = derived.modulation === 3 ? 0 : scale(derived.deviation, AXIS_RANGES[3]);
+  point[offset + MODULATION_AXIS] = derived.modulation;
+}
+
+function axisDistance(axis: number, a: number, b: number): number {
+  if (axis === MODULATION_AXIS) return a === b ? 0 : MODULATION_PENALTY;
+  return Math.abs(a - b);
+}
+
+function buildTree(points: Float64Array, ids: Int32Array, lo: number, hi: number, depth: number): void {
+  if (hi - lo <= 1) return;
+  const axis = depth % DIMENSIONS;
+  ids.subarray(lo, hi).sort((a, b) => points[a * DIMENSIONS + axis] - points[b * DIMENSIONS + axis]);
+  const mid = (lo + hi) >>> 1;
+  buildTree(points, ids, lo, mid, depth + 1);
+  buildTree(points, ids, mid + 1, hi, depth + 1);
+}
+
+function differingBytes(images: Uint8Array, offset: number, image: Uint8Array): number {
+  let count = 0;
+  for (let addr = 0; addr < REGISTER_COUNT; addr++) {
+    if (images[offset + addr] !== image[addr]) count++;
+  }
+  return count;
+}
+
+/**
+ * Index `names.length` packed images
+ */
+export function buildNearestPresetIndex(images: Uint8Array, names: string[]): NearestPresetIndex {
+  const count = Math.min(names.length, Math.floor(images.length / IMAGE_SIZE));
+  const derived: ImageDerived[] = [];
+  const points = new Float64Array(count * DIMENSIONS);
+  for (let i = 0; i < count; i++) {
+    derived.push(deriveImage(images, i * IMAGE_SIZE));
+    toPoint(derived[i], points, i * DIMENSIONS);
+  }
+
+  const treeIds = Int32Array.from({ length: count }, (_, i) => i);
+  buildTree(points, treeIds, 0, count, 0);
+
+  return {
+    count,
+    names: names.slice(0, count),
+    images: images.subarray(0, count * IMAGE_SIZE),
+    derived,
+    points,
+    treeIds
+  };
+}
+
+/**
+ * The `k` presets closest to `image`, nearest first and then by fewest
+ * differing registers, with the register fields that differ from each
+ */
+export function nearestPresets(index: NearestPresetIndex, image: Uint8Array, k = 3): PresetMatch[] {
+  const { points, treeIds } = index;
+  const query = new Float64Array(DIMENSIONS);
+  toPoint(deriveImage(image), query);
+
+  // Best k so far, ascending by distance, then by differing register bytes
+  const bestIds: number[] = [];
+  const bestDistances: number[] = [];
+  const bestBytes: number[] = [];
+  const worst = () => (bestIds.length < k ? Infinity : bestDistances[k - 1]);
+
+  const consider = (id: number) => {
+    let distance = 0;
+    for (let axis = 0; axis < DIMENSIONS; axis++) {
+      const d = axisDistance(axis, query[axis], points[id * DIMENSIONS + axis]);
+      distance += d * d;
+    }
+    distance = Math.sqrt(distance);
+    if (distance > worst()) return;
+    const bytes = differingBytes(index.images, id * IMAGE_SIZE, image);
+    let at = bestIds.length;
+    while (at > 0 && (bestDistances[at - 1] > distance || (bestDistances[at - 1] === distance && bestBytes[at - 1] > bytes))) at--;
+    if (at >= k) return;
+    bestIds.splice(at, 0, id);
+    bestDistances.splice(at, 0, distance);
+    bestBytes.splice(at, 0, bytes);
+    if (bestIds.length > k) {
+      bestIds.pop();
+      bestDistances.pop();
+      bestBytes.pop();
+    }
+  };
+
+  const visit = (lo: number, hi: number, depth: number) => {
+    if (lo >= hi) return;
+    const mid = (lo + hi) >>> 1;
+    const id = treeIds[mid];
+    const axis = depth % DIMENSIONS;
+    const split = points[id * DIMENSIONS + axis];
+    consider(id);
+
+    const nearFirst = query[axis] < split;
+    visit(nearFirst ? lo : mid + 1, nearFirst ? mid : hi, depth + 1);
+    // Every point across the split is at least this far away on this axis;
+    // ties with the split can sit on either side
+    const bound = axisDistance(axis, query[axis], split);
+    if (bound <= worst()) visit(nearFirst ? mid + 1 : lo, nearFirst ? hi : mid, depth + 1);
+  };
+  if (k > 0) visit(0, index.count, 0);
+
+  return bestIds.map((id, i) => {
+    const offset = id * IMAGE_SIZE;
+    const changes: FieldChange[] = [];
+    for (let addr = 0; addr < REGISTER_COUNT; addr++) {
+      changes.push(...diffRegisterFields(addr, index.images[offset + addr], image[addr]));
+    }
+    return { id, name: index.names[id], distance: bestDistances[i], derived: index.derived[id], changes };
+  });
+}
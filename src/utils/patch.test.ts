@@ -0,0 +1,74 @@
+import { describe, it, expect } from 'vitest';
+import { PRESETS } from '../data/registers';
+import { applyPatch, compilePatch, generatePatchReport } from '../utils/patch';
+import { IMAGE_SIZE, packPresetMap } from '../utils/image';
+
+const library = () => packPresetMap(PRESETS);
+
+describe('Bulk Field Patches', () => {
+  it('applies assignments only where predicates match', () => {
+    const { names, images } = library();
+    const patch = compilePatch(`
+when frequency >= 433 and frequency <= 435 and modulation == ASK/OOK
+  FIFOTHR.FIFO_THR = 10
+`);
+    const result = applyPatch(patch, images, names);
+    const ook = names.indexOf('AM 650kHz (433.92MHz)');
+    const am315 = names.indexOf('AM 270kHz (315MHz)');
+
+    expect(result.images[ook * IMAGE_SIZE + 0x03] & 0x0F).toBe(10);
+    expect(result.images[am315 * IMAGE_SIZE + 0x03]).toBe(images[am315 * IMAGE_SIZE + 0x03]);
+    expect(result.report.presets.map(p => p.name)).toContain('AM 650kHz (433.92MHz)');
+    expect(result.report.presets.map(p => p.name)).not.toContain('AM 270kHz (315MHz)');
+  });
+
+  it('does not modify the input unless asked', () => {
+    const { names, images } = library();
+    const before = images.slice();
+    applyPatch(compilePatch('AGCCTRL2 = 0x07'), images, names);
+
+    expect(Array.from(images)).toEqual(Array.from(before));
+
+    applyPatch(compilePatch('AGCCTRL2 = 0x07'), images, names, { inPlace: true });
+    expect(images[0x1B]).toBe(0x07);
+  });
+
+  it('reports field-level changes', () => {
+    const { names, images } = library();
+    const { report } = applyPatch(compilePatch('when name ~ walkie\nMDMCFG2.MOD_FORMAT = GFSK'), images, names);
+
+    expect(report.matched).toBe(1);
+    expect(report.presets[0].changes).toEqual([
+      { addr: 0x12, register: 'MDMCFG2', field: 'MOD_FORMAT', from: 0, to: 1 },
+    ]);
+    expect(generatePatchReport(report)).toContain('MDMCFG2.MOD_FORMAT: 0 -> 1');
+  });
+
+  it('evaluates predicates against the unpatched image', () => {
+    const { names, images } = library();
+    const patch = compilePatch(`
+when MDMCFG2.MOD_FORMAT == ASK/OOK
+  MDMCFG2.MOD_FORMAT = GFSK
+when MDMCFG2.MOD_FORMAT == GFSK
+  DEVIATN = 0x47
+`);
+    const { images: out } = applyPatch(patch, images, names);
+    const ook = names.indexOf('AM 650kHz (433.92MHz)');
+
+    expect(out[ook * IMAGE_SIZE + 0x15]).toBe(images[ook * IMAGE_SIZE + 0x15]);
+  });
+
+  it('counts matches that changed nothing separately', () => {
+    const { names, images } = library();
+    const { report } = applyPatch(compilePatch('when bandwidth > 0\nSYNC1 = 0xD3'), images, names);
+
+    expect(report.matched).toBe(names.length);
+    expect(report.changed).toBeLessThan(report.matched);
+  });
+
+  it('rejects bad patches with the line number', () => {
+    expect(() => compilePatch('when frequency >> 433\nFIFOTHR = 1')).toThrow('Line 1');
+    expect(() => compilePatch('\nFIFOTHR.NOPE = 1')).toThrow('Line 2: unknown field FIFOTHR.NOPE');
+    expect(() => compilePatch('when modulation == QPSK')).toThrow('invalid value');
+  });
+});
@@ -0,0 +1,232 @@
+/**
+ * Bulk Field Patches
+ *
+ * A patch is a list of rules. Each rule is a `when` line with predicates
+ * followed by field assignments in the field config syntax:
+ *
+ *   # Raise the FIFO threshold on every 433 MHz OOK preset
+ *   when frequency >= 433 and frequency <= 435 and modulation == ASK/OOK
+ *     FIFOTHR.FIFO_THR = 10
+ *     AGCCTRL2 = 0x03
+ *
+ * Assignments before the first `when` apply to every preset. Predicates
+ * compare derived values (frequency MHz, dataRate kBaud, bandwidth kHz,
+ * deviation kHz, modulation), any field path, or the preset name (`name ~ text`)
+ * and are evaluated against the image as it was before the patch.
+ */
+
+import { diffRegisterFields } from './diff';
+import type { FieldChange } from './diff';
+import { DERIVED_KEYS, deriveImage, parseModulation } from './derive';
+import type { DerivedKey, ImageDerived } from './derive';
+import { compileFieldPath, readPath, writePath } from './fieldConfig';
+import type { CompiledPath } from './fieldConfig';
+import { forEachLine } from './lines';
+import { IMAGE_SIZE, REGISTER_COUNT } from './image';
+
+type Operator = '==' | '!=' | '<' | '<=' | '>' | '>=' | '~';
+
+interface PatchContext {
+  image: Uint8Array;
+  offset: number;
+  name: string;
+  derived: () => ImageDerived;
+}
+
+type Predicate = (ctx: PatchContext) => boolean;
+
+export interface PatchWrite {
+  path: CompiledPath;
+  value: number;
+}
+
+export interface PatchRule {
+  condition: string; // Source text of the `when` line, '*' for unconditional
+  predicates: Predicate[];
+  writes: PatchWrite[];
+}
+
+export interface CompiledPatch {
+  rules: PatchRule[];
+}
+
+export interface PatchedPreset {
+  index: number;
+  name: string;
+  rules: number[]; // Indices of the rules that matched
+  changes: FieldChange[];
+}
+
+export interface PatchReport {
+  total: number;
+  matched: number;
+  changed: number;
+  presets: PatchedPreset[]; // Presets matched by at least one rule
+}
+
+export interface PatchResult {
+  images: Uint8Array;
+  report: PatchReport;
+}
+
+const TERM_PATTERN = /^([A-Za-z_][\w.[\]:]*)\s*(==|!=|<=|>=|<|>|~)\s*(.+)$/;
+
+function compare(a: number, op: Operator, b: number): boolean {
+  switch (op) {
+    case '==': return a === b;
+    case '!=': return a !== b;
+    case '<': return a < b;
+    case '<=': return a <= b;
+    case '>': return a > b;
+    case '>=': return a >= b;
+    default: return false;
+  }
+}
+
+/**
+ * Compile one `lhs op rhs` term
+ */
+function compileTerm(term: string): Predicate {
+  const match = TERM_PATTERN.exec(term.trim());
+  if (!match) throw new Error(`invalid condition "${term.trim()}"`);
+  const [, lhs, op, rawRhs] = match as unknown as [string, string, Operator, string];
+  const rhs = rawRhs.trim();
+
+  if (lhs.toLowerCase() === 'name') {
+    const needle = rhs.toLowerCase();
+    if (op === '~') return ctx => ctx.name.toLowerCase().includes(needle);
+    if (op === '==') return ctx => ctx.name === rhs;
+    if (op === '!=') return ctx => ctx.name !== rhs;
+    throw new Error(`name supports ~, == and !=`);
+  }
+  if (op === '~') throw new Error(`~ only applies to name`);
+
+  const key = DERIVED_KEYS.find(k => k.toLowerCase() === lhs.toLowerCase());
+  if (key) {
+    const value = key === 'modulation' ? parseModulation(rhs) : parseFloat(rhs);
+    if (value === null || Number.isNaN(value)) throw new Error(`invalid value "${rhs}" for ${key}`);
+    return derivedPredicate(key, op, value);
+  }
+
+  const path = compileFieldPath(lhs);
+  if (!path) throw new Error(`unknown field ${lhs}`);
+  const value = path.parse(rhs);
+  if (value === null) throw new Error(`invalid value "${rhs}" for ${path.path}`);
+  return ctx => compare(readPath(ctx.image, path, ctx.offset), op, value);
+}
+
+function derivedPredicate(key: DerivedKey, op: Operator, value: number): Predicate {
+  return ctx => compare(ctx.derived()[key], op, value);
+}
+
+/**
+ * Compile patch text; errors carry the line number
+ */
+export function compilePatch(text: string): CompiledPatch {
+  const rules: PatchRule[] = [];
+  let current: PatchRule | null = null;
+  let lineNumber = 0;
+
+  forEachLine(text, raw => {
+    lineNumber++;
+    const hash = raw.indexOf('#');
+    const line = (hash === -1 ? raw : raw.slice(0, hash)).trim();
+    if (line.length === 0) return;
+
+    try {
+      if (/^when\s/i.test(line)) {
+        const condition = line.slice(4).trim();
+        current = { condition, predicates: condition.split(/\s+and\s+/i).map(compileTerm), writes: [] };
+        rules.push(current);
+        return;
+      }
+
+      const eq = line.indexOf('=');
+      if (eq === -1) throw new Error(`expected PATH = VALUE or when ..., got "${line}"`);
+      const path = compileFieldPath(line.slice(0, eq));
+      if (!path) throw new Error(`unknown field ${line.slice(0, eq).trim()}`);
+      const valueText = line.slice(eq + 1).trim();
+      const value = path.parse(valueText);
+      if (value === null || value < 0 || value > path.max) {
+        throw new Error(`invalid value "${valueText}" for ${path.path}`);
+      }
+
+      if (current === null) {
+        current = { condition: '*', predicates: [], writes: [] };
+        rules.push(current);
+      }
+      current.writes.push({ path, value });
+    } catch (err) {
+      throw new Error(`Line ${lineNumber}: ${(err as Error).message}`);
+    }
+  });
+
+  return { rules };
+}
+
+/**
+ * Apply a patch to every image in one pass.
+ * Works on a copy unless `inPlace` is set.
+ */
+export function applyPatch(
+  patch: CompiledPatch,
+  images: Uint8Array,
+  names: string[],
+  options: { inPlace?: boolean } = {}
+): PatchResult {
+  const count = Math.floor(images.length / IMAGE_SIZE);
+  const output = options.inPlace ? images : images.slice();
+  const original = new Uint8Array(IMAGE_SIZE);
+  const presets: PatchedPreset[] = [];
+  let changed = 0;
+
+  for (let index = 0; index < count; index++) {
+    const offset = index * IMAGE_SIZE;
+    original.set(images.subarray(offset, offset + IMAGE_SIZE));
+
+    let derived: ImageDerived | null = null;
+    const ctx: PatchContext = {
+      image: original,
+      offset: 0,
+      name: names[index] ?? '',
+      derived: () => (derived ??= deriveImage(original))
+    };
+
+    const matched: number[] = [];
+    patch.rules.forEach((rule, r) => {
+      if (!rule.predicates.every(p => p(ctx))) return;
+      matched.push(r);
+      for (const write of rule.writes) writePath(output, write.path, write.value, offset);
+    });
+    if (matched.length === 0) continue;
+
+    const changes: FieldChange[] = [];
+    for (let addr = 0; addr < REGISTER_COUNT; addr++) {
+      const to = output[offset + addr];
+      if (to !== original[addr]) changes.push(...diffRegisterFields(addr, original[addr], to));
+    }
+    if (changes.length > 0) changed++;
+    presets.push({ index, name: ctx.name, rules: matched, changes });
+  }
+
+  return { images: output, report: { total: count, matched: presets.length, changed, presets } };
+}
+
+/**
+ * Render a change report
+ */
+export function generatePatchReport(report: PatchReport): string {
+  let output = `Patched ${report.changed} of ${report.total} presets`;
+  output += ` (${report.matched} matched)\n`;
+
+  for (const preset of report.presets) {
+    if (preset.changes.length === 0) continue;
+    output += `\n[${preset.name || `#${preset.index}`}]\n`;
+    for (const change of preset.changes) {
+      const path = change.field ? `${change.register}.${change.field}` : `${change.register} (reserved)`;
+      output += `  ${path}: ${change.from} -> ${change.to}\n`;
+    }
+  }
+
+  return output;
+}
@@ -0,0 +1,43 @@
+// @vitest-environment node
+import { bench, describe } from 'vitest';
+import { columnStoreFromImages } from './columnStore';
+import { deriveImage } from './derive';
+import { calculateModulationIndex } from './calculations';
+import { IMAGE_SIZE } from './image';
+import { compilePredicate } from './predicate';
+import { solveImage } from './solve';
+
+const ROWS = 1_000_000;
+const QUERY = 'CHANBW < 100 kHz and modulation index < 0.5 at 868.3 MHz';
+
+// 1M rows cycling through 1024 distinct solved presets
+const distinct = Array.from({ length: 1024 }, (_, i) => solveImage({
+  frequency: [315, 433.92, 868.3, 915][i % 4],
+  modulation: [0, 1, 3, 4, 7][i % 5],
+  dataRate: 1 + (i % 101),
+  bandwidth: 58 + (i % 13) * 50,
+  deviation: 2 + (i % 47)
+}));
+const images = new Uint8Array(ROWS * IMAGE_SIZE);
+for (let i = 0; i < ROWS; i++) images.set(distinct[i & 1023], i * IMAGE_SIZE);
+const store = columnStoreFromImages(images, Array.from({ length: ROWS }, (_, i) => `preset_${i}`));
+const predicate = compilePredicate(QUERY);
+
+describe(`${QUERY} over 1M presets`, () => {
+  bench('compiled predicate over columns', () => {
+    predicate.select(store);
+  });
+
+  bench('deriveImage per row', () => {
+    const out: number[] = [];
+    for (let i = 0; i < ROWS; i++) {
+      const d = deriveImage(images, i * IMAGE_SIZE);
+      if (d.bandwidth < 100 && calculateModulationIndex(d.deviation, d.dataRate) < 0.5 &&
+        d.frequency - d.bandwidth / 2000 <= 868.3 && 868.3 <= d.frequency + d.bandwidth / 2000) out.push(i);
+    }
+  });
+
+  bench('compile', () => {
+    compilePredicate(QUERY);
+  });
+});
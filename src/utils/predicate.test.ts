@@ -0,0 +1,63 @@
+import { describe, it, expect } from 'vitest';
+import { PRESETS } from '../data/registers';
+import { calculateModulationIndex } from './calculations';
+import { columnStoreFromImages } from './columnStore';
+import { deriveImage } from './derive';
+import { IMAGE_SIZE, packPresetMap } from './image';
+import { compilePredicate } from './predicate';
+import { solveImage } from './solve';
+
+describe('Compiled Preset Predicates', () => {
+  const { names, images } = packPresetMap(PRESETS);
+  const store = columnStoreFromImages(images, names);
+  const selected = (text: string) => Array.from(compilePredicate(text).select(store), row => names[row]);
+
+  it('matches derived values, field paths and option labels', () => {
+    expect(selected('modulation == 4-FSK')).toEqual(['4-FSK 9.6kbps (433.92MHz)']);
+    expect(selected('MOD_FORMAT == ASK/OOK and at 315 MHz')).toContain('AM 270kHz (315MHz)');
+    expect(selected('MDMCFG2.MOD_FORMAT == 3 and at 315 MHz')).not.toContain('AM 650kHz (433.92MHz)');
+    expect(selected('frequency > 400 and not (modulation == ASK/OOK or bandwidth >= 0.2 MHz)'))
+      .toContain('GFSK 9.99kbps (433.92MHz)');
+    expect(selected('dataRate < 1 kBaud or dataRate >= 500000 baud')).toEqual(
+      names.filter((_, i) => deriveImage(images, i * IMAGE_SIZE).dataRate < 1)
+    );
+  });
+
+  it('agrees with derived values on every row', () => {
+    const count = 3000;
+    const library = new Uint8Array(count * IMAGE_SIZE);
+    for (let i = 0; i < count; i++) {
+      library.set(solveImage({
+        frequency: [315, 433.92, 868.3, 915][i % 4] + (i % 7) * 0.05,
+        modulation: [0, 1, 3, 4, 7][i % 5],
+        dataRate: 1 + (i % 101),
+        bandwidth: 58 + (i % 13) * 50,
+        deviation: 2 + (i % 47)
+      }), i * IMAGE_SIZE);
+    }
+    const big = columnStoreFromImages(library, Array.from({ length: count }, (_, i) => `p${i}`));
+    const predicate = compilePredicate('CHANBW < 100 kHz and modulation index < 0.5 at 868.3 MHz');
+
+    const expected: number[] = [];
+    for (let i = 0; i < count; i++) {
+      const d = deriveImage(library, i * IMAGE_SIZE);
+      const match = d.bandwidth < 100 &&
+        calculateModulationIndex(d.deviation, d.dataRate) < 0.5 &&
+        d.frequency - d.bandwidth / 2000 <= 868.3 && 868.3 <= d.frequency + d.bandwidth / 2000;
+      if (match) expected.push(i);
+      expect(predicate.test(library, i * IMAGE_SIZE)).toBe(match);
+    }
+    expect(expected.length).toBeGreaterThan(0);
+    expect(Array.from(predicate.select(big))).toEqual(expected);
+    expect(Array.from(predicate.select(big, Uint32Array.from(expected.slice(1))))).toEqual(expected.slice(1));
+  });
+
+  it('reports malformed predicates', () => {
+    expect(() => compilePredicate('')).toThrow('empty predicate');
+    expect(() => compilePredicate('frequency >')).toThrow('unexpected end');
+    expect(() => compilePredicate('NOPE == 1')).toThrow('unknown field NOPE');
+    expect(() => compilePredicate('dataRate > 10 MHz')).toThrow('does not apply');
+    expect(() => compilePredicate('(frequency > 400')).toThrow('unexpected end');
+    expect(() => compilePredicate('modulation == FM')).toThrow('unknown modulation');
+  });
+});
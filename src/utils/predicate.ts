@@ -0,0 +1,297 @@
+/**
+ * Compiled Preset Predicates
+ *
+ * A predicate is terms joined by `and`, `or`, `not` and parentheses;
+ * adjacent terms are joined with `and`:
+ *
+ *   CHANBW < 100 kHz and modulation index < 0.5 at 868 MHz
+ *   modulation == GFSK and (dataRate >= 38.4 or MDMCFG2.SYNC_MODE == 0)
+ *
+ * A term compares a derived value (frequency MHz, dataRate kBaud,
+ * bandwidth kHz, deviation kHz, modulation, modulation index) or any field
+ * path with a number, optionally with a unit, or an option label.
+ * `at <frequency>` holds when the preset's occupied band contains it.
+ *
+ * The predicate is compiled once into JavaScript source that reads the
+ * columns it needs directly, so evaluating a row runs no interpreter.
+ */
+
+import { XOSC_FREQ } from '../data/registers';
+import { REGISTER_LAYOUT } from '../data/registerLayout';
+import { getBandwidthFromRegister, registerToDeviation } from './calculations';
+import type { ColumnStore } from './columnStore';
+import { parseModulation } from './derive';
+import { compileFieldPath } from './fieldConfig';
+import type { CompiledPath } from './fieldConfig';
+import { REGISTER_COUNT } from './image';
+
+type Derived = 'frequency' | 'dataRate' | 'bandwidth' | 'deviation' | 'modulation' | 'modulationIndex';
+
+export interface CompiledPredicate {
+  source: string;
+  code: string; // Generated JavaScript boolean expression
+  select: (store: ColumnStore, rows?: Uint32Array) => Uint32Array;
+  test: (image: Uint8Array, offset?: number) => boolean;
+}
+
+type SelectFn = (columns: Uint8Array[], count: number, rows: Uint32Array | null, out: Uint32Array) => number;
+type TestFn = (image: Uint8Array, offset: number) => boolean;
+
+const OPERATORS: Record<string, string> = { '==': '===', '!=': '!==', '<': '<', '<=': '<=', '>': '>', '>=': '>=' };
+
+// Lower-cased, space-free names of derived values
+const DERIVED_NAMES = new Map<string, Derived>([
+  ['frequency', 'frequency'], ['freq', 'frequency'],
+  ['datarate', 'dataRate'], ['drate', 'dataRate'],
+  ['bandwidth', 'bandwidth'], ['chanbw', 'bandwidth'],
+  ['deviation', 'deviation'],
+  ['modulation', 'modulation'],
+  ['modulationindex', 'modulationIndex']
+]);
+
+const UNITS: Record<string, { scale: number; rate: boolean }> = {
+  hz: { scale: 1, rate: false },
+  khz: { scale: 1e3, rate: false },
+  mhz: { scale: 1e6, rate: false },
+  ghz: { scale: 1e9, rate: false },
+  baud: { scale: 1, rate: true },
+  bps: { scale: 1, rate: true },
+  kbaud: { scale: 1e3, rate: true },
+  kbps: { scale: 1e3, rate: true }
+};
+
+// Unit each derived value is expressed in, as a scale factor
+const DERIVED_SCALE: Record<Derived, number> = {
+  frequency: 1e6,
+  dataRate: 1e3,
+  bandwidth: 1e3,
+  deviation: 1e3,
+  modulation: 1,
+  modulationIndex: 1
+};
+
+// Lookup tables the generated code indexes instead of recomputing per row
+const DRATE_SCALE = Float64Array.from({ length: 16 }, (_, e) => Math.pow(2, e) / Math.pow(2, 28));
+const CHANBW_KHZ = Float64Array.from({ length: 16 }, (_, code) => getBandwidthFromRegister(code << 4));
+const DEVIATION_KHZ = Float64Array.from({ length: 256 }, (_, value) => registerToDeviation(value));
+
+// Per derived value: generated expression over `byte(addr)` and its dependencies
+const DERIVED_CODE: Record<Derived, (byte: (addr: number) => string) => string> = {
+  frequency: b => `((((${b(0x0D)} & 63) << 16) | (${b(0x0E)} << 8) | ${b(0x0F)}) * ${XOSC_FREQ}) / ${65536 * 1000000}`,
+  dataRate: b => `((256 + ${b(0x11)}) * DRATE_SCALE[${b(0x10)} & 15]) * ${XOSC_FREQ} / 1000`,
+  bandwidth: b => `CHANBW_KHZ[${b(0x10)} >> 4]`,
+  deviation: b => `DEVIATION_KHZ[${b(0x15)}]`,
+  modulation: b => `(${b(0x12)} >> 4) & 7`,
+  modulationIndex: () => `dataRate > 0 ? (2 * deviation) / dataRate : 0`
+};
+
+const DERIVED_DEPENDENCIES: Partial<Record<Derived, Derived[]>> = {
+  modulationIndex: ['deviation', 'dataRate']
+};
+
+const TOKEN_PATTERN = /\s*(\(|\)|==|!=|<=|>=|<|>|[^\s()<>=!]+)/y;
+
+function tokenize(text: string): string[] {
+  const tokens: string[] = [];
+  let end = 0;
+  TOKEN_PATTERN.lastIndex = 0;
+  let match: RegExpExecArray | null;
+  while ((match = TOKEN_PATTERN.exec(text)) !== null) {
+    tokens.push(match[1]);
+    end = TOKEN_PATTERN.lastIndex;
+  }
+  if (text.slice(end).trim() !== '') throw new Error(`unexpected "${text.slice(end).trim()}"`);
+  return tokens;
+}
+
+/**
+ * Field path by full path, or by field name alone when only one register
+ * has a field of that name
+ */
+function resolveFieldPath(name: string): CompiledPath | null {
+  const path = compileFieldPath(name);
+  if (path || name.includes('.')) return path;
+  const matches: CompiledPath[] = [];
+  for (let addr = 0; addr < REGISTER_COUNT; addr++) {
+    const reg = REGISTER_LAYOUT[addr];
+    const candidate = reg && compileFieldPath(`${reg.name}.${name}`);
+    if (candidate) matches.push(candidate);
+  }
+  if (matches.length > 1) throw new Error(`${name} is ambiguous: ${matches.map(p => p.path).join(', ')}`);
+  return matches[0] ?? null;
+}
+
+function createParser(tokens: string[], byte: (addr: number) => string, used: Set<Derived>) {
+  let pos = 0;
+  const peek = () => tokens[pos]?.toLowerCase();
+  const next = () => {
+    if (pos >= tokens.length) throw new Error('unexpected end of predicate');
+    return tokens[pos++];
+  };
+
+  const useDerived = (key: Derived): string => {
+    for (const dependency of DERIVED_DEPENDENCIES[key] ?? []) used.add(dependency);
+    used.add(key);
+    return key;
+  };
+
+  // Number with an optional unit, in the unit `key` is expressed in
+  const quantity = (key: Derived): number => {
+    const text = next();
+    const match = /^(-?\d+(?:\.\d+)?)([a-z]*)$/i.exec(text);
+    if (!match) throw new Error(`invalid value "${text}" for ${key}`);
+    let unitName = match[2].toLowerCase();
+    if (unitName === '' && peek() !== undefined && UNITS[peek()!]) unitName = next().toLowerCase();
+    if (unitName === '') return parseFloat(match[1]);
+    const unit = UNITS[unitName];
+    if (!unit) throw new Error(`unknown unit ${match[2]}`);
+    if (unit.rate !== (key === 'dataRate') || DERIVED_SCALE[key] === 1) {
+      throw new Error(`${unitName} does not apply to ${key}`);
+    }
+    return (parseFloat(match[1]) * unit.scale) / DERIVED_SCALE[key];
+  };
+
+  const term = (): string => {
+    if (peek() === 'at') {
+      next();
+      const value = quantity('frequency');
+      const frequency = useDerived('frequency');
+      const bandwidth = useDerived('bandwidth');
+      return `(${frequency} - ${bandwidth} / 2000 <= ${value} && ${value} <= ${frequency} + ${bandwidth} / 2000)`;
+    }
+
+    const words: string[] = [];
+    while (pos < tokens.length && OPERATORS[tokens[pos]] === undefined) words.push(next());
+    if (words.length === 0) throw new Error(`expected a field or value name, got "${tokens[pos] ?? 'end'}"`);
+    const operator = OPERATORS[next()];
+
+    const key = DERIVED_NAMES.get(words.join('').toLowerCase());
+    if (key === 'modulation') {
+      const text = next();
+      const value = parseModulation(text);
+      if (value === null) throw new Error(`unknown modulation ${text}`);
+      return `(${useDerived(key)} ${operator} ${value})`;
+    }
+    if (key) return `(${useDerived(key)} ${operator} ${quantity(key)})`;
+
+    if (words.length > 1) throw new Error(`unknown field ${words.join(' ')}`);
+    const path = resolveFieldPath(words[0]);
+    if (!path) throw new Error(`unknown field ${words[0]}`);
+    let text = next();
+    if (peek() !== undefined && UNITS[peek()!]) text += next();
+    const value = path.parse(text);
+    if (value === null) throw new Error(`invalid value "${text}" for ${path.path}`);
+    const read = path.parts
+      .map(part => `(((${byte(part.addr)} >> ${part.shift}) & ${part.mask}) << ${part.valueShift})`)
+      .join(' | ');
+    return `((${read}) ${operator} ${value})`;
+  };
+
+  const unary = (): string => {
+    if (peek() === 'not') {
+      next();
+      return `!${unary()}`;
+    }
+    if (peek() === '(') {
+      next();
+      const inner = or();
+      if (next() !== ')') throw new Error('expected )');
+      return `(${inner})`;
+    }
+    return term();
+  };
+
+  const and = (): string => {
+    const terms = [unary()];
+    while (pos < tokens.length && peek() !== 'or' && peek() !== ')') {
+      if (peek() === 'and') next();
+      terms.push(unary());
+    }
+    return terms.join(' && ');
+  };
+
+  const or = (): string => {
+    const terms = [and()];
+    while (peek() === 'or') {
+      next();
+      terms.push(and());
+    }
+    return terms.length === 1 ? terms[0] : `(${terms.join(' || ')})`;
+  };
+
+  return {
+    parse: () => {
+      const expression = or();
+      if (pos < tokens.length) throw new Error(`unexpected "${tokens[pos]}"`);
+      return expression;
+    }
+  };
+}
+
+// Expression plus the `const` lines for the derived values it reads, in dependency order
+function generate(tokens: string[], byte: (addr: number) => string): { expression: string; prologue: string } {
+  const used = new Set<Derived>();
+  const expression = createParser(tokens, byte, used).parse();
+  const order: Derived[] = ['frequency', 'dataRate', 'bandwidth', 'deviation', 'modulation', 'modulationIndex'];
+  const prologue = order
+    .filter(key => used.has(key))
+    .map(key => `const ${key} = ${DERIVED_CODE[key](byte)};`)
+    .join('\n');
+  return { expression, prologue };
+}
+
+/**
+ * Compile predicate text; throws on syntax errors and unknown names
+ */
+export function compilePredicate(text: string): CompiledPredicate {
+  const tokens = tokenize(text);
+  if (tokens.length === 0) throw new Error('empty predicate');
+
+  const columnsUsed = new Set<number>();
+  const column = (addr: number) => {
+    columnsUsed.add(addr);
+    return `c${addr}[r]`;
+  };
+  const rowCode = generate(tokens, column);
+  const columnLines = [...columnsUsed].map(addr => `const c${addr} = columns[${addr}];`).join('\n');
+  const selectSource = `
+return function select(columns, count, rows, out) {
+${columnLines}
+let n = 0;
+if (rows === null) {
+  for (let r = 0; r < count; r++) {
+${rowCode.prologue}
+    if (${rowCode.expression}) out[n++] = r;
+  }
+} else {
+  for (let i = 0; i < count; i++) {
+    const r = rows[i];
+${rowCode.prologue}
+    if (${rowCode.expression}) out[n++] = r;
+  }
+}
+return n;
+};`;
+
+  const imageCode = generate(tokens, addr => `image[offset + ${addr}]`);
+  const testSource = `
+return function test(image, offset) {
+${imageCode.prologue}
+return ${imageCode.expression};
+};`;
+
+  const tables = ['DRATE_SCALE', 'CHANBW_KHZ', 'DEVIATION_KHZ'];
+  const select = new Function(...tables, selectSource)(DRATE_SCALE, CHANBW_KHZ, DEVIATION_KHZ) as SelectFn;
+  const test = new Function(...tables, testSource)(DRATE_SCALE, CHANBW_KHZ, DEVIATION_KHZ) as TestFn;
+
+  return {
+    source: text,
+    code: rowCode.expression,
+    select: (store, rows) => {
+      const out = new Uint32Array(rows ? rows.length : store.count);
+      const n = select(store.columns, rows ? rows.length : store.count, rows ?? null, out);
+      return out.slice(0, n);
+    },
+    test: (image, offset = 0) => test(image, offset)
+  };
+}
@@ -0,0 +1,65 @@
+import { describe, it, expect } from 'vitest';
+import { PRESETS } from '../data/registers';
+import { IMAGE_SIZE, packPresetMap } from './image';
+import { solveImage } from './solve';
+import { buildPresetIndex, parseRange, queryPresetIndex } from './presetIndex';
+import type { PresetIndex, PresetQuery } from './presetIndex';
+
+function bruteForce(index: PresetIndex, query: PresetQuery): number[] {
+  const ids: number[] = [];
+  for (let id = 0; id < index.count; id++) {
+    if (query.modulation !== undefined && index.modulation[id] !== query.modulation) continue;
+    if (query.dataRate && (index.dataRate[id] < query.dataRate[0] || index.dataRate[id] > query.dataRate[1])) continue;
+    if (query.bandwidth && (index.bandwidth[id] < query.bandwidth[0] || index.bandwidth[id] > query.bandwidth[1])) continue;
+    if (query.frequency && (index.bandHigh[id] < query.frequency[0] || index.bandLow[id] > query.frequency[1])) continue;
+    ids.push(id);
+  }
+  return ids;
+}
+
+describe('Preset Library Index', () => {
+  it('finds built-in presets by occupied band and modulation', () => {
+    const library = packPresetMap(PRESETS);
+    const index = buildPresetIndex(library.images, library.names);
+    const names = (query: PresetQuery) => queryPresetIndex(index, query).map(id => index.names[id]);
+
+    expect(names({ frequency: [433.8, 434.1], modulation: 1 })).toContain('GFSK 9.99kbps (433.92MHz)');
+    expect(names({ frequency: [433.8, 434.1] })).not.toContain('AM 270kHz (315MHz)');
+    expect(names({ frequency: [315, 315] })).toContain('AM 270kHz (315MHz)');
+    expect(names({ modulation: 4 })).toEqual(['4-FSK 9.6kbps (433.92MHz)']);
+  });
+
+  it('matches a linear scan on a large library', () => {
+    const count = 2000;
+    const images = new Uint8Array(count * IMAGE_SIZE);
+    const bandwidths = [58, 102, 203, 325, 650];
+    for (let i = 0; i < count; i++) {
+      images.set(solveImage({
+        frequency: 300 + ((i * 7919) % 62800) / 100,
+        modulation: [0, 1, 3, 4, 7][i % 5],
+        dataRate: 1 + (i % 97),
+        bandwidth: bandwidths[(i >> 2) % 5]
+      }), i * IMAGE_SIZE);
+    }
+    const index = buildPresetIndex(images, Array.from({ length: count }, (_, i) => `p${i}`));
+
+    const queries: PresetQuery[] = [
+      { frequency: [433.8, 434.1] },
+      { frequency: [868, 868], modulation: 1 },
+      { frequency: [300, 928], dataRate: [10, 20], bandwidth: [100, 210] },
+      { modulation: 3, bandwidth: [600, 700] },
+      { dataRate: [50, 50.5] },
+      {}
+    ];
+    for (const query of queries) {
+      expect(queryPresetIndex(index, query)).toEqual(bruteForce(index, query));
+    }
+  });
+
+  it('parses single values and ranges', () => {
+    expect(parseRange('433.92')).toEqual([433.92, 433.92]);
+    expect(parseRange(' 433.8 - 434.1 ')).toEqual([433.8, 434.1]);
+    expect(parseRange('434-433')).toBeNull();
+    expect(parseRange('abc')).toBeNull();
+  });
+});
@@ -0,0 +1,216 @@
+/**
+ * Preset Library Index
+ *
+ * Built once over packed images:
+ *   - a static interval tree over each preset's occupied band,
+ *     carrier ± bandwidth / 2, for overlap and stabbing queries
+ *   - per-modulation id lists
+ *   - data rate and bandwidth sorted orders for range lookups
+ * A query drives from the most selective index and checks the remaining
+ * conditions against flat columns, so it touches only candidate rows.
+ */
+
+import { deriveImage } from './derive';
+import { IMAGE_SIZE } from './image';
+
+export type Range = [number, number]; // Inclusive
+
+export interface PresetQuery {
+  frequency?: Range;  // MHz; matches presets whose occupied band overlaps it
+  modulation?: number;
+  dataRate?: Range;   // kBaud
+  bandwidth?: Range;  // kHz
+}
+
+interface SortedColumn {
+  values: Float64Array; // Ascending
+  ids: Int32Array;      // Preset id at each position
+}
+
+export interface PresetIndex {
+  count: number;
+  names: string[];
+  frequency: Float64Array;
+  bandLow: Float64Array;
+  bandHigh: Float64Array;
+  modulation: Uint8Array;
+  dataRate: Float64Array;
+  bandwidth: Float64Array;
+  // Interval tree: ids sorted by bandLow, implicit balanced tree over
+  // positions (node = midpoint of its range) with the subtree's max bandHigh
+  treeIds: Int32Array;
+  treeLow: Float64Array;
+  treeMaxHigh: Float64Array;
+  byModulation: Map<number, Int32Array>;
+  byDataRate: SortedColumn;
+  byBandwidth: SortedColumn;
+}
+
+// Drive from a secondary index instead of the tree below this share of rows
+const SECONDARY_DRIVER_RATIO = 1 / 16;
+
+function sortedColumn(column: Float64Array): SortedColumn {
+  const ids = Int32Array.from(column, (_, i) => i).sort((a, b) => column[a] - column[b]);
+  return { values: Float64Array.from(ids, id => column[id]), ids };
+}
+
+function buildMaxHigh(high: Float64Array, maxHigh: Float64Array, lo: number, hi: number): number {
+  if (lo >= hi) return -Infinity;
+  const mid = (lo + hi) >>> 1;
+  const max = Math.max(high[mid], buildMaxHigh(high, maxHigh, lo, mid), buildMaxHigh(high, maxHigh, mid + 1, hi));
+  maxHigh[mid] = max;
+  return max;
+}
+
+/**
+ * Index `names.length` packed images
+ */
+export function buildPresetIndex(images: Uint8Array, names: string[]): PresetIndex {
+  const count = Math.min(names.length, Math.floor(images.length / IMAGE_SIZE));
+  const frequency = new Float64Array(count);
+  const bandLow = new Float64Array(count);
+  const bandHigh = new Float64Array(count);
+  const modulation = new Uint8Array(count);
+  const dataRate = new Float64Array(count);
+  const bandwidth = new Float64Array(count);
+
+  for (let i = 0; i < count; i++) {
+    const derived = deriveImage(images, i * IMAGE_SIZE);
+    frequency[i] = derived.frequency;
+    bandLow[i] = derived.frequency - derived.bandwidth / 2000;
+    bandHigh[i] = derived.frequency + derived.bandwidth / 2000;
+    modulation[i] = derived.modulation;
+    dataRate[i] = derived.dataRate;
+    bandwidth[i] = derived.bandwidth;
+  }
+
+  const treeIds = Int32Array.from(bandLow, (_, i) => i).sort((a, b) => bandLow[a] - bandLow[b]);
+  const treeLow = Float64Array.from(treeIds, id => bandLow[id]);
+  const treeMaxHigh = new Float64Array(count);
+  buildMaxHigh(Float64Array.from(treeIds, id => bandHigh[id]), treeMaxHigh, 0, count);
+
+  const groups = new Map<number, number[]>();
+  for (let i = 0; i < count; i++) {
+    const list = groups.get(modulation[i]);
+    if (list) list.push(i);
+    else groups.set(modulation[i], [i]);
+  }
+  const byModulation = new Map<number, Int32Array>();
+  for (const [mod, ids] of groups) byModulation.set(mod, Int32Array.from(ids));
+
+  return {
+    count,
+    names: names.slice(0, count),
+    frequency,
+    bandLow,
+    bandHigh,
+    modulation,
+    dataRate,
+    bandwidth,
+    treeIds,
+    treeLow,
+    treeMaxHigh,
+    byModulation,
+    byDataRate: sortedColumn(dataRate),
+    byBandwidth: sortedColumn(bandwidth)
+  };
+}
+
+// First position with values[i] >= value
+function lowerBound(values: Float64Array, value: number): number {
+  let lo = 0;
+  let hi = values.length;
+  while (lo < hi) {
+    const mid = (lo + hi) >>> 1;
+    if (values[mid] < value) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+// First position with values[i] > value
+function upperBound(values: Float64Array, value: number): number {
+  let lo = 0;
+  let hi = values.length;
+  while (lo < hi) {
+    const mid = (lo + hi) >>> 1;
+    if (values[mid] <= value) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+function rangeIds(column: SortedColumn, [min, max]: Range): Int32Array {
+  return column.ids.subarray(lowerBound(column.values, min), upperBound(column.values, max));
+}
+
+/**
+ * Ids of presets whose occupied band overlaps [low, high]
+ */
+export function overlappingPresets(index: PresetIndex, low: number, high: number, out: number[] = []): number[] {
+  const { treeIds, treeLow, treeMaxHigh, bandHigh } = index;
+  const visit = (lo: number, hi: number) => {
+    if (lo >= hi) return;
+    const mid = (lo + hi) >>> 1;
+    if (treeMaxHigh[mid] < low) return;
+    visit(lo, mid);
+    if (treeLow[mid] > high) return;
+    if (bandHigh[treeIds[mid]] >= low) out.push(treeIds[mid]);
+    visit(mid + 1, hi);
+  };
+  visit(0, index.count);
+  return out;
+}
+
+function inRange(value: number, range: Range | undefined): boolean {
+  return range === undefined || (value >= range[0] && value <= range[1]);
+}
+
+/**
+ * Ids of presets matching every condition, ascending
+ */
+export function queryPresetIndex(index: PresetIndex, query: PresetQuery): number[] {
+  const { frequency, modulation, dataRate, bandwidth } = query;
+
+  // Secondary candidate lists are O(log n) to size; pick the smallest
+  const secondary: ArrayLike<number>[] = [];
+  if (modulation !== undefined) secondary.push(index.byModulation.get(modulation) ?? []);
+  if (dataRate) secondary.push(rangeIds(index.byDataRate, dataRate));
+  if (bandwidth) secondary.push(rangeIds(index.byBandwidth, bandwidth));
+  const driver = secondary.reduce<ArrayLike<number> | null>(
+    (best, ids) => (best === null || ids.length < best.length ? ids : best),
+    null
+  );
+
+  let candidates: ArrayLike<number>;
+  if (frequency && (driver === null || driver.length > index.count * SECONDARY_DRIVER_RATIO)) {
+    candidates = overlappingPresets(index, frequency[0], frequency[1]);
+  } else if (driver !== null) {
+    candidates = driver;
+  } else {
+    candidates = Int32Array.from({ length: index.count }, (_, i) => i);
+  }
+
+  const result: number[] = [];
+  for (let i = 0; i < candidates.length; i++) {
+    const id = candidates[i];
+    if (modulation !== undefined && index.modulation[id] !== modulation) continue;
+    if (!inRange(index.dataRate[id], dataRate)) continue;
+    if (!inRange(index.bandwidth[id], bandwidth)) continue;
+    if (frequency && (index.bandHigh[id] < frequency[0] || index.bandLow[id] > frequency[1])) continue;
+    result.push(id);
+  }
+  return result.sort((a, b) => a - b);
+}
+
+/**
+ * Parse "433.8-434.1" or a single value "433.92" into a range
+ */
+export function parseRange(text: string): Range | null {
+  const match = /^\s*([\d.]+)\s*(?:-\s*([\d.]+)\s*)?$/.exec(text);
+  if (!match) return null;
+  const low = parseFloat(match[1]);
+  const high = match[2] === undefined ? low : parseFloat(match[2]);
+  if (Number.isNaN(low) || Number.isNaN(high) || high < low) return null;
+  return [low, high];
+}
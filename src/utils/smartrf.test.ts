@@ -0,0 +1,82 @@
+import { describe, it, expect } from 'vitest';
+import { PRESETS } from '../data/registers';
+import {
+  createSmartRfParser,
+  parseSmartRfListing,
+  isSmartRfListing,
+  generateSmartRfListing,
+  generateSmartRfHeader,
+} from '../utils/smartrf';
+import { generateExport } from '../utils/export';
+
+const LISTING = `// Address Config = No address check
+IOCFG0          0x06  GDO0 Output Pin Configuration
+FIFOTHR         0x47  RX FIFO and TX FIFO Thresholds
+FREQ2           0x10  Frequency Control Word, High Byte
+FREQ1           0xB0  Frequency Control Word, Middle Byte
+FREQ0           0x71  Frequency Control Word, Low Byte
+PARTNUM         0x00  Chip ID
+`;
+
+const HEADER = `#ifndef SMARTRF_CC1101_H
+#define SMARTRF_CC1101_H
+
+#define SMARTRF_RADIO_CC1101
+#define SMARTRF_SETTING_FREQ2           0x10
+#define SMARTRF_SETTING_MDMCFG2         0x13
+#define SMARTRF_SETTING_PA_TABLE0       0xC0
+
+#endif
+`;
+
+describe('SmartRF Listings', () => {
+  it('maps listing names to register addresses', () => {
+    const { registers, unknown } = parseSmartRfListing(LISTING);
+
+    expect(registers).toEqual({ 0x02: 0x06, 0x03: 0x47, 0x0D: 0x10, 0x0E: 0xB0, 0x0F: 0x71 });
+    expect(unknown).toEqual(['PARTNUM']);
+  });
+
+  it('parses #define headers and PA table entries', () => {
+    const { registers, paTable } = parseSmartRfListing(HEADER);
+
+    expect(registers).toEqual({ 0x0D: 0x10, 0x12: 0x13 });
+    expect(paTable).toEqual([0xC0, 0, 0, 0, 0, 0, 0, 0]);
+  });
+
+  it('gives the same result for any chunking', () => {
+    const parser = createSmartRfParser();
+    for (let i = 0; i < LISTING.length; i += 5) parser.push(LISTING.slice(i, i + 5));
+
+    expect(parser.end()).toEqual(parseSmartRfListing(LISTING));
+  });
+
+  it('detects listings', () => {
+    expect(isSmartRfListing(LISTING)).toBe(true);
+    expect(isSmartRfListing(HEADER)).toBe(true);
+    expect(isSmartRfListing('02 0D 03 47 00 00 C0 00')).toBe(false);
+  });
+
+  it('round-trips both export layouts', () => {
+    const preset = PRESETS['FM 2-FSK (433.92MHz)'];
+
+    for (const text of [
+      generateSmartRfListing('FSK', preset.registers, preset.paTable),
+      generateSmartRfHeader('FSK', preset.registers, preset.paTable),
+    ]) {
+      const parsed = parseSmartRfListing(text);
+      expect(parsed.registers).toEqual(preset.registers);
+      expect(parsed.paTable).toEqual(preset.paTable);
+      expect(parsed.unknown).toEqual([]);
+    }
+  });
+
+  it('is reachable through generateExport', () => {
+    const preset = PRESETS['FM 2-FSK (433.92MHz)'];
+
+    expect(generateExport('smartrf_listing', 'FSK', preset.registers, preset.paTable))
+      .toContain('FREQ2           0x10  Frequency Control Word, High Byte');
+    expect(generateExport('smartrf_header', 'FSK', preset.registers, preset.paTable))
+      .toContain('#define SMARTRF_SETTING_MDMCFG2         0x03');
+  });
+});
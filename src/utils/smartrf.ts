@@ -0,0 +1,197 @@
+/**
+ * SmartRF Studio Register Listings
+ *
+ * Import and export the two layouts TI's tools emit:
+ *   FREQ2      0x10  Frequency Control Word, High Byte
+ *   #define SMARTRF_SETTING_FREQ2   0x10
+ * PA table entries use PA_TABLE0..7 in both layouts.
+ */
+
+import { REGISTER_LAYOUT } from '../data/registerLayout';
+import { toHex } from './calculations';
+import { createLineSplitter, readTextChunks } from './lines';
+import { PA_TABLE_SIZE, REGISTER_COUNT } from './image';
+
+const DEFINE_PREFIX = '#define';
+const SETTING_PREFIX = 'SMARTRF_SETTING_';
+const PA_PREFIX = 'PA_TABLE';
+
+// Register name -> address
+const ADDRESS_BY_NAME: Map<string, number> = (() => {
+  const map = new Map<string, number>();
+  for (let addr = 0; addr < REGISTER_COUNT; addr++) {
+    const reg = REGISTER_LAYOUT[addr];
+    if (reg) map.set(reg.name, addr);
+  }
+  return map;
+})();
+
+export interface SmartRfListing {
+  registers: Record<number, number>;
+  paTable: number[];
+  unknown: string[]; // Names not in REGISTER_LAYOUT (status registers, other chips)
+}
+
+export interface SmartRfParser {
+  push: (chunk: string) => void;
+  end: () => SmartRfListing;
+}
+
+export interface SmartRfFileResult extends SmartRfListing {
+  name: string;
+}
+
+function isNameChar(c: number): boolean {
+  return (c >= 65 && c <= 90) || (c >= 48 && c <= 57) || c === 95 || (c >= 97 && c <= 122);
+}
+
+function isSpace(c: number): boolean {
+  return c === 32 || c === 9;
+}
+
+function hexDigit(c: number): number {
+  if (c >= 48 && c <= 57) return c - 48;
+  const lower = c | 0x20;
+  return lower >= 97 && lower <= 102 ? lower - 87 : -1;
+}
+
+/**
+ * Create an incremental listing parser. Lines that are not NAME VALUE pairs
+ * (comments, headers, blank lines) are skipped.
+ */
+export function createSmartRfParser(): SmartRfParser {
+  const registers: Record<number, number> = {};
+  const paEntries: number[] = [];
+  const unknown: string[] = [];
+
+  const onLine = (line: string) => {
+    let i = 0;
+    const n = line.length;
+    while (i < n && isSpace(line.charCodeAt(i))) i++;
+
+    if (line.startsWith(DEFINE_PREFIX, i)) {
+      i += DEFINE_PREFIX.length;
+      while (i < n && isSpace(line.charCodeAt(i))) i++;
+    }
+    if (line.startsWith(SETTING_PREFIX, i)) i += SETTING_PREFIX.length;
+
+    const nameStart = i;
+    while (i < n && isNameChar(line.charCodeAt(i))) i++;
+    if (i === nameStart || i === n || !isSpace(line.charCodeAt(i))) return;
+    const name = line.slice(nameStart, i).toUpperCase();
+
+    while (i < n && isSpace(line.charCodeAt(i))) i++;
+    if (line.charCodeAt(i) === 48 && (line.charCodeAt(i + 1) | 0x20) === 120) i += 2; // 0x
+    const valueStart = i;
+    let value = 0;
+    for (let digit = hexDigit(line.charCodeAt(i)); digit >= 0 && i - valueStart < 2; digit = hexDigit(line.charCodeAt(i))) {
+      value = value * 16 + digit;
+      i++;
+    }
+    if (i === valueStart || (i < n && isNameChar(line.charCodeAt(i)))) return;
+
+    const addr = ADDRESS_BY_NAME.get(name);
+    if (addr !== undefined) {
+      registers[addr] = value;
+    } else if (name.startsWith(PA_PREFIX)) {
+      const index = Number(name.slice(PA_PREFIX.length));
+      if (Number.isInteger(index) && index >= 0 && index < PA_TABLE_SIZE) paEntries[index] = value;
+    } else {
+      unknown.push(name);
+    }
+  };
+
+  const splitter = createLineSplitter(onLine);
+
+  return {
+    push: splitter.push,
+    end() {
+      splitter.end();
+      const paTable = paEntries.length > 0
+        ? Array.from({ length: PA_TABLE_SIZE }, (_, i) => paEntries[i] ?? 0)
+        : [];
+      return { registers, paTable, unknown };
+    }
+  };
+}
+
+/**
+ * Parse a complete listing
+ */
+export function parseSmartRfListing(text: string): SmartRfListing {
+  const parser = createSmartRfParser();
+  parser.push(text);
+  return parser.end();
+}
+
+/**
+ * Quick check used to route pasted text to this importer
+ */
+export function isSmartRfListing(text: string): boolean {
+  return text.includes(SETTING_PREFIX) || /^\s*(IOCFG2|FREQ2|MDMCFG4)\s+(0x)?[0-9a-f]{1,2}\b/im.test(text);
+}
+
+/**
+ * Stream a set of listing files through the parser, one at a time
+ */
+export async function readSmartRfFiles(files: Iterable<File>): Promise<SmartRfFileResult[]> {
+  const results: SmartRfFileResult[] = [];
+  for (const file of files) {
+    const parser = createSmartRfParser();
+    await readTextChunks(file, text => parser.push(text));
+    results.push({ name: file.name.replace(/\.[^.]+$/, ''), ...parser.end() });
+  }
+  return results;
+}
+
+function settingLines(
+  registers: Record<number, number>,
+  paTable: number[],
+  format: (name: string, value: number, description: string) => string
+): string {
+  let output = '';
+  for (let addr = 0; addr < REGISTER_COUNT; addr++) {
+    const value = registers[addr];
+    const reg = REGISTER_LAYOUT[addr];
+    if (value !== undefined && reg) {
+      output += format(reg.name, value, reg.description) + '\n';
+    }
+  }
+  paTable.forEach((value, index) => {
+    output += format(`${PA_PREFIX}${index}`, value, `PA Table Entry ${index}`) + '\n';
+  });
+  return output;
+}
+
+/**
+ * Generate SmartRF Studio register listing
+ */
+export function generateSmartRfListing(
+  presetName: string,
+  registers: Record<number, number>,
+  paTable: number[]
+): string {
+  let output = `// CC1101 Register Settings: ${presetName}\n`;
+  output += `// Generated by CC1101 Register Editor\n\n`;
+  output += settingLines(registers, paTable,
+    (name, value, description) => `${name.padEnd(16)}0x${toHex(value)}  ${description}`);
+  return output;
+}
+
+/**
+ * Generate SmartRF Studio #define header
+ */
+export function generateSmartRfHeader(
+  presetName: string,
+  registers: Record<number, number>,
+  paTable: number[]
+): string {
+  const guard = `SMARTRF_${presetName.replace(/[^a-zA-Z0-9_]/g, '_').toUpperCase()}_H`;
+  let output = `// CC1101 Register Settings: ${presetName}\n`;
+  output += `// Generated by CC1101 Register Editor\n\n`;
+  output += `#ifndef ${guard}\n#define ${guard}\n\n`;
+  output += settingLines(registers, paTable,
+    (name, value) => `#define ${SETTING_PREFIX}${name.padEnd(16)}0x${toHex(value)}`);
+  output += `\n#endif // ${guard}\n`;
+  return output;
+}
@@ -0,0 +1,32 @@
+import { describe, it, expect } from 'vitest';
+import { PRESETS } from '../data/registers';
+import { deriveImage } from './derive';
+import { packImage, REGISTER_COUNT } from './image';
+import { solveImage } from './solve';
+
+describe('RF Parameter Solver', () => {
+  it('hits the requested RF parameters', () => {
+    const image = solveImage({ frequency: 868.3, modulation: 1, dataRate: 38.4, bandwidth: 100, deviation: 20 });
+    const derived = deriveImage(image);
+
+    expect(derived.frequency).toBeCloseTo(868.3, 2);
+    expect(derived.modulation).toBe(1);
+    expect(derived.dataRate).toBeCloseTo(38.4, 0);
+    expect(derived.bandwidth).toBeCloseTo(102, 0);
+    expect(derived.deviation).toBeCloseTo(20.6, 1);
+  });
+
+  it('keeps the base image for unset targets and sets up OOK power', () => {
+    const preset = PRESETS['GFSK 9.99kbps (433.92MHz)'];
+    const base = packImage(preset.registers, preset.paTable);
+    const image = solveImage({ modulation: 3 }, base);
+
+    expect(image[0x10]).toBe(base[0x10]);
+    expect(image[0x11]).toBe(base[0x11]);
+    expect(image[0x12] & 0x70).toBe(0x30);
+    expect(image[0x22] & 0x07).toBe(1);
+    expect(image[REGISTER_COUNT]).toBe(0x00);
+    expect(image[REGISTER_COUNT + 1]).not.toBe(0x00);
+    expect(base[0x12]).toBe(preset.registers[0x12]);
+  });
+});
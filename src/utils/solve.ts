@@ -0,0 +1,86 @@
+/**
+ * RF Parameter Solver
+ * Writes target RF parameters into an image with the same register updates
+ * the editor's setters apply (see useRegisters), except that any bandwidth
+ * is accepted and rounded up to a filter setting.
+ */
+
+import {
+  dataRateToRegisters,
+  deviationToRegister,
+  frequencyToRegisters,
+  getBandwidthFromRegister,
+  getPaTable
+} from './calculations';
+import { deriveImage } from './derive';
+import { DEFAULT_PA_TABLE, REGISTER_COUNT, packImage } from './image';
+
+export interface SolveTargets {
+  frequency?: number;  // MHz
+  modulation?: number; // MDMCFG2.MOD_FORMAT
+  dataRate?: number;   // kBaud
+  bandwidth?: number;  // kHz, rounded up to the next filter setting
+  deviation?: number;  // kHz
+  power?: number;      // dBm, picks the PA table entry
+}
+
+/**
+ * MDMCFG4[7:4] for the narrowest channel filter at least `bwKHz` wide,
+ * or the widest filter when none is
+ */
+export function solveChannelBandwidth(bwKHz: number): number {
+  let best = 0x00;
+  let bestWidth = Infinity;
+  for (let code = 0; code < 16; code++) {
+    const width = getBandwidthFromRegister(code << 4);
+    if (width >= bwKHz && width < bestWidth) {
+      best = code << 4;
+      bestWidth = width;
+    }
+  }
+  return best;
+}
+
+export const SOLVE_KEYS: (keyof SolveTargets)[] = ['frequency', 'modulation', 'dataRate', 'bandwidth', 'deviation', 'power'];
+
+/**
+ * Apply targets to a copy of `base` (reset values by default). Unset
+ * targets keep the base's settings; the PA table is rebuilt when frequency,
+ * modulation or power is set.
+ */
+export function solveImage(targets: SolveTargets, base?: Uint8Array): Uint8Array {
+  const image = base ? base.slice() : packImage({}, DEFAULT_PA_TABLE);
+
+  if (targets.modulation !== undefined) {
+    if (!Number.isInteger(targets.modulation) || targets.modulation < 0 || targets.modulation > 7) {
+      throw new Error(`Invalid modulation ${targets.modulation}`);
+    }
+    image[0x12] = (image[0x12] & 0x8F) | (targets.modulation << 4);
+    // ASK/OOK transmits PATABLE[1] for a '1', FSK variants PATABLE[0]
+    image[0x22] = (image[0x22] & 0xF8) | (targets.modulation === 3 ? 0x01 : 0x00);
+  }
+  if (targets.frequency !== undefined) {
+    const { FREQ2, FREQ1, FREQ0 } = frequencyToRegisters(targets.frequency);
+    image[0x0D] = FREQ2;
+    image[0x0E] = FREQ1;
+    image[0x0F] = FREQ0;
+  }
+  if (targets.dataRate !== undefined) {
+    const { DRATE_E, DRATE_M } = dataRateToRegisters(targets.dataRate);
+    image[0x10] = (image[0x10] & 0xF0) | (DRATE_E & 0x0F);
+    image[0x11] = DRATE_M;
+  }
+  if (targets.bandwidth !== undefined) {
+    image[0x10] = (image[0x10] & 0x0F) | solveChannelBandwidth(targets.bandwidth);
+  }
+  if (targets.deviation !== undefined) {
+    image[0x15] = deviationToRegister(targets.deviation);
+  }
+
+  if (targets.frequency !== undefined || targets.modulation !== undefined || targets.power !== undefined) {
+    const derived = deriveImage(image);
+    image.set(getPaTable(derived.frequency, targets.power ?? 10, derived.modulation === 3), REGISTER_COUNT);
+  }
+
+  return image;
+}
@@ -0,0 +1,93 @@
+/**
+ * CC1101 SPI Access Model
+ * Header byte layout and command strobes per datasheet section 10
+ */
+
+export const WRITE_BURST = 0x40;
+export const READ_SINGLE = 0x80;
+export const PATABLE_ADDR = 0x3E;
+
+export const STROBES = {
+  SRES: 0x30,
+  SFSTXON: 0x31,
+  SXOFF: 0x32,
+  SCAL: 0x33,
+  SRX: 0x34,
+  STX: 0x35,
+  SIDLE: 0x36,
+  SWOR: 0x38,
+  SPWD: 0x39,
+  SFRX: 0x3A,
+  SFTX: 0x3B,
+  SWORRST: 0x3C,
+  SNOP: 0x3D
+} as const;
+
+export type StrobeName = keyof typeof STROBES;
+
+// Burst access is limited to 6.5 MHz SCLK
+export const SPI_CLOCK_HZ = 6500000;
+
+// CSn assert + CHIP_RDYn wait, expressed in byte times
+export const TRANSACTION_OVERHEAD = 1;
+
+// Manual calibration (SCAL) duration at 26 MHz XOSC
+export const CALIBRATION_US = 721;
+
+export interface BurstRange {
+  start: number;
+  length: number;
+}
+
+/**
+ * Coalesce register addresses into write transactions.
+ * Two runs are merged when rewriting the unchanged registers between them
+ * costs fewer bytes than opening another transaction.
+ */
+export function coalesceAddresses(
+  addresses: Iterable<number>,
+  overhead = TRANSACTION_OVERHEAD
+): BurstRange[] {
+  const sorted = Array.from(new Set(addresses)).sort((a, b) => a - b);
+  const ranges: BurstRange[] = [];
+
+  for (const addr of sorted) {
+    const last = ranges[ranges.length - 1];
+    if (last) {
+      const gap = addr - (last.start + last.length);
+      if (gap < 1 + overhead) {
+        last.length += gap + 1;
+        continue;
+      }
+    }
+    ranges.push({ start: addr, length: 1 });
+  }
+
+  return ranges;
+}
+
+/**
+ * SPI bytes needed to write the given ranges (header + data per transaction)
+ */
+export function rangesByteCost(ranges: BurstRange[]): number {
+  return ranges.reduce((sum, r) => sum + 1 + r.length, 0);
+}
+
+/**
+ * Header byte for a register write
+ */
+export function writeHeader(addr: number, burst: boolean): number {
+  return burst ? addr | WRITE_BURST : addr;
+}
+
+/**
+ * Estimated bus time for a sequence of transactions
+ */
+export function spiTimeUs(
+  bytes: number,
+  transactions: number,
+  clockHz = SPI_CLOCK_HZ,
+  overhead = TRANSACTION_OVERHEAD
+): number {
+  return ((bytes + transactions * overhead) * 8 * 1000000) / clockHz;
+}
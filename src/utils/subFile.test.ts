@@ -0,0 +1,104 @@
+import { describe, it, expect, vi } from 'vitest';
+import { PRESETS } from '../data/registers';
+import { FLIPPER_SUB_PRESETS, createSubFileParser, parseSubFile, resolveSubPreset } from '../utils/subFile';
+import { createLineSplitter } from '../utils/lines';
+import { generateFlipperPresetData } from '../utils/export';
+import { registersToFrequency } from '../utils/calculations';
+
+const RAW_CAPTURE = `Filetype: Flipper SubGhz RAW File
+Version: 1
+Frequency: 315000000
+Preset: FuriHalSubGhzPresetOok650Async
+Protocol: RAW
+RAW_Data: 361 -68 2053 -100 -1220
+RAW_Data: 97 -3464 65 -130
+`;
+
+describe('Line Splitter', () => {
+  it('joins lines across chunk boundaries and strips CRLF', () => {
+    const lines: string[] = [];
+    const splitter = createLineSplitter(line => lines.push(line));
+    splitter.push('Frequ');
+    splitter.push('ency: 1\r\nPre');
+    splitter.push('set: X\nlast');
+    splitter.end();
+
+    expect(lines).toEqual(['Frequency: 1', 'Preset: X', 'last']);
+  });
+});
+
+describe('.sub Import', () => {
+  it('maps a built-in preset and applies the file frequency', () => {
+    const { preset } = parseSubFile(RAW_CAPTURE);
+    const base = PRESETS['AM 650kHz (433.92MHz)'];
+
+    expect(preset?.name).toBe('FuriHalSubGhzPresetOok650Async');
+    expect(preset?.registers[0x10]).toBe(base.registers[0x10]);
+    expect(registersToFrequency(preset!.registers[0x0D], preset!.registers[0x0E], preset!.registers[0x0F]))
+      .toBeCloseTo(315, 2);
+  });
+
+  it('resolves every firmware preset from the standard chunk', () => {
+    for (const [name, { preset, overrides }] of Object.entries(FLIPPER_SUB_PRESETS)) {
+      const resolved = resolveSubPreset(name, null, null);
+      expect(resolved.registers).toEqual({ ...PRESETS[preset].registers, ...overrides });
+      expect(resolved.paTable).toEqual(PRESETS[preset].paTable);
+    }
+  });
+
+  it('parses RAW_Data into signed pulse durations', () => {
+    const { pulses, protocol } = parseSubFile(RAW_CAPTURE);
+
+    expect(protocol).toBe('RAW');
+    expect(pulses).toBeInstanceOf(Int32Array);
+    expect(Array.from(pulses)).toEqual([361, -68, 2053, -100, -1220, 97, -3464, 65, -130]);
+  });
+
+  it('reads Custom_preset_data presets', () => {
+    const fsk = PRESETS['FM 2-FSK (433.92MHz)'];
+    const text = `Filetype: Flipper SubGhz RAW File
+Version: 1
+Frequency: 433920000
+Preset: FuriHalSubGhzPresetCustom
+Custom_preset_module: CC1101
+Custom_preset_data: ${generateFlipperPresetData(fsk.registers, fsk.paTable)}
+Protocol: RAW
+RAW_Data: 10 -20
+`;
+    const { preset } = parseSubFile(text);
+
+    expect(preset?.registers[0x12]).toBe(fsk.registers[0x12]);
+    expect(preset?.paTable).toEqual(fsk.paTable);
+  });
+
+  it('reports the preset before any RAW_Data is consumed', () => {
+    const parser = createSubFileParser(vi.fn());
+    let pulsesAtPreset = -1;
+    const streaming = createSubFileParser(() => { pulsesAtPreset = streaming.pulseCount(); });
+
+    for (let i = 0; i < RAW_CAPTURE.length; i += 7) {
+      streaming.push(RAW_CAPTURE.slice(i, i + 7));
+      parser.push(RAW_CAPTURE.slice(i, i + 7));
+    }
+
+    expect(pulsesAtPreset).toBe(0);
+    expect(streaming.end().pulses).toEqual(parser.end().pulses);
+  });
+
+  it('records unsupported presets without dropping the capture', () => {
+    const result = parseSubFile(RAW_CAPTURE.replace('Ook650Async', 'MSK99_97KbAsync'));
+
+    expect(result.preset).toBeNull();
+    expect(result.presetError).toContain('Unsupported preset');
+    expect(result.pulses).toHaveLength(9);
+  });
+
+  it('handles large captures', () => {
+    const line = 'RAW_Data: ' + Array.from({ length: 512 }, (_, i) => (i % 2 ? -(i + 1) : i + 1)).join(' ') + '\n';
+    const text = RAW_CAPTURE.split('RAW_Data')[0] + line.repeat(2000);
+    const { pulses } = parseSubFile(text);
+
+    expect(pulses).toHaveLength(512 * 2000);
+    expect(pulses[pulses.length - 1]).toBe(-512);
+  });
+});
@@ -0,0 +1,216 @@
+/**
+ * Flipper Zero .sub Capture Import
+ * Incremental parser: the radio preset is reported as soon as the header is
+ * complete, RAW_Data timings are accumulated into a growable Int32Array.
+ */
+
+import { decodePresetDelta } from '../data/presetCatalog';
+import { PRESET_CHUNK } from '../data/presetsStandard';
+import type { PresetConfig } from '../types/cc1101';
+import { frequencyToRegisters } from './calculations';
+import { parseFlipperPresetData } from './export';
+import { createLineSplitter } from './lines';
+
+// Built-in firmware presets and the closest editor preset.
+// DEVIATN overrides carry the firmware's deviation for the FSK variants.
+export const FLIPPER_SUB_PRESETS: Record<string, { preset: string; overrides?: Record<number, number> }> = {
+  FuriHalSubGhzPresetOok270Async: { preset: 'AM 270kHz (315MHz)' },
+  FuriHalSubGhzPresetOok650Async: { preset: 'AM 650kHz (433.92MHz)' },
+  FuriHalSubGhzPreset2FSKDev238Async: { preset: 'FM 2-FSK (433.92MHz)', overrides: { 0x15: 0x04 } },
+  FuriHalSubGhzPreset2FSKDev476Async: { preset: 'FM 2-FSK (433.92MHz)', overrides: { 0x15: 0x47 } },
+  FuriHalSubGhzPresetGFSK9_99KbAsync: { preset: 'GFSK 9.99kbps (433.92MHz)' }
+};
+
+export const CUSTOM_SUB_PRESET = 'FuriHalSubGhzPresetCustom';
+
+/**
+ * An editor preset from the compiled standard chunk, so the import worker
+ * and library reader never bundle PRESETS and its keyfob entries
+ */
+function standardPreset(name: string): PresetConfig {
+  const delta = PRESET_CHUNK.find(row => row[0] === name);
+  if (!delta) throw new Error(`Built-in preset ${name} is missing`);
+  return decodePresetDelta(delta);
+}
+
+export interface SubPreset {
+  name: string;              // Preset: value from the file
+  frequency: number | null;  // Hz
+  registers: Record<number, number>;
+  paTable: number[];
+}
+
+export interface SubFileResult {
+  preset: SubPreset | null;
+  presetError: string | null;
+  protocol: string | null;
+  pulses: Int32Array;        // Signed durations in us: positive = high, negative = low
+  lines: number;
+}
+
+export interface SubFileParser {
+  push: (chunk: string) => void;
+  end: () => SubFileResult;
+  pulseCount: () => number;
+}
+
+// Messages posted by the import worker
+export type SubImportMessage =
+  | { type: 'preset'; preset: SubPreset }
+  | { type: 'progress'; loaded: number; total: number; pulses: number }
+  | { type: 'done'; pulses: Int32Array; protocol: string | null; presetError: string | null }
+  | { type: 'error'; message: string };
+
+const INITIAL_PULSE_CAPACITY = 4096;
+
+/**
+ * Resolve the header fields to a register image
+ */
+export function resolveSubPreset(
+  name: string,
+  frequency: number | null,
+  customData: string | null
+): SubPreset {
+  let registers: Record<number, number>;
+  let paTable: number[];
+
+  if (name === CUSTOM_SUB_PRESET) {
+    if (customData === null) throw new Error('Custom preset without Custom_preset_data');
+    ({ registers, paTable } = parseFlipperPresetData(customData));
+  } else {
+    const mapping = FLIPPER_SUB_PRESETS[name];
+    if (!mapping) throw new Error(`Unsupported preset ${name}`);
+    const preset = standardPreset(mapping.preset);
+    registers = { ...preset.registers, ...mapping.overrides };
+    paTable = [...preset.paTable];
+  }
+
+  if (frequency !== null) {
+    const { FREQ2, FREQ1, FREQ0 } = frequencyToRegisters(frequency / 1e6);
+    registers = { ...registers, 0x0D: FREQ2, 0x0E: FREQ1, 0x0F: FREQ0 };
+  }
+
+  return { name, frequency, registers, paTable };
+}
+
+/**
+ * Create an incremental .sub parser. `onPreset` fires once, before any
+ * RAW_Data is consumed.
+ */
+export function createSubFileParser(onPreset?: (preset: SubPreset) => void): SubFileParser {
+  let frequency: number | null = null;
+  let presetName: string | null = null;
+  let customData: string | null = null;
+  let protocol: string | null = null;
+  let preset: SubPreset | null = null;
+  let presetError: string | null = null;
+  let headerDone = false;
+  let lines = 0;
+
+  let pulses = new Int32Array(INITIAL_PULSE_CAPACITY);
+  let count = 0;
+
+  const finishHeader = () => {
+    if (headerDone) return;
+    headerDone = true;
+    if (presetName === null) {
+      presetError = 'No Preset line';
+      return;
+    }
+    try {
+      preset = resolveSubPreset(presetName, frequency, customData);
+      onPreset?.(preset);
+    } catch (err) {
+      presetError = (err as Error).message;
+    }
+  };
+
+  const pushPulse = (value: number) => {
+    if (count === pulses.length) {
+      const grown = new Int32Array(pulses.length * 2);
+      grown.set(pulses);
+      pulses = grown;
+    }
+    pulses[count++] = value;
+  };
+
+  // Hand-rolled integer scan: RAW_Data can be megabytes, avoid split()
+  const parseRawData = (line: string, start: number) => {
+    let value = 0;
+    let sign = 1;
+    let inNumber = false;
+    for (let i = start; i < line.length; i++) {
+      const c = line.charCodeAt(i);
+      if (c >= 48 && c <= 57) {
+        value = value * 10 + (c - 48);
+        inNumber = true;
+      } else if (c === 45 && !inNumber) {
+        sign = -1;
+      } else {
+        if (inNumber) pushPulse(sign * value);
+        value = 0;
+        sign = 1;
+        inNumber = false;
+      }
+    }
+    if (inNumber) pushPulse(sign * value);
+  };
+
+  const onLine = (line: string) => {
+    lines++;
+    const colon = line.indexOf(':');
+    if (colon === -1) return;
+    const key = line.slice(0, colon).trim();
+
+    if (key === 'RAW_Data') {
+      finishHeader();
+      parseRawData(line, colon + 1);
+      return;
+    }
+
+    const value = line.slice(colon + 1).trim();
+    switch (key) {
+      case 'Frequency':
+        frequency = Number(value);
+        if (!Number.isFinite(frequency)) frequency = null;
+        break;
+      case 'Preset':
+        presetName = value;
+        break;
+      case 'Custom_preset_data':
+        customData = value;
+        break;
+      case 'Protocol':
+        protocol = value;
+        finishHeader();
+        break;
+    }
+  };
+
+  const splitter = createLineSplitter(onLine);
+
+  return {
+    push: splitter.push,
+    end() {
+      splitter.end();
+      finishHeader();
+      return {
+        preset,
+        presetError,
+        protocol,
+        pulses: pulses.slice(0, count),
+        lines
+      };
+    },
+    pulseCount: () => count
+  };
+}
+
+/**
+ * Parse a complete .sub file held in memory
+ */
+export function parseSubFile(text: string): SubFileResult {
+  const parser = createSubFileParser();
+  parser.push(text);
+  return parser.end();
+}
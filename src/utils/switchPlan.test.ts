@@ -0,0 +1,91 @@
+import { describe, it, expect } from 'vitest';
+import { PRESETS } from '../data/registers';
+import {
+  planModeSwitching,
+  generateSwitchPlanCArray,
+  generateSwitchPlanReport,
+} from '../utils/switchPlan';
+import { FULL_REWRITE_BYTES } from '../utils/diff';
+
+describe('Multi-Mode Switching Plan', () => {
+  const modeNames = [
+    'FM 2-FSK (433.92MHz)',
+    'GFSK 9.99kbps (433.92MHz)',
+    'SubGHz Chat (433.92MHz)',
+    '4-FSK 9.6kbps (433.92MHz)',
+  ];
+  const modes = modeNames.map(name => ({ name, ...PRESETS[name] }));
+
+  it('beats a full rewrite for every switch', () => {
+    const plan = planModeSwitching(modes);
+
+    expect(plan.worstBytes).toBeLessThan(FULL_REWRITE_BYTES);
+    expect(plan.averageBytes).toBeLessThanOrEqual(plan.worstBytes);
+  });
+
+  it('never does better than direct pairwise diffs', () => {
+    const plan = planModeSwitching(modes, 'average');
+
+    expect(plan.averageBytes).toBeGreaterThanOrEqual(plan.pairwiseAverageBytes);
+  });
+
+  it('keeps registers shared by all modes out of the deltas', () => {
+    const plan = planModeSwitching(modes);
+
+    // FSCTRL1 is 0x06 in every mode
+    expect(plan.baseRegisters[0x0B]).toBe(0x06);
+    for (const mode of plan.modes) {
+      expect(mode.addresses).not.toContain(0x0B);
+    }
+  });
+
+  it('reproduces each mode from base plus delta', () => {
+    const plan = planModeSwitching(modes);
+
+    plan.modes.forEach((mode, i) => {
+      const image = [...plan.baseRegisters];
+      for (const addr of mode.addresses) image[addr] = plan.images[i][addr];
+      expect(image).toEqual(Array.from(plan.images[i].subarray(0, 0x2F)));
+    });
+  });
+
+  it('picks the majority PA table as base', () => {
+    const plan = planModeSwitching(modes);
+
+    expect(plan.basePaTable[0]).toBe(0xC0);
+    expect(plan.modes[3].paTable).not.toBeNull();
+  });
+
+  it('costs nothing for a single mode', () => {
+    const plan = planModeSwitching(modes.slice(0, 1));
+
+    expect(plan.worstBytes).toBe(0);
+    expect(plan.modes[0].addresses).toHaveLength(0);
+  });
+
+  it('emits C tables', () => {
+    const result = generateSwitchPlanCArray('radio modes', planModeSwitching(modes));
+
+    expect(result).toContain('static const uint8_t radio_modes_base_registers[]');
+    expect(result).toContain('static const uint64_t radio_modes_delta_mask[]');
+    expect(result).toContain('radio_modes_3_4_FSK_9_6kbps__433_92MHz__delta[]');
+  });
+
+  it('strobes SCAL when a switch retunes a mode without auto-calibration', () => {
+    // Channel 1 of the first mode, calibrated manually (FS_AUTOCAL = 0)
+    const manual = { ...modes[0], name: 'Manual', registers: { ...modes[0].registers, 0x0A: 1, 0x18: 0x08 } };
+    const plan = planModeSwitching([modes[0], manual]);
+
+    expect(plan.calibration).toEqual([['none', 'strobe'], ['auto', 'none']]);
+    expect(plan.worstBytes).toBe(plan.pairwiseWorstBytes);
+    expect(generateSwitchPlanCArray('m', plan)).toContain('static const uint8_t m_scal[2][2] = {\n    { 0, 1 },');
+    expect(generateSwitchPlanCArray('radio', planModeSwitching(modes))).not.toContain('_scal');
+  });
+
+  it('reports savings against full rewrites', () => {
+    const report = generateSwitchPlanReport(planModeSwitching(modes));
+
+    expect(report).toContain('Full rewrite');
+    expect(report).toContain('Shared base');
+  });
+});
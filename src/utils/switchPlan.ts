@@ -0,0 +1,328 @@
+/**
+ * Multi-Mode Switching Plan
+ * Picks a shared base image programmed once at boot and per-mode delta tables
+ * that keep mode-switch SPI traffic low.
+ *
+ * Switching from mode j to mode k writes every register in which either mode
+ * differs from the base: k's value where k differs, the base value otherwise.
+ * When j and k differ in a synthesizer field and k does not auto-calibrate,
+ * the switch ends with an SCAL strobe, as in a differential reconfiguration.
+ */
+
+import { REGISTER_LAYOUT } from '../data/registerLayout';
+import { toHex } from './calculations';
+import { FULL_REWRITE_BYTES, calibrationFor, diffRegisterFields } from './diff';
+import type { CalibrationMode, FieldChange } from './diff';
+import { packImage, REGISTER_COUNT, PA_TABLE_SIZE } from './image';
+import { coalesceAddresses, rangesByteCost, TRANSACTION_OVERHEAD } from './spi';
+
+export interface ModeInput {
+  name: string;
+  registers: Record<number, number>;
+  paTable: number[];
+}
+
+export type SwitchObjective = 'worst' | 'average';
+
+export interface ModeDelta {
+  name: string;
+  addresses: number[]; // Registers that differ from the base image
+  paTable: number[] | null; // Mode PA table when it differs from the base
+}
+
+export interface SwitchPlan {
+  objective: SwitchObjective;
+  baseRegisters: number[];
+  basePaTable: number[];
+  modes: ModeDelta[];
+  images: Uint8Array[];
+  calibration: CalibrationMode[][]; // [j][k]: after switching from mode j to mode k
+  worstBytes: number;
+  averageBytes: number;
+  pairwiseWorstBytes: number;
+  pairwiseAverageBytes: number;
+  fullBytes: number;
+}
+
+interface Score {
+  worst: number;
+  average: number;
+}
+
+function transitionBytes(
+  addresses: number[],
+  writesPaTable: boolean,
+  calibration: CalibrationMode,
+  overhead: number
+): number {
+  if (addresses.length === 0 && !writesPaTable) return 0;
+  const paBytes = writesPaTable ? 1 + PA_TABLE_SIZE : 0;
+  const scalBytes = calibration === 'strobe' ? 1 : 0;
+  return 1 + rangesByteCost(coalesceAddresses(addresses, overhead)) + paBytes + scalBytes;
+}
+
+/**
+ * Calibration of every ordered switch. The radio ends up at mode k's image
+ * whatever the base, so this depends only on the two modes.
+ */
+function planCalibration(images: Uint8Array[]): CalibrationMode[][] {
+  return images.map((from, j) => images.map((to, k): CalibrationMode => {
+    if (j === k) return 'none';
+    const changes: FieldChange[] = [];
+    for (let addr = 0; addr < REGISTER_COUNT; addr++) {
+      if (from[addr] !== to[addr]) changes.push(...diffRegisterFields(addr, from[addr], to[addr]));
+    }
+    return calibrationFor(changes, to);
+  }));
+}
+
+function paKey(image: Uint8Array): string {
+  return Array.from(image.subarray(REGISTER_COUNT)).join(',');
+}
+
+function scoreTransitions(costs: number[]): Score {
+  if (costs.length === 0) return { worst: 0, average: 0 };
+  const total = costs.reduce((sum, c) => sum + c, 0);
+  return { worst: Math.max(...costs), average: total / costs.length };
+}
+
+function isBetter(a: Score, b: Score, objective: SwitchObjective): boolean {
+  if (objective === 'worst') {
+    return a.worst < b.worst || (a.worst === b.worst && a.average < b.average);
+  }
+  return a.average < b.average || (a.average === b.average && a.worst < b.worst);
+}
+
+function mostCommon<T>(values: T[]): T {
+  const counts = new Map<T, number>();
+  let best = values[0];
+  for (const v of values) {
+    const n = (counts.get(v) ?? 0) + 1;
+    counts.set(v, n);
+    if (n > (counts.get(best) ?? 0)) best = v;
+  }
+  return best;
+}
+
+/**
+ * Score a candidate base against all ordered mode pairs
+ */
+function scoreBase(
+  images: Uint8Array[],
+  base: Uint8Array,
+  basePa: string,
+  calibration: CalibrationMode[][],
+  overhead: number
+): Score {
+  const masks = images.map(img => {
+    const mask: boolean[] = [];
+    for (let addr = 0; addr < REGISTER_COUNT; addr++) mask.push(img[addr] !== base[addr]);
+    return mask;
+  });
+  const paDiffers = images.map(img => paKey(img) !== basePa);
+
+  const costs: number[] = [];
+  for (let j = 0; j < images.length; j++) {
+    for (let k = 0; k < images.length; k++) {
+      if (j === k) continue;
+      const addresses: number[] = [];
+      for (let addr = 0; addr < REGISTER_COUNT; addr++) {
+        if (masks[j][addr] || masks[k][addr]) addresses.push(addr);
+      }
+      costs.push(transitionBytes(addresses, paDiffers[j] || paDiffers[k], calibration[j][k], overhead));
+    }
+  }
+  return scoreTransitions(costs);
+}
+
+/**
+ * Plan a shared base image and per-mode deltas for N modes
+ */
+export function planModeSwitching(
+  inputs: ModeInput[],
+  objective: SwitchObjective = 'worst',
+  overhead = TRANSACTION_OVERHEAD
+): SwitchPlan {
+  const images = inputs.map(m => packImage(m.registers, m.paTable));
+  const calibration = planCalibration(images);
+  const base = new Uint8Array(REGISTER_COUNT);
+  const paCandidates = Array.from(new Set(images.map(paKey)));
+  let basePa = images.length > 0 ? mostCommon(images.map(paKey)) : '';
+
+  // Start from the per-register majority value
+  for (let addr = 0; addr < REGISTER_COUNT; addr++) {
+    base[addr] = images.length > 0
+      ? mostCommon(images.map(img => img[addr]))
+      : REGISTER_LAYOUT[addr]?.default ?? 0;
+  }
+
+  // Coordinate descent over the values the modes actually use
+  let score = scoreBase(images, base, basePa, calibration, overhead);
+  for (let pass = 0; pass < 8; pass++) {
+    let improved = false;
+
+    for (let addr = 0; addr < REGISTER_COUNT; addr++) {
+      const candidates = new Set(images.map(img => img[addr]));
+      if (candidates.size < 2) continue;
+      const current = base[addr];
+      for (const value of candidates) {
+        if (value === current) continue;
+        base[addr] = value;
+        const candidate = scoreBase(images, base, basePa, calibration, overhead);
+        if (isBetter(candidate, score, objective)) {
+          score = candidate;
+          improved = true;
+        } else {
+          base[addr] = current;
+        }
+      }
+    }
+
+    for (const pa of paCandidates) {
+      if (pa === basePa) continue;
+      const candidate = scoreBase(images, base, pa, calibration, overhead);
+      if (isBetter(candidate, score, objective)) {
+        score = candidate;
+        basePa = pa;
+        improved = true;
+      }
+    }
+
+    if (!improved) break;
+  }
+
+  const basePaTable = basePa ? basePa.split(',').map(Number) : new Array(PA_TABLE_SIZE).fill(0);
+  const modes: ModeDelta[] = inputs.map((input, i) => {
+    const addresses: number[] = [];
+    for (let addr = 0; addr < REGISTER_COUNT; addr++) {
+      if (images[i][addr] !== base[addr]) addresses.push(addr);
+    }
+    const paDiffers = paKey(images[i]) !== basePa;
+    return {
+      name: input.name,
+      addresses,
+      paTable: paDiffers ? Array.from(images[i].subarray(REGISTER_COUNT)) : null
+    };
+  });
+
+  // Direct pairwise diffs: the lower bound a full N x N transition table would reach
+  const pairwise: number[] = [];
+  for (let j = 0; j < images.length; j++) {
+    for (let k = 0; k < images.length; k++) {
+      if (j === k) continue;
+      const addresses: number[] = [];
+      for (let addr = 0; addr < REGISTER_COUNT; addr++) {
+        if (images[j][addr] !== images[k][addr]) addresses.push(addr);
+      }
+      pairwise.push(transitionBytes(addresses, paKey(images[j]) !== paKey(images[k]), calibration[j][k], overhead));
+    }
+  }
+  const pairwiseScore = scoreTransitions(pairwise);
+
+  return {
+    objective,
+    baseRegisters: Array.from(base),
+    basePaTable,
+    modes,
+    images,
+    calibration,
+    worstBytes: score.worst,
+    averageBytes: score.average,
+    pairwiseWorstBytes: pairwiseScore.worst,
+    pairwiseAverageBytes: pairwiseScore.average,
+    fullBytes: FULL_REWRITE_BYTES
+  };
+}
+
+function cIdentifier(name: string): string {
+  return name.replace(/[^a-zA-Z0-9_]/g, '_');
+}
+
+function addressMask(addresses: number[]): string {
+  let hi = 0, lo = 0;
+  for (const addr of addresses) {
+    if (addr < 32) lo = (lo | (1 << addr)) >>> 0;
+    else hi = (hi | (1 << (addr - 32))) >>> 0;
+  }
+  return `0x${toHex(hi, 8)}${toHex(lo, 8)}ULL`;
+}
+
+/**
+ * Generate C tables for the plan
+ */
+export function generateSwitchPlanCArray(planName: string, plan: SwitchPlan): string {
+  const prefix = cIdentifier(planName);
+  let output = `// CC1101 Mode Switching Plan: ${planName}\n`;
+  output += `// Generated by CC1101 Register Editor\n`;
+  output += `// Program ${prefix}_base_* once at boot. To switch from mode j to mode k, write every\n`;
+  output += `// register in (${prefix}_delta_mask[j] | ${prefix}_delta_mask[k]): the value from mode k's\n`;
+  output += `// delta table if present, otherwise the base value. Write contiguous runs as bursts.\n`;
+  output += `// Rewrite the PA table when either mode has a ${prefix}_pa_* entry.\n`;
+  const strobes = plan.calibration.some(row => row.includes('strobe'));
+  if (strobes) {
+    output += `// Then strobe SCAL when ${prefix}_scal[j][k] is set: the switch changes the\n`;
+    output += `// synthesizer and mode k does not calibrate automatically (MCSM0.FS_AUTOCAL).\n`;
+  }
+  output += '\n';
+
+  output += `static const uint8_t ${prefix}_base_registers[] = {\n`;
+  plan.baseRegisters.forEach((value, addr) => {
+    output += `    0x${toHex(value)},  // 0x${toHex(addr)} ${REGISTER_LAYOUT[addr]?.name ?? ''}\n`;
+  });
+  output += `};\n\n`;
+  output += `static const uint8_t ${prefix}_base_pa_table[] = {\n    `;
+  output += plan.basePaTable.map(b => `0x${toHex(b)}`).join(', ');
+  output += `\n};\n\n`;
+
+  output += `static const uint64_t ${prefix}_delta_mask[] = {\n`;
+  plan.modes.forEach((mode, i) => {
+    output += `    ${addressMask(mode.addresses)},  // ${i}: ${mode.name}\n`;
+  });
+  output += `};\n`;
+
+  if (strobes) {
+    output += `\nstatic const uint8_t ${prefix}_scal[${plan.modes.length}][${plan.modes.length}] = {\n`;
+    plan.calibration.forEach((row, j) => {
+      output += `    { ${row.map(mode => (mode === 'strobe' ? 1 : 0)).join(', ')} },  // from ${j}: ${plan.modes[j].name}\n`;
+    });
+    output += `};\n`;
+  }
+
+  plan.modes.forEach((mode, i) => {
+    const modeName = `${prefix}_${i}_${cIdentifier(mode.name)}`;
+    output += `\n// ${mode.name}: ${mode.addresses.length} registers differ from base\n`;
+    output += `static const uint8_t ${modeName}_delta[] = {\n`;
+    for (const addr of mode.addresses) {
+      const value = plan.images[i][addr];
+      output += `    0x${toHex(addr)}, 0x${toHex(value)},  // ${REGISTER_LAYOUT[addr]?.name ?? ''}\n`;
+    }
+    output += `};\n`;
+    if (mode.paTable) {
+      output += `static const uint8_t ${prefix}_pa_${i}[] = {\n    `;
+      output += mode.paTable.map(b => `0x${toHex(b)}`).join(', ');
+      output += `\n};\n`;
+    }
+  });
+
+  return output;
+}
+
+/**
+ * Generate a text report comparing the plan with full rewrites
+ */
+export function generateSwitchPlanReport(plan: SwitchPlan): string {
+  const pct = (bytes: number) => `${Math.round((1 - bytes / plan.fullBytes) * 100)}%`;
+  const lines: string[] = [];
+  lines.push(`Modes: ${plan.modes.length} (objective: ${plan.objective}-case)`);
+  lines.push('');
+  lines.push('Mode                              Delta regs  PA');
+  for (const mode of plan.modes) {
+    lines.push(`${mode.name.padEnd(34)}${String(mode.addresses.length).padStart(10)}  ${mode.paTable ? 'yes' : 'no'}`);
+  }
+  lines.push('');
+  lines.push('SPI bytes per switch      Worst   Average  Saved');
+  lines.push(`Full rewrite         ${String(plan.fullBytes).padStart(10)}${plan.fullBytes.toFixed(1).padStart(10)}     -`);
+  lines.push(`Shared base          ${String(plan.worstBytes).padStart(10)}${plan.averageBytes.toFixed(1).padStart(10)}  ${pct(plan.averageBytes).padStart(4)}`);
+  lines.push(`Pairwise (N x N)     ${String(plan.pairwiseWorstBytes).padStart(10)}${plan.pairwiseAverageBytes.toFixed(1).padStart(10)}  ${pct(plan.pairwiseAverageBytes).padStart(4)}`);
+  return lines.join('\n');
+}
@@ -0,0 +1,81 @@
+/**
+ * Register Image Validation
+ * RF parameter rules from validateRfParameters plus register sanity checks
+ */
+
+import { MODULATION_FORMATS } from '../data/registers';
+import { validateRfParameters } from './calculations';
+import { deriveImage } from './derive';
+import { REGISTER_COUNT } from './image';
+
+export type IssueSeverity = 'error' | 'warning' | 'info';
+
+export interface ImageIssue {
+  severity: IssueSeverity;
+  code: string;
+  message: string;
+}
+
+// Supported carrier ranges in MHz (datasheet section 1)
+export const FREQUENCY_BANDS: [number, number][] = [[300, 348], [387, 464], [779, 928]];
+
+// Data rate limits in kBaud per MOD_FORMAT (datasheet table 3)
+const DATA_RATE_LIMITS: Record<number, [number, number]> = {
+  0: [0.6, 500],
+  1: [0.6, 250],
+  3: [0.6, 250],
+  4: [0.6, 300],
+  7: [26, 500]
+};
+
+/**
+ * Check one packed image
+ */
+export function validateImage(image: Uint8Array, offset = 0): ImageIssue[] {
+  const issues: ImageIssue[] = [];
+  const derived = deriveImage(image, offset);
+  const mdmcfg2 = image[offset + 0x12];
+
+  if (!MODULATION_FORMATS[derived.modulation]) {
+    issues.push({ severity: 'error', code: 'mod-format', message: `MOD_FORMAT ${derived.modulation} is reserved` });
+  }
+
+  if ((image[offset + 0x0D] & 0xC0) !== 0) {
+    issues.push({ severity: 'error', code: 'freq-reserved', message: 'FREQ2[7:6] must be 00' });
+  }
+  if (!FREQUENCY_BANDS.some(([lo, hi]) => derived.frequency >= lo && derived.frequency <= hi)) {
+    issues.push({
+      severity: 'error',
+      code: 'freq-band',
+      message: `${derived.frequency.toFixed(3)} MHz is outside the 300-348, 387-464 and 779-928 MHz bands`
+    });
+  }
+
+  const limits = DATA_RATE_LIMITS[derived.modulation];
+  if (limits && (derived.dataRate < limits[0] || derived.dataRate > limits[1])) {
+    issues.push({
+      severity: 'error',
+      code: 'data-rate',
+      message: `${derived.dataRate.toFixed(2)} kBaud is outside ${limits[0]}-${limits[1]} kBaud for ${MODULATION_FORMATS[derived.modulation].name}`
+    });
+  }
+
+  // MANCHESTER_EN is not supported with 4-FSK or MSK
+  if ((mdmcfg2 & 0x08) !== 0 && (derived.modulation === 4 || derived.modulation === 7)) {
+    issues.push({ severity: 'error', code: 'manchester', message: 'Manchester encoding is not supported with 4-FSK or MSK' });
+  }
+
+  // ASK/OOK transmits PATABLE[FREND0.PA_POWER] for a '1'
+  if (derived.modulation === 3) {
+    const paPower = image[offset + 0x22] & 0x07;
+    if (image[offset + REGISTER_COUNT + paPower] === 0) {
+      issues.push({ severity: 'warning', code: 'pa-table', message: `PATABLE[${paPower}] is 0x00, OOK '1' symbols are not transmitted` });
+    }
+  }
+
+  for (const warning of validateRfParameters(derived.bandwidth, derived.deviation, derived.dataRate, derived.modulation).warnings) {
+    issues.push({ severity: warning.type, code: `rf-${warning.field}`, message: warning.message });
+  }
+
+  return issues;
+}
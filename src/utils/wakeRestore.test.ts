@@ -0,0 +1,69 @@
+import { describe, it, expect } from 'vitest';
+import { PRESETS } from '../data/registers';
+import {
+  getSleepLostRegisters,
+  planWakeRestore,
+  generateWakeRestoreCArray,
+} from '../utils/wakeRestore';
+import { generateExport } from '../utils/export';
+
+describe('Wakeup Restore Sequence', () => {
+  const fsk = PRESETS['FM 2-FSK (433.92MHz)'];
+  const ook = PRESETS['AM 650kHz (433.92MHz)'];
+
+  it('lists the test registers as lost in SLEEP', () => {
+    expect(getSleepLostRegisters()).toEqual([0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E]);
+  });
+
+  it('restores the lost registers in one burst', () => {
+    const plan = planWakeRestore(fsk.registers, fsk.paTable);
+
+    expect(plan.ops).toEqual([
+      { op: 'write', addr: 0x29, values: [0x59, 0x7F, 0x3F, 0x88, 0x31, 0x0B] },
+    ]);
+    expect(plan.spiBytes).toBe(7);
+  });
+
+  it('skips the PA table when only PATABLE[0] is used', () => {
+    const plan = planWakeRestore(fsk.registers, fsk.paTable);
+
+    expect(plan.ops.some(op => op.op === 'patable')).toBe(false);
+  });
+
+  it('restores PA entries up to FREND0.PA_POWER', () => {
+    const registers = { ...ook.registers, 0x22: 0x11 }; // PA_POWER = 1
+    const plan = planWakeRestore(registers, ook.paTable);
+
+    expect(plan.ops).toContainEqual({ op: 'patable', values: [0x00, 0xC0] });
+  });
+
+  it('includes cached FSCAL values when requested', () => {
+    const plan = planWakeRestore(fsk.registers, fsk.paTable, { restoreFscal: true });
+
+    expect(plan.ops).toContainEqual({ op: 'write', addr: 0x23, values: [0xA9, 0x0A, 0x20] });
+  });
+
+  it('reports bytes and time saved per wake cycle', () => {
+    const plan = planWakeRestore(fsk.registers, fsk.paTable);
+
+    expect(plan.savedBytes).toBe(plan.fullBytes - plan.spiBytes);
+    expect(plan.savedUs).toBeGreaterThan(0);
+  });
+
+  it('counts the avoided SCAL when auto calibration is off', () => {
+    const registers = { ...fsk.registers, 0x18: 0x08 };
+    const withAuto = planWakeRestore(fsk.registers, fsk.paTable);
+    const manual = planWakeRestore(registers, fsk.paTable);
+
+    expect(manual.calibrationSkipped).toBe(true);
+    expect(manual.savedUs - withAuto.savedUs).toBeGreaterThan(700);
+  });
+
+  it('emits a C table through generateExport', () => {
+    const result = generateExport('wake_restore', 'Sleepy', fsk.registers, fsk.paTable);
+
+    expect(result).toBe(generateWakeRestoreCArray('Sleepy', fsk.registers, fsk.paTable));
+    expect(result).toContain('static const uint8_t Sleepy_wake_restore[]');
+    expect(result).toContain('0x07, 0x69, 0x59, 0x7F, 0x3F, 0x88, 0x31, 0x0B,  // FSTEST..TEST0');
+  });
+});
@@ -0,0 +1,137 @@
+/**
+ * Wakeup Restore Sequence
+ * Rewrites only what SLEEP state loses: registers without sleep retention
+ * and the PATABLE entries past index 0.
+ */
+
+import { REGISTER_LAYOUT } from '../data/registerLayout';
+import { toHex } from './calculations';
+import { generateOpsTable, opsByteCost } from './diff';
+import type { ReconfigOp } from './diff';
+import { packImage, REGISTER_COUNT, PA_TABLE_SIZE } from './image';
+import {
+  CALIBRATION_US,
+  SPI_CLOCK_HZ,
+  TRANSACTION_OVERHEAD,
+  coalesceAddresses,
+  spiTimeUs
+} from './spi';
+
+// FSCAL3, FSCAL2, FSCAL1 hold the synthesizer calibration result
+export const FSCAL_CACHE_ADDRESSES = [0x23, 0x24, 0x25];
+
+export interface WakeRestoreOptions {
+  restoreFscal?: boolean; // Also write the image's FSCAL3-1 as a cached calibration
+  spiClockHz?: number;
+  overhead?: number;
+}
+
+export interface WakeRestorePlan {
+  ops: ReconfigOp[];
+  lostRegisters: number[];
+  spiBytes: number;
+  timeUs: number;
+  fullBytes: number;
+  fullTimeUs: number;
+  calibrationSkipped: boolean;
+  savedBytes: number;
+  savedUs: number;
+}
+
+/**
+ * Register addresses whose contents are lost in SLEEP
+ */
+export function getSleepLostRegisters(): number[] {
+  const lost: number[] = [];
+  for (let addr = 0; addr < REGISTER_COUNT; addr++) {
+    if (REGISTER_LAYOUT[addr]?.sleepRetained === false) lost.push(addr);
+  }
+  return lost;
+}
+
+/**
+ * Plan the minimal restore sequence for a register image
+ */
+export function planWakeRestore(
+  registers: Record<number, number>,
+  paTable: number[],
+  options: WakeRestoreOptions = {}
+): WakeRestorePlan {
+  const clockHz = options.spiClockHz ?? SPI_CLOCK_HZ;
+  const overhead = options.overhead ?? TRANSACTION_OVERHEAD;
+  const image = packImage(registers, paTable);
+
+  const lostRegisters = getSleepLostRegisters();
+  const addresses = options.restoreFscal
+    ? [...FSCAL_CACHE_ADDRESSES, ...lostRegisters]
+    : lostRegisters;
+
+  const ops: ReconfigOp[] = coalesceAddresses(addresses, overhead).map((range): ReconfigOp => ({
+    op: 'write',
+    addr: range.start,
+    values: Array.from(image.subarray(range.start, range.start + range.length))
+  }));
+
+  // PATABLE[0] survives SLEEP; entries up to FREND0.PA_POWER are in use
+  const paPower = image[0x22] & 0x07;
+  if (paPower > 0) {
+    ops.push({
+      op: 'patable',
+      values: Array.from(image.subarray(REGISTER_COUNT, REGISTER_COUNT + paPower + 1))
+    });
+  }
+
+  // Naive wakeup: burst 0x00-0x2E, full PATABLE, SCAL
+  // FS_AUTOCAL = 0 needs the explicit SCAL; FSCAL3-1 are retained so the minimal sequence does not
+  const fsAutocal = (image[0x18] >> 4) & 0x03;
+  const calibrationSkipped = fsAutocal === 0;
+  const fullBytes = (1 + REGISTER_COUNT) + (1 + PA_TABLE_SIZE) + (calibrationSkipped ? 1 : 0);
+  const fullTransactions = calibrationSkipped ? 3 : 2;
+  const fullTimeUs = spiTimeUs(fullBytes, fullTransactions, clockHz, overhead)
+    + (calibrationSkipped ? CALIBRATION_US : 0);
+
+  const spiBytes = opsByteCost(ops);
+  const timeUs = spiTimeUs(spiBytes, ops.length, clockHz, overhead);
+
+  return {
+    ops,
+    lostRegisters,
+    spiBytes,
+    timeUs,
+    fullBytes,
+    fullTimeUs,
+    calibrationSkipped,
+    savedBytes: fullBytes - spiBytes,
+    savedUs: fullTimeUs - timeUs
+  };
+}
+
+/**
+ * Generate C wakeup restore table
+ */
+export function generateWakeRestoreCArray(
+  presetName: string,
+  registers: Record<number, number>,
+  paTable: number[],
+  options: WakeRestoreOptions = {}
+): string {
+  const safeName = presetName.replace(/[^a-zA-Z0-9_]/g, '_');
+  const plan = planWakeRestore(registers, paTable, options);
+  const lostNames = plan.lostRegisters.map(addr => REGISTER_LAYOUT[addr].name).join(', ');
+
+  let output = `// CC1101 Wakeup Restore Sequence: ${presetName}\n`;
+  output += `// Generated by CC1101 Register Editor\n`;
+  output += `// Lost in SLEEP: ${lostNames}, PATABLE[1..7]\n`;
+  output += `// ${plan.spiBytes} SPI bytes, ~${plan.timeUs.toFixed(0)} us per wakeup`;
+  output += ` (full rewrite: ${plan.fullBytes} bytes, ~${plan.fullTimeUs.toFixed(0)} us)\n`;
+  output += `// Saved per wake cycle: ${plan.savedBytes} bytes, ~${plan.savedUs.toFixed(0)} us\n`;
+  if (plan.calibrationSkipped) {
+    output += `// FS_AUTOCAL = 0: FSCAL3-1 (0x${toHex(registers[0x23] ?? REGISTER_LAYOUT[0x23].default)}`;
+    output += ` 0x${toHex(registers[0x24] ?? REGISTER_LAYOUT[0x24].default)}`;
+    output += ` 0x${toHex(registers[0x25] ?? REGISTER_LAYOUT[0x25].default)}) reused, no SCAL needed\n`;
+  }
+  output += `// Each entry is a length byte followed by one SPI transaction; a zero length ends the list.\n\n`;
+  output += generateOpsTable(`${safeName}_wake_restore`, plan.ops);
+
+  return output;
+}
@@ -0,0 +1,60 @@
+/**
+ * Library Statistics Worker
+ * Streams library files and posts statistics snapshots while they are parsed
+ */
+
+import { createLibraryStats } from '../utils/analytics';
+import type { LibraryStatsMessage } from '../utils/analytics';
+import { createLibraryReader, readLibraryBank } from '../utils/libraryReader';
+import { readTextChunks } from '../utils/lines';
+
+const SNAPSHOT_INTERVAL_MS = 150;
+
+function post(message: LibraryStatsMessage) {
+  self.postMessage(message);
+}
+
+async function analyze(files: File[]) {
+  const start = performance.now();
+  const stats = createLibraryStats();
+  const total = files.reduce((sum, file) => sum + file.size, 0);
+  let finishedBytes = 0;
+  let finished = 0;
+  let lastSnapshot = -Infinity; // First chunk reports immediately
+
+  // Throttled so a large library doesn't flood the main thread with renders
+  const snapshot = (loaded: number) => {
+    const now = performance.now();
+    if (now - lastSnapshot < SNAPSHOT_INTERVAL_MS) return;
+    lastSnapshot = now;
+    post({ type: 'stats', stats: stats.snapshot(), files: finished, loaded, total });
+  };
+
+  for (const file of files) {
+    try {
+      if (file.name.toLowerCase().endsWith('.bin')) {
+        readLibraryBank(await file.arrayBuffer(), stats.add);
+      } else {
+        const reader = createLibraryReader(file.name, stats.add);
+        await readTextChunks(file, (text, loaded) => {
+          reader.push(text);
+          snapshot(finishedBytes + loaded);
+        });
+        reader.end();
+      }
+    } catch (err) {
+      post({ type: 'fileError', fileName: file.name, message: (err as Error).message });
+    }
+    finishedBytes += file.size;
+    finished++;
+    snapshot(finishedBytes);
+  }
+
+  post({ type: 'done', stats: stats.snapshot(), files: finished, elapsedMs: performance.now() - start });
+}
+
+self.onmessage = (event: MessageEvent<{ files: File[] }>) => {
+  analyze(event.data.files).catch(err => {
+    post({ type: 'error', message: (err as Error).message });
+  });
+};
@@ -0,0 +1,40 @@
+/**
+ * .sub Import Worker
+ * Streams the file and parses it off the main thread
+ */
+
+import { readTextChunks } from '../utils/lines';
+import { createSubFileParser } from '../utils/subFile';
+import type { SubImportMessage } from '../utils/subFile';
+
+const PROGRESS_INTERVAL_BYTES = 256 * 1024;
+
+function post(message: SubImportMessage, transfer: Transferable[] = []) {
+  self.postMessage(message, { transfer });
+}
+
+async function importFile(file: File) {
+  const parser = createSubFileParser(preset => post({ type: 'preset', preset }));
+  let reported = 0;
+
+  await readTextChunks(file, (text, loaded) => {
+    parser.push(text);
+    if (loaded - reported >= PROGRESS_INTERVAL_BYTES) {
+      reported = loaded;
+      post({ type: 'progress', loaded, total: file.size, pulses: parser.pulseCount() });
+    }
+  });
+
+  const result = parser.end();
+  post({ type: 'progress', loaded: file.size, total: file.size, pulses: result.pulses.length });
+  post(
+    { type: 'done', pulses: result.pulses, protocol: result.protocol, presetError: result.presetError },
+    [result.pulses.buffer]
+  );
+}
+
+self.onmessage = (event: MessageEvent<{ file: File }>) => {
+  importFile(event.data.file).catch(err => {
+    post({ type: 'error', message: (err as Error).message });
+  });
+};
@@ -0,0 +1,21 @@
+import { defineConfig } from 'vite'
+
+// cc1101 CLI: a single bundled ESM file so startup is one module load
+export default defineConfig({
+  build: {
+    ssr: 'src/cli/cc1101.ts',
+    outDir: 'dist-cli',
+    emptyOutDir: true,
+    target: 'node18',
+    minify: true,
+    rollupOptions: {
+      output: {
+        entryFileNames: 'cc1101.mjs',
+        banner: '#!/usr/bin/env node',
+      },
+    },
+  },
+  ssr: {
+    noExternal: true,
+  },
+})
@@ -0,0 +1,22 @@
+import { defineConfig } from 'vite'
+
+// Headless core library: ESM + CJS, one output file per source module
+export default defineConfig({
+  build: {
+    outDir: 'dist-lib',
+    emptyOutDir: true,
+    sourcemap: true,
+    minify: false,
+    lib: {
+      entry: 'src/lib/index.ts',
+      formats: ['es', 'cjs'],
+      fileName: (format, entryName) => `${entryName}.${format === 'es' ? 'js' : 'cjs'}`,
+    },
+    rollupOptions: {
+      output: {
+        preserveModules: true,
+        preserveModulesRoot: 'src',
+      },
+    },
+  },
+})